@@ -0,0 +1,214 @@
+#include "AssetBundle.hpp"
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+#include "Log.hpp"
+
+namespace {
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t alignment;
+    uint64_t indexOffset;
+    uint64_t indexSize;
+};
+
+struct IndexEntry {
+    uint64_t offset;
+    uint64_t size;
+    uint64_t hash;
+    uint32_t nameOffset; // Into the name table that follows the entries
+    uint32_t nameLength;
+};
+
+static_assert(sizeof(Header) == 32 && sizeof(IndexEntry) == 32, "Bundle records must not be padded");
+
+const char MAGIC[4] = {'N', 'C', 'A', 'B'};
+
+} // namespace
+
+AssetBundle::~AssetBundle() {
+    close();
+}
+
+bool AssetBundle::open(const std::string& path) {
+    close();
+    if (!file.open(path)) return false;
+    data = file.getData();
+    mappedSize = file.getSize();
+
+    Header header;
+    bool valid = mappedSize >= sizeof(header);
+    if (valid) {
+        std::memcpy(&header, data, sizeof(header));
+        valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION &&
+                header.indexOffset <= mappedSize && header.indexSize <= mappedSize - header.indexOffset &&
+                (uint64_t)header.entryCount * sizeof(IndexEntry) <= header.indexSize;
+    }
+    if (!valid) {
+        LogWarning("Not a valid asset bundle: %s", path.c_str());
+        close();
+        return false;
+    }
+
+    const unsigned char* entries = data + header.indexOffset;
+    const char* names = (const char*)entries + header.entryCount * sizeof(IndexEntry);
+    uint64_t namesSize = header.indexSize - header.entryCount * sizeof(IndexEntry);
+    index.reserve(header.entryCount);
+    for (uint32_t i = 0; i < header.entryCount; ++i) {
+        IndexEntry entry;
+        std::memcpy(&entry, entries + i * sizeof(IndexEntry), sizeof(entry));
+        if ((uint64_t)entry.nameOffset + entry.nameLength > namesSize ||
+            entry.offset > mappedSize || entry.size > mappedSize - entry.offset) {
+            LogWarning("Skipping corrupt entry %u in asset bundle: %s", i, path.c_str());
+            continue;
+        }
+        index[std::string(names + entry.nameOffset, entry.nameLength)] = {entry.offset, entry.size, entry.hash};
+    }
+    LogInfo("Mapped asset bundle %s: %zu assets, %zu bytes", path.c_str(), index.size(), mappedSize);
+    return true;
+}
+
+void AssetBundle::close() {
+    file.close();
+    data = nullptr;
+    mappedSize = 0;
+    index.clear();
+}
+
+const unsigned char* AssetBundle::find(const std::string& name, size_t& size) const {
+    auto it = index.find(name);
+    if (it == index.end()) {
+        size = 0;
+        return nullptr;
+    }
+    size = (size_t)it->second.size;
+    return data + it->second.offset;
+}
+
+std::vector<std::string> AssetBundle::getNames() const {
+    std::vector<std::string> names;
+    names.reserve(index.size());
+    for (const auto& [name, slice] : index) names.push_back(name);
+    return names;
+}
+
+bool AssetBundle::verify() const {
+    bool ok = true;
+    for (const auto& [name, slice] : index) {
+        if (hash(data + slice.offset, (size_t)slice.size) != slice.hash) {
+            LogWarning("Asset bundle entry is corrupt: %s", name.c_str());
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+uint64_t AssetBundle::hash(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    uint64_t h = seed;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= bytes[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+AssetBundleWriter::AssetBundleWriter(const std::string& path)
+    : path(path), tempPath(path + ".tmp"), file(tempPath, std::ios::binary | std::ios::trunc) {
+    Header header = {};
+    file.write((const char*)&header, sizeof(header)); // Rewritten by finish()
+    offset = sizeof(header);
+    failed = !file;
+    if (failed) LogWarning("Failed to create asset bundle: %s", tempPath.c_str());
+}
+
+AssetBundleWriter::~AssetBundleWriter() {
+    if (file.is_open()) {
+        // Abandoned without finish(); don't leave a half-written bundle behind
+        file.close();
+        std::remove(tempPath.c_str());
+    }
+}
+
+bool AssetBundleWriter::addData(const std::string& name, const void* data, size_t size) {
+    if (failed) return false;
+    for (const auto& entry : entries) {
+        if (entry.name == name) {
+            LogWarning("Duplicate asset bundle entry skipped: %s", name.c_str());
+            return false;
+        }
+    }
+
+    static const char zeros[AssetBundle::ALIGNMENT] = {};
+    uint64_t padding = (AssetBundle::ALIGNMENT - offset % AssetBundle::ALIGNMENT) % AssetBundle::ALIGNMENT;
+    file.write(zeros, padding);
+    offset += padding;
+    file.write((const char*)data, size);
+    if (!file) {
+        failed = true;
+        LogWarning("Failed to write asset bundle entry: %s", name.c_str());
+        return false;
+    }
+    entries.push_back({name, offset, size, AssetBundle::hash(data, size)});
+    offset += size;
+    return true;
+}
+
+bool AssetBundleWriter::addFile(const std::string& name, const std::string& filePath) {
+    std::ifstream in(filePath, std::ios::binary);
+    if (!in.is_open()) {
+        LogWarning("Failed to read file for asset bundle: %s", filePath.c_str());
+        return false;
+    }
+    std::vector<char> contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    return addData(name, contents.data(), contents.size());
+}
+
+bool AssetBundleWriter::finish() {
+    if (!file.is_open()) return false;
+    if (failed) {
+        file.close();
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    std::string names;
+    std::vector<IndexEntry> index;
+    for (const auto& entry : entries) {
+        index.push_back({entry.offset, entry.size, entry.hash, (uint32_t)names.size(), (uint32_t)entry.name.size()});
+        names += entry.name;
+    }
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = AssetBundle::VERSION;
+    header.entryCount = (uint32_t)entries.size();
+    header.alignment = AssetBundle::ALIGNMENT;
+    header.indexOffset = offset;
+    header.indexSize = index.size() * sizeof(IndexEntry) + names.size();
+
+    file.write((const char*)index.data(), index.size() * sizeof(IndexEntry));
+    file.write(names.data(), names.size());
+    file.seekp(0);
+    file.write((const char*)&header, sizeof(header));
+    file.close();
+    if (file.fail()) {
+        std::remove(tempPath.c_str());
+        LogWarning("Failed to finish asset bundle: %s", tempPath.c_str());
+        return false;
+    }
+
+    // Replace any previous bundle only once the new one is complete
+    std::remove(path.c_str());
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        LogWarning("Failed to move asset bundle into place: %s", path.c_str());
+        return false;
+    }
+    LogInfo("Wrote asset bundle %s: %zu assets, %llu bytes", path.c_str(), entries.size(),
+             (unsigned long long)(offset + header.indexSize));
+    return true;
+}
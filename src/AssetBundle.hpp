@@ -0,0 +1,94 @@
+#ifndef ASSET_BUNDLE_HPP
+#define ASSET_BUNDLE_HPP
+
+#include "MappedFile.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Single-file container for an exported project (project.json, fonts, images)
+// so the renderer starts with one open + mmap instead of a file per asset.
+//
+// Layout, all integers little-endian:
+//   Header   magic "NCAB", version, entry count, payload alignment,
+//            index offset, index size
+//   Payloads each starts on an `alignment` boundary
+//   Index    one Entry per asset, followed by the concatenated names
+class AssetBundle
+{
+public:
+    static constexpr const char* DEFAULT_NAME = "assets.bundle";
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t ALIGNMENT = 64;
+
+    AssetBundle() = default;
+    ~AssetBundle();
+    AssetBundle(const AssetBundle&) = delete;
+    AssetBundle& operator=(const AssetBundle&) = delete;
+
+    // Maps the bundle read-only and reads its index; false if missing or malformed
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    // Slice of the mapping holding the named asset, or nullptr. Valid until close().
+    const unsigned char* find(const std::string& name, size_t& size) const;
+    bool contains(const std::string& name) const { return index.count(name) > 0; }
+    std::vector<std::string> getNames() const;
+
+    // Recomputes every payload hash; reading the whole file defeats the point
+    // of mapping it, so this is for tooling rather than startup
+    bool verify() const;
+
+    // 64-bit FNV-1a, stored per entry. Pass the previous result as seed to
+    // hash data that arrives in chunks.
+    static constexpr uint64_t HASH_SEED = 14695981039346656037ull;
+    static uint64_t hash(const void* data, size_t size, uint64_t seed = HASH_SEED);
+
+private:
+    struct Slice
+    {
+        uint64_t offset;
+        uint64_t size;
+        uint64_t hash;
+    };
+
+    MappedFile file;
+    const unsigned char* data = nullptr;
+    size_t mappedSize = 0;
+    std::unordered_map<std::string, Slice> index;
+};
+
+// Writes an AssetBundle. Payloads are streamed to "<path>.tmp" as they are
+// added; finish() appends the index and renames the file into place.
+class AssetBundleWriter
+{
+public:
+    explicit AssetBundleWriter(const std::string& path);
+    ~AssetBundleWriter();
+
+    bool addData(const std::string& name, const void* data, size_t size);
+    bool addFile(const std::string& name, const std::string& filePath);
+    bool finish();
+
+private:
+    struct Entry
+    {
+        std::string name;
+        uint64_t offset;
+        uint64_t size;
+        uint64_t hash;
+    };
+
+    std::string path;
+    std::string tempPath;
+    std::ofstream file;
+    std::vector<Entry> entries;
+    uint64_t offset = 0;
+    bool failed = false;
+};
+
+#endif // ASSET_BUNDLE_HPP
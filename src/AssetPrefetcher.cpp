@@ -0,0 +1,110 @@
+#include "AssetPrefetcher.hpp"
+#include "GraphicsBackend.hpp"
+#include "Log.hpp"
+#include <deque>
+
+AssetPrefetcher::AssetPrefetcher(ElementMap& elements, SceneMap& scenes, NodeMap& nodes)
+    : elements(elements), scenes(scenes), nodes(nodes), depth(2), lastNodeIndex(-2) {}
+
+void AssetPrefetcher::update(int currentNodeIndex) {
+    if (currentNodeIndex == lastNodeIndex) return;
+    lastNodeIndex = currentNodeIndex;
+
+    // Breadth-first walk over choices, up to `depth` hops from the current node
+    std::set<AssetKey> wanted;
+    if (currentNodeIndex >= 0 && nodes.isAlive(currentNodeIndex)) {
+        std::vector<int> distance(nodes.size(), -1);
+        std::deque<size_t> queue;
+        distance[currentNodeIndex] = 0;
+        queue.push_back(currentNodeIndex);
+        while (!queue.empty()) {
+            size_t nodeIndex = queue.front();
+            queue.pop_front();
+            const Node& node = nodes[nodeIndex];
+            if (const Scene* scene = findScene(scenes, node)) {
+                collectSceneAssets(*scene, wanted);
+            }
+            if (distance[nodeIndex] >= depth) continue;
+            for (const auto& conn : node.connections) {
+                if (isLinked(nodes, conn) && distance[conn.toNodeIndex] < 0) {
+                    distance[conn.toNodeIndex] = distance[nodeIndex] + 1;
+                    queue.push_back(conn.toNodeIndex);
+                }
+            }
+        }
+    }
+
+    // Acquire before releasing so a file shared by an outgoing and an incoming
+    // asset stays cached instead of being dropped and decoded again
+    size_t acquired = 0;
+    for (const auto& key : wanted) {
+        // Resident keys whose handle was dropped (the editor changed the file) count as missing
+        if (resident.count(key) == 0 || isMissing(key)) {
+            acquire(key);
+            ++acquired;
+        }
+    }
+    size_t released = 0;
+    for (const auto& key : resident) {
+        if (wanted.count(key) == 0) {
+            release(key);
+            ++released;
+        }
+    }
+    resident = std::move(wanted);
+    LogInfo("Prefetch for node %d (depth %d): %zu resident, %zu acquired, %zu released",
+             currentNodeIndex, depth, resident.size(), acquired, released);
+}
+
+void AssetPrefetcher::collectSceneAssets(const Scene& scene, std::set<AssetKey>& out) const {
+    for (const auto& sceneElement : scene.elements) {
+        const Element* element = findElement(elements, sceneElement);
+        if (element == nullptr) continue;
+        if (element->type == ElementType::BACKGROUND) {
+            out.insert({sceneElement.elementIndex, 0});
+        } else if (element->type == ElementType::CHARACTER) {
+            // Only the pose the scene shows, not the whole pose set
+            int pose = findPose(std::get<CharacterElement>(element->data), sceneElement);
+            if (pose >= 0) out.insert({sceneElement.elementIndex, (size_t)pose});
+        }
+    }
+}
+
+void AssetPrefetcher::acquire(const AssetKey& key) {
+    GraphicsBackend* backend = GraphicsBackend::get();
+    if (backend == nullptr || !elements.isAlive(key.first)) return;
+    Element& element = elements[key.first];
+    if (element.type == ElementType::BACKGROUND) {
+        auto& background = std::get<BackgroundElement>(element.data);
+        background.texture = backend->acquireTexture(background.imagePath);
+    } else if (element.type == ElementType::CHARACTER) {
+        auto& character = std::get<CharacterElement>(element.data);
+        if (key.second >= character.images.size()) return;
+        character.textures.resize(character.images.size());
+        character.textures[key.second] = backend->acquireTexture(character.images[key.second].second);
+    }
+}
+
+bool AssetPrefetcher::isMissing(const AssetKey& key) const {
+    if (!elements.isAlive(key.first)) return false;
+    const Element& element = elements[key.first];
+    if (element.type == ElementType::BACKGROUND) {
+        return std::get<BackgroundElement>(element.data).texture.isEmpty();
+    }
+    if (element.type != ElementType::CHARACTER) return false;
+    const auto& character = std::get<CharacterElement>(element.data);
+    return key.second >= character.textures.size() || character.textures[key.second].isEmpty();
+}
+
+void AssetPrefetcher::release(const AssetKey& key) {
+    if (!elements.isAlive(key.first)) return;
+    Element& element = elements[key.first];
+    if (element.type == ElementType::BACKGROUND) {
+        std::get<BackgroundElement>(element.data).texture = TextureHandle();
+    } else if (element.type == ElementType::CHARACTER) {
+        auto& character = std::get<CharacterElement>(element.data);
+        if (key.second < character.textures.size()) {
+            character.textures[key.second] = TextureHandle();
+        }
+    }
+}
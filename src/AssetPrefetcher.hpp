@@ -0,0 +1,45 @@
+#ifndef ASSET_PREFETCHER_HPP
+#define ASSET_PREFETCHER_HPP
+
+#include "Types.hpp"
+
+#include <set>
+#include <utility>
+#include <vector>
+
+// Keeps textures resident only for scenes reachable from the current node
+// within a fixed number of choices. Walking Node::connections breadth-first,
+// it acquires the poses/backgrounds those scenes use (decoding happens in the
+// background, see TextureCache) and releases everything that fell out of
+// range, so memory follows the branching factor rather than the story size.
+class AssetPrefetcher
+{
+public:
+    AssetPrefetcher(ElementMap& elements, SceneMap& scenes, NodeMap& nodes);
+
+    void setDepth(int depth) { this->depth = depth; invalidate(); }
+    int getDepth() const { return depth; }
+
+    // Recomputes the resident set when the current node changed (or after invalidate())
+    void update(int currentNodeIndex);
+    void invalidate() { lastNodeIndex = -2; }
+    size_t getResidentCount() const { return resident.size(); }
+
+private:
+    // (element index, image index); backgrounds use image index 0
+    using AssetKey = std::pair<size_t, size_t>;
+
+    void collectSceneAssets(const Scene& scene, std::set<AssetKey>& out) const;
+    bool isMissing(const AssetKey& key) const;
+    void acquire(const AssetKey& key);
+    void release(const AssetKey& key);
+
+    ElementMap& elements;
+    SceneMap& scenes;
+    NodeMap& nodes;
+    int depth;
+    int lastNodeIndex;
+    std::set<AssetKey> resident;
+};
+
+#endif // ASSET_PREFETCHER_HPP
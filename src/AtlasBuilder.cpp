@@ -0,0 +1,68 @@
+#include "AtlasBuilder.hpp"
+#include <algorithm>
+#include <numeric>
+
+AtlasBuilder::AtlasBuilder(int pageSize, int padding) : pageSize(pageSize), padding(padding) {}
+
+AtlasBuilder::~AtlasBuilder() {
+    for (auto& image : images) {
+        if (image.data != nullptr) UnloadImage(image);
+    }
+}
+
+size_t AtlasBuilder::add(Image image) {
+    images.push_back(image);
+    return images.size() - 1;
+}
+
+std::vector<Image> AtlasBuilder::build(std::vector<AtlasPlacement>& placements) {
+    placements.assign(images.size(), {-1, {0, 0, 0, 0}});
+
+    std::vector<size_t> order(images.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [this](size_t a, size_t b) { return images[a].height > images[b].height; });
+
+    // Shelf packing; page extents track the used area so the last page can be trimmed
+    std::vector<std::pair<int, int>> pageExtents;
+    int page = -1;
+    int shelfX = 0, shelfY = 0, shelfHeight = 0;
+    for (size_t index : order) {
+        const Image& image = images[index];
+        if (image.data == nullptr) continue;
+        int w = image.width + padding;
+        int h = image.height + padding;
+        if (w > pageSize || h > pageSize) continue; // Too big to share a page
+
+        if (page >= 0 && shelfX + w > pageSize) {
+            shelfY += shelfHeight;
+            shelfX = 0;
+            shelfHeight = 0;
+        }
+        if (page < 0 || shelfY + h > pageSize) {
+            pageExtents.push_back({0, 0});
+            page = (int)pageExtents.size() - 1;
+            shelfX = shelfY = shelfHeight = 0;
+        }
+
+        placements[index] = {page, {(float)shelfX, (float)shelfY, (float)image.width, (float)image.height}};
+        shelfX += w;
+        shelfHeight = std::max(shelfHeight, h);
+        pageExtents[page].first = std::max(pageExtents[page].first, shelfX);
+        pageExtents[page].second = std::max(pageExtents[page].second, shelfY + h);
+    }
+
+    // Round page sizes up to whole 4x4 blocks so pages can be block-compressed
+    std::vector<Image> pages;
+    for (const auto& [width, height] : pageExtents) {
+        pages.push_back(GenImageColor(std::min((width + 3) & ~3, pageSize), std::min((height + 3) & ~3, pageSize), BLANK));
+    }
+    for (size_t i = 0; i < images.size(); ++i) {
+        if (placements[i].page < 0) continue;
+        Image& image = images[i];
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        ImageDraw(&pages[placements[i].page], image,
+                  {0, 0, (float)image.width, (float)image.height}, placements[i].rect, WHITE);
+    }
+    return pages;
+}
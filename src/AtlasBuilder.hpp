@@ -0,0 +1,42 @@
+#ifndef ATLAS_BUILDER_HPP
+#define ATLAS_BUILDER_HPP
+
+#include "raylib.h"
+
+#include <vector>
+
+// Where one input image ended up. page == -1 means it was larger than a page
+// and should be shipped as a standalone texture.
+struct AtlasPlacement
+{
+    int page;
+    Rectangle rect;
+};
+
+// Packs images into one or more atlas pages with a shelf packer (tallest
+// first, left to right, new shelf when a row is full, new page when a page
+// is full). Used at export time so all poses of a character share a texture
+// and can be drawn with DrawTexturePro from sub-rectangles.
+class AtlasBuilder
+{
+public:
+    explicit AtlasBuilder(int pageSize = 4096, int padding = 2);
+    ~AtlasBuilder();
+
+    // Takes ownership of image and returns its index for build()'s placements
+    size_t add(Image image);
+
+    // An added image (already converted to RGBA8 once build() ran)
+    const Image& getImage(size_t index) const { return images[index]; }
+
+    // Packs all added images. placements is indexed like add(); the returned
+    // page images are owned by the caller (UnloadImage).
+    std::vector<Image> build(std::vector<AtlasPlacement>& placements);
+
+private:
+    int pageSize;
+    int padding;
+    std::vector<Image> images;
+};
+
+#endif // ATLAS_BUILDER_HPP
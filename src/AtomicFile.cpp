@@ -0,0 +1,129 @@
+#include "AtomicFile.hpp"
+
+#ifdef _WIN32
+// Keep windows.h from declaring the GDI/USER names raylib also uses
+#define NOGDI
+#define NOUSER
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <filesystem>
+#include "Log.hpp"
+
+AtomicFile::~AtomicFile() {
+    discard();
+}
+
+bool AtomicFile::open(const std::string& path) {
+    discard();
+    this->path = path;
+    tempPath = path + ".tmp";
+    failed = false;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LogWarning("Failed to create file: %s", tempPath.c_str());
+        return false;
+    }
+    handle = file;
+#else
+    fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        LogWarning("Failed to create file: %s", tempPath.c_str());
+        return false;
+    }
+#endif
+    opened = true;
+    return true;
+}
+
+bool AtomicFile::write(const void* data, size_t size) {
+    if (!opened || failed) return false;
+    const char* bytes = (const char*)data;
+    while (size > 0) {
+#ifdef _WIN32
+        DWORD chunk = size > (1u << 30) ? (1u << 30) : (DWORD)size;
+        DWORD written = 0;
+        if (!WriteFile((HANDLE)handle, bytes, chunk, &written, nullptr)) {
+            failed = true;
+            return false;
+        }
+#else
+        ssize_t written = ::write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            failed = true;
+            return false;
+        }
+#endif
+        bytes += written;
+        size -= written;
+    }
+    return true;
+}
+
+void AtomicFile::closeHandle() {
+#ifdef _WIN32
+    if (handle != nullptr) CloseHandle((HANDLE)handle);
+    handle = nullptr;
+#else
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+}
+
+bool AtomicFile::commit() {
+    if (!opened) return false;
+
+    // The data has to be on disk before the rename is, or a crash right after
+    // could leave the new name pointing at an empty file
+#ifdef _WIN32
+    if (!failed && !FlushFileBuffers((HANDLE)handle)) failed = true;
+#else
+    if (!failed && fsync(fd) != 0) failed = true;
+#endif
+    closeHandle();
+    opened = false;
+    if (failed) {
+        std::remove(tempPath.c_str());
+        LogWarning("Failed to write file: %s", tempPath.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    bool renamed = MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    bool renamed = std::rename(tempPath.c_str(), path.c_str()) == 0;
+#endif
+    if (!renamed) {
+        std::remove(tempPath.c_str());
+        LogWarning("Failed to move file into place: %s", path.c_str());
+        return false;
+    }
+
+#ifndef _WIN32
+    // Persist the directory entry as well
+    std::string directory = std::filesystem::path(path).parent_path().string();
+    int directoryFd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+    if (directoryFd >= 0) {
+        fsync(directoryFd);
+        ::close(directoryFd);
+    }
+#endif
+    return true;
+}
+
+void AtomicFile::discard() {
+    if (!opened) return;
+    closeHandle();
+    opened = false;
+    std::remove(tempPath.c_str());
+}
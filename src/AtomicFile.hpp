@@ -0,0 +1,41 @@
+#ifndef ATOMIC_FILE_HPP
+#define ATOMIC_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+// Replaces a file all at once: output goes to "<path>.tmp", and commit()
+// flushes it to disk and renames it over path. A crash or a failed write
+// leaves the previous file untouched instead of a truncated one.
+class AtomicFile
+{
+public:
+    AtomicFile() = default;
+    ~AtomicFile(); // Discards an uncommitted file
+    AtomicFile(const AtomicFile&) = delete;
+    AtomicFile& operator=(const AtomicFile&) = delete;
+
+    bool open(const std::string& path);
+    bool write(const void* data, size_t size);
+    // fsync + rename; false (and the temp file removed) if anything failed
+    bool commit();
+    void discard();
+
+    bool isOpen() const { return opened; }
+    bool hasFailed() const { return failed; }
+
+private:
+    void closeHandle();
+
+    std::string path;
+    std::string tempPath;
+    bool opened = false;
+    bool failed = false;
+#ifdef _WIN32
+    void* handle = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+#endif // ATOMIC_FILE_HPP
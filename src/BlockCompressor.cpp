@@ -0,0 +1,295 @@
+#include "BlockCompressor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+struct Color565 {
+    uint16_t packed;
+    int r, g, b; // Expanded back to 8 bits, what the GPU will interpolate
+};
+
+Color565 quantize565(float r, float g, float b) {
+    auto clamp = [](float v, int maxValue) {
+        int q = (int)std::lround(v * maxValue / 255.0f);
+        return q < 0 ? 0 : (q > maxValue ? maxValue : q);
+    };
+    int r5 = clamp(r, 31), g6 = clamp(g, 63), b5 = clamp(b, 31);
+    return {(uint16_t)((r5 << 11) | (g6 << 5) | b5), (r5 << 3) | (r5 >> 2), (g6 << 2) | (g6 >> 4), (b5 << 3) | (b5 >> 2)};
+}
+
+Color565 unpack565(uint16_t packed) {
+    int r5 = (packed >> 11) & 31, g6 = (packed >> 5) & 63, b5 = packed & 31;
+    return {packed, (r5 << 3) | (r5 >> 2), (g6 << 2) | (g6 >> 4), (b5 << 3) | (b5 >> 2)};
+}
+
+void writeLE16(unsigned char* out, uint16_t v) {
+    out[0] = v & 0xFF;
+    out[1] = v >> 8;
+}
+
+// Color endpoints from the extremes of the block along its principal axis,
+// then each pixel takes the nearest of the four palette entries
+void encodeColorBlock(const unsigned char block[16][4], unsigned char* out) {
+    float mean[3] = {0, 0, 0};
+    for (int i = 0; i < 16; ++i)
+        for (int c = 0; c < 3; ++c) mean[c] += block[i][c] / 16.0f;
+
+    float cov[6] = {0, 0, 0, 0, 0, 0}; // rr rg rb gg gb bb
+    for (int i = 0; i < 16; ++i) {
+        float r = block[i][0] - mean[0], g = block[i][1] - mean[1], b = block[i][2] - mean[2];
+        cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+        cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+    }
+    float axis[3] = {1, 1, 1};
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+        float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+        float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+        float length = std::max(std::fabs(x), std::max(std::fabs(y), std::fabs(z)));
+        if (length < 1e-6f) break; // Flat block, any axis works
+        axis[0] = x / length; axis[1] = y / length; axis[2] = z / length;
+    }
+
+    int minIndex = 0, maxIndex = 0;
+    float minDot = 1e30f, maxDot = -1e30f;
+    for (int i = 0; i < 16; ++i) {
+        float dot = block[i][0] * axis[0] + block[i][1] * axis[1] + block[i][2] * axis[2];
+        if (dot < minDot) { minDot = dot; minIndex = i; }
+        if (dot > maxDot) { maxDot = dot; maxIndex = i; }
+    }
+    Color565 c0 = quantize565(block[maxIndex][0], block[maxIndex][1], block[maxIndex][2]);
+    Color565 c1 = quantize565(block[minIndex][0], block[minIndex][1], block[minIndex][2]);
+    if (c0.packed < c1.packed) std::swap(c0, c1); // c0 > c1 selects the four-color mode
+
+    uint32_t indices = 0;
+    if (c0.packed != c1.packed) {
+        int palette[4][3] = {
+            {c0.r, c0.g, c0.b},
+            {c1.r, c1.g, c1.b},
+            {(2 * c0.r + c1.r) / 3, (2 * c0.g + c1.g) / 3, (2 * c0.b + c1.b) / 3},
+            {(c0.r + 2 * c1.r) / 3, (c0.g + 2 * c1.g) / 3, (c0.b + 2 * c1.b) / 3},
+        };
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestDistance = 1 << 30;
+            for (int p = 0; p < 4; ++p) {
+                int dr = block[i][0] - palette[p][0], dg = block[i][1] - palette[p][1], db = block[i][2] - palette[p][2];
+                int distance = dr * dr + dg * dg + db * db;
+                if (distance < bestDistance) { bestDistance = distance; best = p; }
+            }
+            indices |= (uint32_t)best << (2 * i);
+        }
+    }
+    writeLE16(out, c0.packed);
+    writeLE16(out + 2, c1.packed);
+    for (int k = 0; k < 4; ++k) out[4 + k] = (indices >> (8 * k)) & 0xFF;
+}
+
+// DXT5 alpha: min/max endpoints with six interpolated steps between them
+void encodeAlphaBlock(const unsigned char block[16][4], unsigned char* out) {
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; ++i) {
+        a0 = std::max(a0, (int)block[i][3]);
+        a1 = std::min(a1, (int)block[i][3]);
+    }
+    uint64_t indices = 0;
+    if (a0 != a1) {
+        int palette[8] = {a0, a1};
+        for (int p = 1; p <= 6; ++p) palette[p + 1] = ((7 - p) * a0 + p * a1) / 7;
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestDistance = 256;
+            for (int p = 0; p < 8; ++p) {
+                int distance = std::abs(block[i][3] - palette[p]);
+                if (distance < bestDistance) { bestDistance = distance; best = p; }
+            }
+            indices |= (uint64_t)best << (3 * i);
+        }
+    }
+    out[0] = (unsigned char)a0;
+    out[1] = (unsigned char)a1;
+    for (int k = 0; k < 6; ++k) out[2 + k] = (indices >> (8 * k)) & 0xFF;
+}
+
+void decodeColorBlock(const unsigned char* in, unsigned char block[16][4]) {
+    uint16_t p0 = in[0] | (in[1] << 8), p1 = in[2] | (in[3] << 8);
+    Color565 c0 = unpack565(p0), c1 = unpack565(p1);
+    int palette[4][4] = {{c0.r, c0.g, c0.b, 255}, {c1.r, c1.g, c1.b, 255}};
+    if (p0 > p1) {
+        for (int c = 0; c < 3; ++c) {
+            int e0 = palette[0][c], e1 = palette[1][c];
+            palette[2][c] = (2 * e0 + e1) / 3;
+            palette[3][c] = (e0 + 2 * e1) / 3;
+        }
+        palette[2][3] = palette[3][3] = 255;
+    } else {
+        for (int c = 0; c < 3; ++c) palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+        palette[2][3] = 255;
+        palette[3][0] = palette[3][1] = palette[3][2] = palette[3][3] = 0;
+    }
+    uint32_t indices = in[4] | (in[5] << 8) | (in[6] << 16) | ((uint32_t)in[7] << 24);
+    for (int i = 0; i < 16; ++i) {
+        const int* color = palette[(indices >> (2 * i)) & 3];
+        for (int c = 0; c < 4; ++c) block[i][c] = (unsigned char)color[c];
+    }
+}
+
+void decodeAlphaBlock(const unsigned char* in, unsigned char block[16][4]) {
+    int a0 = in[0], a1 = in[1];
+    int palette[8] = {a0, a1};
+    if (a0 > a1) {
+        for (int p = 1; p <= 6; ++p) palette[p + 1] = ((7 - p) * a0 + p * a1) / 7;
+    } else {
+        for (int p = 1; p <= 4; ++p) palette[p + 1] = ((5 - p) * a0 + p * a1) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    uint64_t indices = 0;
+    for (int k = 0; k < 6; ++k) indices |= (uint64_t)in[2 + k] << (8 * k);
+    for (int i = 0; i < 16; ++i) block[i][3] = (unsigned char)palette[(indices >> (3 * i)) & 7];
+}
+
+bool isDXT1(int format) {
+    return format == PIXELFORMAT_COMPRESSED_DXT1_RGB || format == PIXELFORMAT_COMPRESSED_DXT1_RGBA;
+}
+
+size_t blockDataSize(int width, int height, int blockBytes) {
+    return (size_t)((width + 3) / 4) * ((height + 3) / 4) * blockBytes;
+}
+
+} // namespace
+
+namespace BlockCompressor {
+
+Image compress(const Image& image) {
+    Image result = {0};
+    if (image.data == nullptr || image.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB) return result;
+
+    Image rgba = ImageCopy(image);
+    ImageFormat(&rgba, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    const unsigned char* pixels = (const unsigned char*)rgba.data;
+
+    bool hasAlpha = false;
+    for (int i = 0; i < rgba.width * rgba.height && !hasAlpha; ++i) hasAlpha = pixels[i * 4 + 3] < 255;
+    int blockBytes = hasAlpha ? 16 : 8;
+
+    size_t dataSize = blockDataSize(rgba.width, rgba.height, blockBytes);
+    unsigned char* out = (unsigned char*)RL_MALLOC(dataSize);
+    unsigned char* blockOut = out;
+    for (int by = 0; by < rgba.height; by += 4) {
+        for (int bx = 0; bx < rgba.width; bx += 4) {
+            // Edge blocks repeat the last row/column so padding doesn't skew the fit
+            unsigned char block[16][4];
+            for (int y = 0; y < 4; ++y) {
+                for (int x = 0; x < 4; ++x) {
+                    int px = std::min(bx + x, rgba.width - 1);
+                    int py = std::min(by + y, rgba.height - 1);
+                    std::memcpy(block[y * 4 + x], pixels + ((size_t)py * rgba.width + px) * 4, 4);
+                }
+            }
+            if (hasAlpha) {
+                encodeAlphaBlock(block, blockOut);
+                blockOut += 8;
+            }
+            encodeColorBlock(block, blockOut);
+            blockOut += 8;
+        }
+    }
+
+    result.data = out;
+    result.width = rgba.width;
+    result.height = rgba.height;
+    result.mipmaps = 1;
+    result.format = hasAlpha ? PIXELFORMAT_COMPRESSED_DXT5_RGBA : PIXELFORMAT_COMPRESSED_DXT1_RGB;
+    UnloadImage(rgba);
+    return result;
+}
+
+Image decompress(const Image& image) {
+    Image result = {0};
+    if (image.data == nullptr) return result;
+    if (!isDXT1(image.format) && image.format != PIXELFORMAT_COMPRESSED_DXT5_RGBA) {
+        if (image.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB) return result; // Not a format we encode
+        result = ImageCopy(image);
+        ImageFormat(&result, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        return result;
+    }
+
+    bool hasAlpha = !isDXT1(image.format);
+    unsigned char* pixels = (unsigned char*)RL_MALLOC((size_t)image.width * image.height * 4);
+    const unsigned char* blockIn = (const unsigned char*)image.data;
+    for (int by = 0; by < image.height; by += 4) {
+        for (int bx = 0; bx < image.width; bx += 4) {
+            unsigned char block[16][4];
+            decodeColorBlock(blockIn + (hasAlpha ? 8 : 0), block);
+            if (hasAlpha) decodeAlphaBlock(blockIn, block);
+            blockIn += hasAlpha ? 16 : 8;
+            for (int y = 0; y < 4 && by + y < image.height; ++y) {
+                for (int x = 0; x < 4 && bx + x < image.width; ++x) {
+                    std::memcpy(pixels + ((size_t)(by + y) * image.width + bx + x) * 4, block[y * 4 + x], 4);
+                }
+            }
+        }
+    }
+
+    result.data = pixels;
+    result.width = image.width;
+    result.height = image.height;
+    result.mipmaps = 1;
+    result.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return result;
+}
+
+bool exportDDS(const Image& image, const char* fileName) {
+    if (image.data == nullptr || (!isDXT1(image.format) && image.format != PIXELFORMAT_COMPRESSED_DXT5_RGBA)) return false;
+
+    size_t dataSize = blockDataSize(image.width, image.height, isDXT1(image.format) ? 8 : 16);
+    uint32_t header[31] = {0}; // DDS_HEADER, 124 bytes
+    header[0] = 124;
+    header[1] = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000; // CAPS | HEIGHT | WIDTH | PIXELFORMAT | MIPMAPCOUNT | LINEARSIZE
+    header[2] = image.height;
+    header[3] = image.width;
+    header[4] = (uint32_t)dataSize;
+    header[6] = 1;                                            // mipmap count
+    header[18] = 32;                                          // DDS_PIXELFORMAT size
+    header[19] = 0x4;                                         // DDPF_FOURCC
+    std::memcpy(&header[20], isDXT1(image.format) ? "DXT1" : "DXT5", 4);
+    header[26] = 0x1000;                                      // DDSCAPS_TEXTURE
+
+    FILE* file = fopen(fileName, "wb");
+    if (file == nullptr) return false;
+    // DDS is little-endian, like every platform we build for
+    bool ok = fwrite("DDS ", 1, 4, file) == 4 &&
+              fwrite(header, sizeof(header), 1, file) == 1 &&
+              fwrite(image.data, 1, dataSize, file) == dataSize;
+    return fclose(file) == 0 && ok;
+}
+
+double computePSNR(const Image& a, const Image& b) {
+    if (a.width != b.width || a.height != b.height) return 0.0;
+    Image ra = decompress(a);
+    Image rb = decompress(b);
+    if (ra.data == nullptr || rb.data == nullptr) {
+        UnloadImage(ra);
+        UnloadImage(rb);
+        return 0.0;
+    }
+
+    const unsigned char* pa = (const unsigned char*)ra.data;
+    const unsigned char* pb = (const unsigned char*)rb.data;
+    size_t count = (size_t)a.width * a.height * 4;
+    double sum = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double d = (double)pa[i] - pb[i];
+        sum += d * d;
+    }
+    UnloadImage(ra);
+    UnloadImage(rb);
+    if (sum == 0.0) return INFINITY;
+    double mse = sum / count;
+    return 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+} // namespace BlockCompressor
@@ -0,0 +1,27 @@
+#ifndef BLOCK_COMPRESSOR_HPP
+#define BLOCK_COMPRESSOR_HPP
+
+#include "raylib.h"
+
+// CPU encoder/decoder for the S3TC block formats raylib can upload as-is
+// (DXT1 for opaque images, DXT5 when there is alpha) plus a DDS writer, so
+// export can ship textures that skip PNG decoding and take 4-8x less VRAM.
+// Images use raylib's conventions: data is RL_MALLOC'd, free with UnloadImage.
+namespace BlockCompressor
+{
+    // Encode image (any uncompressed format) as DXT1, or DXT5 if any pixel is
+    // not fully opaque. Returns an image with data == nullptr on failure.
+    Image compress(const Image& image);
+
+    // Decode a DXT1/DXT5 image back to R8G8B8A8
+    Image decompress(const Image& image);
+
+    // Write a compressed image as a .dds file LoadImage() can read
+    bool exportDDS(const Image& image, const char* fileName);
+
+    // Peak signal-to-noise ratio in dB over RGBA of two same-sized images;
+    // identical images return INFINITY
+    double computePSNR(const Image& a, const Image& b);
+}
+
+#endif // BLOCK_COMPRESSOR_HPP
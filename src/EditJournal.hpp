@@ -0,0 +1,367 @@
+#ifndef EDIT_JOURNAL_HPP
+#define EDIT_JOURNAL_HPP
+
+#include "ProjectJson.hpp"
+#include "ProjectObserver.hpp"
+#include "ProjectSaver.hpp"
+#include "Log.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <string>
+
+// Append-only log of the editors' changes, so persisting an edit costs as
+// much as the edit rather than the whole story and a crashed editor loses
+// nothing. The directory holds numbered generations: snapshot.<g>.json is
+// the project when generation g began and journal.<g>.jsonl the changes made
+// since, one JSON record per line. A journal is only created once its
+// snapshot is on disk, so there is always a base to replay it onto.
+// Compaction writes the next snapshot in the background (ProjectSaver, so it
+// appears atomically) after putting a marker record naming it in the current
+// journal, which keeps taking changes until the snapshot is written; then
+// journaling moves to the new generation and older files are deleted.
+// Recovery loads the newest snapshot, replays the previous journal from that
+// snapshot's marker on and then its own journal, so a crash at any point
+// replays each change once.
+class EditJournal : public ProjectObserver
+{
+public:
+    static constexpr const char* DEFAULT_DIRECTORY = ".autosave";
+    static constexpr size_t COMPACT_RECORDS = 1000; // Compact after this many records...
+    static constexpr double COMPACT_INTERVAL = 60.0; // ...or this many seconds after the first one
+
+    EditJournal(ElementMap& elements, SceneMap& scenes, NodeMap& nodes,
+                const std::string& directory = DEFAULT_DIRECTORY)
+        : elements(elements), scenes(scenes), nodes(nodes), directory(directory),
+          saver([](JsonWriter& writer, const ProjectSnapshot& snapshot)
+                { JsonUtils::writeProject(writer, snapshot.elements, snapshot.scenes, snapshot.nodes,
+                                           SlotIndexing::SLOTS); },
+                JsonWriter::Style::COMPACT)
+    {}
+
+    // Restore the project as the last session left it and start journaling
+    // on top of it. Returns true if anything was recovered.
+    bool open(double time)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        std::set<uint64_t> snapshots, journals;
+        scan(snapshots, journals);
+        for (uint64_t g : snapshots) lastGeneration = std::max(lastGeneration, g);
+        for (uint64_t g : journals) lastGeneration = std::max(lastGeneration, g);
+
+        bool recovered = !snapshots.empty();
+        if (recovered)
+        {
+            uint64_t base = *snapshots.rbegin();
+            try
+            {
+                JsonUtils::importFromFile(elements, scenes, nodes, snapshotPath(base), false);
+            }
+            catch (const std::exception& e)
+            {
+                // Leave the files alone so nothing more is lost
+                LogError("Edit journal disabled, failed to load %s: %s", snapshotPath(base).c_str(), e.what());
+                return false;
+            }
+            // Changes made while the snapshot was being written are at the end
+            // of the journal before it
+            size_t replayed = 0;
+            auto next = journals.lower_bound(base);
+            if (next != journals.begin()) replayed += replay(journalPath(*std::prev(next)), base);
+            if (journals.count(base) != 0) replayed += replay(journalPath(base), 0);
+            resolvePoses(elements, scenes);
+            indexSlides(elements, scenes);
+            LogInfo("Recovered project from %s: %zu journaled change(s) replayed", directory.c_str(), replayed);
+        }
+        // Nothing says what a journal without its snapshot applies to
+        for (uint64_t g : journals)
+        {
+            if (snapshots.empty() || g > *snapshots.rbegin())
+            {
+                LogWarning("Edit journal: ignoring %s, its snapshot was never written", journalPath(g).c_str());
+            }
+        }
+        opened = true;
+        now = time;
+        rebase();
+        return recovered;
+    }
+
+    // Call once per frame; compacts when enough has been journaled
+    void update(double time)
+    {
+        now = time;
+        if (pending != 0 && !saver.isSaving()) finishCompaction();
+        if (!journal.is_open() || records == 0 || pending != 0) return;
+        if (records >= COMPACT_RECORDS || now - firstRecordTime >= COMPACT_INTERVAL)
+        {
+            startCompaction();
+        }
+    }
+
+    void elementChanged(size_t index) override
+    {
+        if (elements.isAlive(index)) append("element", index, JsonUtils::elementToJson(elements[index]));
+    }
+
+    void sceneChanged(size_t index) override
+    {
+        if (scenes.isAlive(index)) append("scene", index, JsonUtils::sceneToJson(scenes[index]));
+    }
+
+    void nodeChanged(size_t index) override
+    {
+        if (nodes.isAlive(index)) append("node", index, JsonUtils::nodeToJson(nodes[index]));
+    }
+
+    void elementErased(size_t index) override
+    {
+        append("eraseElement", index, nullptr);
+    }
+
+    void sceneErased(size_t index) override
+    {
+        append("eraseScene", index, nullptr);
+    }
+
+    void nodeErased(size_t index) override
+    {
+        append("eraseNode", index, nullptr);
+    }
+
+    // Replaying an import would mean journaling the whole project; start a new
+    // generation from it instead. Until its snapshot is written a crash
+    // recovers the project as it was before the import.
+    void projectReplaced() override
+    {
+        if (opened) rebase();
+    }
+
+private:
+    std::string snapshotPath(uint64_t g) const
+    {
+        return (std::filesystem::path(directory) / ("snapshot." + std::to_string(g) + ".json")).string();
+    }
+
+    std::string journalPath(uint64_t g) const
+    {
+        return (std::filesystem::path(directory) / ("journal." + std::to_string(g) + ".jsonl")).string();
+    }
+
+    // Generation number of a file named prefix + number + suffix
+    static bool parseGeneration(const std::string& name, const std::string& prefix, const std::string& suffix, uint64_t& g)
+    {
+        if (name.size() <= prefix.size() + suffix.size() || name.compare(0, prefix.size(), prefix) != 0 ||
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0)
+        {
+            return false;
+        }
+        std::string digits = name.substr(prefix.size(), name.size() - prefix.size() - suffix.size());
+        if (!std::all_of(digits.begin(), digits.end(), [](unsigned char c) { return std::isdigit(c); })) return false;
+        g = std::stoull(digits);
+        return true;
+    }
+
+    void scan(std::set<uint64_t>& snapshots, std::set<uint64_t>& journals) const
+    {
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, ec))
+        {
+            std::string name = entry.path().filename().string();
+            uint64_t g;
+            if (parseGeneration(name, "snapshot.", ".json", g)) snapshots.insert(g);
+            else if (parseGeneration(name, "journal.", ".jsonl", g)) journals.insert(g);
+        }
+    }
+
+    // Apply one journal file, or only the records after the marker of snapshot
+    // `after` unless that is 0. Stops at the first record it can't apply, which
+    // after a crash is a half-written last line.
+    size_t replay(const std::string& path, uint64_t after)
+    {
+        std::ifstream file(path);
+        std::string line;
+        size_t count = 0, lineNumber = 0;
+        bool applying = after == 0;
+        while (std::getline(file, line))
+        {
+            ++lineNumber;
+            json record = json::parse(line, nullptr, false);
+            if (!record.is_discarded() && record.is_object() && record.value("op", std::string()) == "snapshot")
+            {
+                if (record.value("index", uint64_t(0)) == after) applying = true;
+                continue;
+            }
+            if (!applying) continue;
+            if (record.is_discarded() || !apply(record))
+            {
+                LogWarning("Edit journal %s: ignoring line %zu and everything after it", path.c_str(), lineNumber);
+                break;
+            }
+            ++count;
+        }
+        return count;
+    }
+
+    bool apply(const json& record)
+    {
+        try
+        {
+            const std::string op = record.at("op").get<std::string>();
+            size_t index = record.at("index").get<size_t>();
+            // What refers to the changed item (usedBy, shownBy, incoming) is
+            // kept; the records only hold what the editors save
+            if (op == "element")
+            {
+                Element element = JsonUtils::jsonToElement(record.at("value"));
+                if (index < elements.size()) element.usedBy = std::move(elements[index].usedBy);
+                return elements.assign(index, std::move(element));
+            }
+            if (op == "scene")
+            {
+                Scene scene = JsonUtils::jsonToScene(record.at("value"));
+                if (index < scenes.size()) scene.shownBy = std::move(scenes[index].shownBy);
+                if (!scenes.assign(index, std::move(scene))) return false;
+                linkScene(elements, scenes, index);
+                return true;
+            }
+            if (op == "node")
+            {
+                Node node = JsonUtils::jsonToNode(record.at("value"));
+                if (index < nodes.size()) node.incoming = std::move(nodes[index].incoming);
+                if (!nodes.assign(index, std::move(node))) return false;
+                linkConnections(nodes, index);
+                linkSceneOf(scenes, nodes, index);
+                return true;
+            }
+            if (op == "eraseElement" && elements.isAlive(index))
+            {
+                eraseElement(elements, scenes, index);
+                return true;
+            }
+            if (op == "eraseScene" && scenes.isAlive(index))
+            {
+                eraseScene(scenes, nodes, index);
+                return true;
+            }
+            if (op == "eraseNode" && nodes.isAlive(index))
+            {
+                eraseNode(nodes, index);
+                return true;
+            }
+        }
+        catch (const json::exception&)
+        {
+        }
+        return false;
+    }
+
+    void append(const char* op, size_t index, json value)
+    {
+        if (!journal.is_open()) return;
+        json record = {{"op", op}, {"index", index}};
+        if (!value.is_null()) record["value"] = std::move(value);
+        try
+        {
+            journal << record.dump() << '\n';
+        }
+        catch (const json::exception& e)
+        {
+            LogWarning("Edit journal: failed to record %s %zu: %s", op, index, e.what());
+            return;
+        }
+        journal.flush(); // In the OS's hands, so it survives the editor crashing
+        if (records++ == 0) firstRecordTime = now;
+    }
+
+    // Snapshot the project in the background, marking where in the journal it
+    // was taken; changes keep going to this journal until it is written
+    void startCompaction()
+    {
+        pending = ++lastGeneration;
+        journal << json{{"op", "snapshot"}, {"index", pending}}.dump() << '\n';
+        journal.flush(); // Before the snapshot can exist
+        saver.save(ProjectSnapshot::capture(elements, scenes, nodes), snapshotPath(pending));
+        records = 0;
+    }
+
+    void finishCompaction()
+    {
+        uint64_t g = pending;
+        pending = 0;
+        std::string error = saver.getLastError();
+        if (!error.empty())
+        {
+            LogWarning("Edit journal: failed to write %s, still journaling to %s: %s", snapshotPath(g).c_str(),
+                       journalPath(generation).c_str(), error.c_str());
+            return;
+        }
+        switchTo(g, generation); // Which holds the changes since g's marker
+    }
+
+    // Start a generation from the project as it is now, blocking until its
+    // snapshot is written so nothing is journaled without a base
+    void rebase()
+    {
+        journal.close();
+        saver.wait(); // A compaction in flight is superseded by this snapshot
+        pending = 0;
+        records = 0;
+        uint64_t g = ++lastGeneration;
+        saver.save(ProjectSnapshot::capture(elements, scenes, nodes), snapshotPath(g));
+        if (!saver.wait())
+        {
+            LogError("Edit journal disabled, failed to write %s: %s", snapshotPath(g).c_str(), saver.getLastError().c_str());
+            return;
+        }
+        switchTo(g, 0);
+    }
+
+    // Journal generation g, whose snapshot is written, and delete every other
+    // file except journal `keep`
+    void switchTo(uint64_t g, uint64_t keep)
+    {
+        journal.close();
+        journal.clear();
+        journal.open(journalPath(g), std::ios::trunc);
+        generation = g;
+        if (!journal.is_open())
+        {
+            LogWarning("Edit journal disabled, failed to create %s", journalPath(g).c_str());
+        }
+        purge(keep);
+    }
+
+    void purge(uint64_t keep)
+    {
+        std::set<uint64_t> snapshots, journals;
+        scan(snapshots, journals);
+        std::error_code ec;
+        for (uint64_t g : snapshots)
+        {
+            if (g != generation) std::filesystem::remove(snapshotPath(g), ec);
+        }
+        for (uint64_t g : journals)
+        {
+            if (g != generation && g != keep) std::filesystem::remove(journalPath(g), ec);
+        }
+    }
+
+    ElementMap& elements;
+    SceneMap& scenes;
+    NodeMap& nodes;
+    std::string directory;
+    ProjectSaver saver;
+    std::ofstream journal;
+    bool opened = false;
+    uint64_t generation = 0;     // Of the open journal
+    uint64_t lastGeneration = 0; // Highest number used in the directory
+    uint64_t pending = 0;        // Snapshot being written, 0 if none
+    size_t records = 0; // Since the last compaction
+    double firstRecordTime = 0.0;
+    double now = 0.0; // As of the last update()
+};
+
+#endif // EDIT_JOURNAL_HPP
@@ -2,6 +2,9 @@
 #define RAYGUI_IMPLEMENTATION
 #include "ElementEditor.hpp"
 #include "FileUtils.hpp"
+#include "ThumbnailCache.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
 #include <fstream>
 
 ElementEditor::ElementEditor() {
@@ -22,33 +25,21 @@ ElementEditor::ElementEditor() {
     imageScrollOffset = 0.0f;
 }
 
-ElementEditor::~ElementEditor() {
-    for (auto& element : elements) {
-        if (element.type == ElementType::CHARACTER) {
-            auto& character = std::get<CharacterElement>(element.data);
-            for (auto& texture : character.textures) {
-                if (texture.id > 0) UnloadTexture(texture);
-            }
-        } else if (element.type == ElementType::BACKGROUND) {
-            auto& bg = std::get<BackgroundElement>(element.data);
-            if (bg.texture.id > 0) UnloadTexture(bg.texture);
-        }
-    }
-}
-
-std::vector<Element>& ElementEditor::getElements() {
+ElementMap& ElementEditor::getElements() {
     return elements;
 }
 
-std::vector<Scene>& ElementEditor::getScenes() {
+SceneMap& ElementEditor::getScenes() {
     return scenes;
 }
 
 void ElementEditor::update() {
+    PROFILE_ZONE("ElementEditor::update");
     updateElementMode();
 }
 
 void ElementEditor::draw() {
+    PROFILE_ZONE("ElementEditor::draw");
     drawElementMode();
 }
 
@@ -71,7 +62,7 @@ void ElementEditor::updateElementMode() {
         } else {
             // Scroll for elements list
             elementScrollOffset -= mouseWheelMove * 20.0f;
-            float maxScroll = elements.size() * 40.0f - 500.0f;
+            float maxScroll = elements.liveCount() * 40.0f - 500.0f;
             if (maxScroll < 0) maxScroll = 0;
             elementScrollOffset = elementScrollOffset < 0 ? 0 : elementScrollOffset > maxScroll ? maxScroll : elementScrollOffset;
         }
@@ -97,10 +88,10 @@ void ElementEditor::updateElementMode() {
 
         if (newFocusedTextBox != -1) {
             focusedTextBox = newFocusedTextBox;
-            TraceLog(LOG_INFO, "Focused TextBox set to %d", focusedTextBox);
+            LogInfo("Focused TextBox set to %d", focusedTextBox);
         } else if (!CheckCollisionPointRec(mousePos, (Rectangle){220.0f, 10.0f, 770.0f, 580.0f})) {
             focusedTextBox = -1;
-            TraceLog(LOG_INFO, "Focused TextBox cleared");
+            LogInfo("Focused TextBox cleared");
         }
     }
 }
@@ -120,7 +111,7 @@ void ElementEditor::clearBuffers() {
 }
 
 void ElementEditor::loadElementToUI() {
-    if (currentElementIndex < 0 || currentElementIndex >= (int)elements.size()) {
+    if (currentElementIndex < 0 || !elements.isAlive(currentElementIndex)) {
         if (!isEditing) {
             clearBuffers();
         }
@@ -140,37 +131,14 @@ void ElementEditor::loadElementToUI() {
         strncpy(charNameBuffer, character.name.c_str(), sizeof(charNameBuffer));
         textBuffer[0] = '\0';
         bgPathBuffer[0] = '\0';
-        // Ensure textures match images
-        for (auto& texture : character.textures) {
-            if (texture.id > 0) UnloadTexture(texture);
-        }
-        character.textures.clear();
-        for (const auto& img : character.images) {
-            Image image = LoadImage(img.second.c_str());
-            Texture2D texture = LoadTextureFromImage(image);
-            UnloadImage(image);
-            if (texture.id > 0) {
-                TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", texture.id, img.second.c_str());
-            } else {
-                TraceLog(LOG_WARNING, "Failed to load texture for path %s", img.second.c_str());
-            }
-            character.textures.push_back(texture);
-        }
+        // Previews come from ThumbnailCache; full-size textures are only loaded
+        // for Render mode (see AssetPrefetcher), so selecting never touches disk
+        character.textures.resize(character.images.size());
     } else {
         auto& bg = std::get<BackgroundElement>(element.data);
         strncpy(bgPathBuffer, bg.imagePath.c_str(), sizeof(bgPathBuffer));
         textBuffer[0] = '\0';
         charNameBuffer[0] = '\0';
-        // Reload texture
-        if (bg.texture.id > 0) UnloadTexture(bg.texture);
-        Image img = LoadImage(bg.imagePath.c_str());
-        bg.texture = LoadTextureFromImage(img);
-        UnloadImage(img);
-        if (bg.texture.id > 0) {
-            TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", bg.texture.id, bg.imagePath.c_str());
-        } else {
-            TraceLog(LOG_WARNING, "Failed to load texture for path %s", bg.imagePath.c_str());
-        }
     }
     imageNameBuffer[0] = '\0';
     imagePathBuffer[0] = '\0';
@@ -192,6 +160,9 @@ void ElementEditor::saveElement() {
             // Preserve existing images and textures
             character.images = std::get<CharacterElement>(elements[currentElementIndex].data).images;
             character.textures = std::get<CharacterElement>(elements[currentElementIndex].data).textures;
+            character.atlasRects = std::get<CharacterElement>(elements[currentElementIndex].data).atlasRects;
+            character.sourceSizes = std::get<CharacterElement>(elements[currentElementIndex].data).sourceSizes;
+            character.poseIds = std::get<CharacterElement>(elements[currentElementIndex].data).poseIds;
         }
         element.data = character;
     } else {
@@ -199,61 +170,61 @@ void ElementEditor::saveElement() {
         bg.imagePath = bgPathBuffer;
         if (currentElementIndex >= 0 && elements[currentElementIndex].type == ElementType::BACKGROUND) {
             auto& oldBg = std::get<BackgroundElement>(elements[currentElementIndex].data);
-            bg.texture = oldBg.texture; // Preserve texture
-        }
-        // Load texture if none exists
-        if (bg.texture.id == 0 && IsValidImagePath(bg.imagePath)) {
-            Image img = LoadImage(bg.imagePath.c_str());
-            bg.texture = LoadTextureFromImage(img);
-            UnloadImage(img);
-            if (bg.texture.id > 0) {
-                TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", bg.texture.id, bg.imagePath.c_str());
-            } else {
-                TraceLog(LOG_WARNING, "Failed to load texture for path %s", bg.imagePath.c_str());
-            }
+            if (oldBg.imagePath == bg.imagePath) bg.texture = oldBg.texture; // Preserve texture
         }
         element.data = bg;
     }
 
     if (currentElementIndex == -1) {
-        elements.push_back(element);
-        currentElementIndex = elements.size() - 1;
+        currentElementIndex = (int)elements.insert(element);
     } else {
-        // Clean up old textures if type changes
-        if (elements[currentElementIndex].type != element.type) {
-            if (elements[currentElementIndex].type == ElementType::CHARACTER) {
-                auto& oldChar = std::get<CharacterElement>(elements[currentElementIndex].data);
-                for (auto& texture : oldChar.textures) {
-                    if (texture.id > 0) UnloadTexture(texture);
-                }
-            } else if (elements[currentElementIndex].type == ElementType::BACKGROUND) {
-                auto& oldBg = std::get<BackgroundElement>(elements[currentElementIndex].data);
-                if (oldBg.texture.id > 0) UnloadTexture(oldBg.texture);
-            }
-        }
+        // Old texture handles are released by the assignment if the type changes
+        element.usedBy = std::move(elements[currentElementIndex].usedBy);
         elements[currentElementIndex] = element;
     }
+    notifyChanged();
+}
+
+// Scenes lose the element too; its slot is only reused by a later element
+void ElementEditor::deleteElement() {
+    if (currentElementIndex < 0) return;
+    LogInfo("Deleted Element %d", currentElementIndex);
+    eraseElement(elements, scenes, currentElementIndex);
+    if (observer) observer->elementErased(currentElementIndex);
+    currentElementIndex = -1;
+    isEditing = false;
+}
+
+void ElementEditor::notifyChanged() {
+    if (currentElementIndex < 0) return;
+    Element& element = elements[currentElementIndex];
+    if (element.type == ElementType::CHARACTER) {
+        std::get<CharacterElement>(element.data).internPoses(); // Poses may have been added or renamed
+    }
+    if (observer) observer->elementChanged(currentElementIndex);
 }
 
 void ElementEditor::drawElementMode() {
     GuiGroupBox((Rectangle){10.0f, 10.0f, 200.0f, 580.0f}, "Elements");
     BeginScissorMode(10, 50, 200, 500);
+    size_t row = 0;
     for (size_t i = 0; i < elements.size(); ++i) {
-        float yPos = 50.0f + static_cast<float>(i) * 40.0f - elementScrollOffset;
+        if (!elements.isAlive(i)) continue;
+        float yPos = 50.0f + static_cast<float>(row++) * 40.0f - elementScrollOffset;
         if (yPos > -40.0f && yPos < 550.0f) {
             if (GuiButton((Rectangle){20.0f, yPos, 180.0f, 30.0f}, elements[i].name.c_str())) {
                 currentElementIndex = i;
                 isEditing = true;
                 loadElementToUI();
-                TraceLog(LOG_INFO, "Selected Element %d", i);
+                LogInfo("Selected Element %zu", i);
             }
         }
     }
     EndScissorMode();
 
-    float maxScroll = elements.size() * 40.0f - 500.0f;
+    float maxScroll = elements.liveCount() * 40.0f - 500.0f;
     if (maxScroll > 0) {
-        float scrollBarHeight = 500.0f * (500.0f / (elements.size() * 40.0f));
+        float scrollBarHeight = 500.0f * (500.0f / (elements.liveCount() * 40.0f));
         float scrollBarY = 50.0f + (elementScrollOffset / maxScroll) * (500.0f - scrollBarHeight);
         DrawRectangle(190, scrollBarY, 10, scrollBarHeight, DARKGRAY);
     }
@@ -263,7 +234,7 @@ void ElementEditor::drawElementMode() {
         isEditing = true;
         focusedTextBox = -1;
         clearBuffers();
-        TraceLog(LOG_INFO, "Creating new Element");
+        LogInfo("Creating new Element");
     }
 
     if (GuiButton((Rectangle){20.0f, 510.0f, 180.0f, 30.0f}, "Export to JSON")) {
@@ -272,7 +243,7 @@ void ElementEditor::drawElementMode() {
 
     GuiGroupBox((Rectangle){220.0f, 10.0f, 770.0f, 580.0f}, "Element Editor");
 
-    if (currentElementIndex == -1 || currentElementIndex < (int)elements.size()) {
+    if (currentElementIndex == -1 || elements.isAlive(currentElementIndex)) {
         GuiLabel((Rectangle){230.0f, 30.0f, 100.0f, 20.0f}, "Element Name:");
         GuiTextBox((Rectangle){340.0f, 30.0f, 200.0f, 20.0f}, nameBuffer, 256, focusedTextBox == 0);
 
@@ -291,7 +262,7 @@ void ElementEditor::drawElementMode() {
             if (focusedTextBox == 1 && elementTypeIndex != 0) focusedTextBox = -1;
             if (focusedTextBox == 2 && elementTypeIndex != 1) focusedTextBox = -1;
             if (focusedTextBox == 3 && elementTypeIndex != 2) focusedTextBox = -1;
-            TraceLog(LOG_INFO, "Element type changed to %d", elementTypeIndex);
+            LogInfo("Element type changed to %d", elementTypeIndex);
         }
 
         if (elementTypeIndex == 0) {
@@ -309,20 +280,22 @@ void ElementEditor::drawElementMode() {
                     if (yPos > 110.0f && yPos < 510.0f) {
                         std::string imageInfo = character.images[i].first + ": " + character.images[i].second;
                         GuiLabel((Rectangle){340.0f, yPos, 300.0f, 20.0f}, imageInfo.c_str());
-                        if (i < character.textures.size() && character.textures[i].id > 0) {
-                            float scale = 50.0f / std::max(character.textures[i].width, character.textures[i].height);
-                            DrawTextureEx(character.textures[i],
-                                          {340.0f, yPos + 20.0f},
-                                          0, scale, WHITE);
-                            DrawText(TextFormat("Texture ID: %u", character.textures[i].id),
-                                     340, static_cast<int>(yPos) + 40, 10, DARKGRAY);
+                        Rectangle region = i < character.atlasRects.size() ? character.atlasRects[i] : Rectangle{0, 0, 0, 0};
+                        const Thumbnail& thumbnail = ThumbnailCache::instance().get(character.images[i].second, region);
+                        if (thumbnail.texture.id > 0) {
+                            const Texture2D& texture = thumbnail.texture;
+                            float scale = 50.0f / std::max(texture.width, texture.height);
+                            DrawTextureEx(texture, {340.0f, yPos + 20.0f}, 0, scale, WHITE);
+                        } else if (thumbnail.pending) {
+                            DrawRectangle(340, static_cast<int>(yPos) + 20, 50, 50, LIGHTGRAY);
+                            DrawText("Loading...", 400, static_cast<int>(yPos) + 40, 10, DARKGRAY);
                         }
                         if (GuiButton((Rectangle){650.0f, yPos, 80.0f, 20.0f}, "Edit")) {
                             showEditImage = true;
                             editImageIndex = i;
                             strncpy(imageNameBuffer, character.images[i].first.c_str(), sizeof(imageNameBuffer));
                             strncpy(imagePathBuffer, character.images[i].second.c_str(), sizeof(imagePathBuffer));
-                            TraceLog(LOG_INFO, "Editing image %d for Character", i);
+                            LogInfo("Editing image %zu for Character", i);
                         }
                     }
                 }
@@ -342,7 +315,7 @@ void ElementEditor::drawElementMode() {
                 showAddImage = true;
                 imageNameBuffer[0] = '\0';
                 imagePathBuffer[0] = '\0';
-                TraceLog(LOG_INFO, "Adding new image for Character");
+                LogInfo("Adding new image for Character");
             }
 
             if (showAddImage || showEditImage) {
@@ -358,23 +331,19 @@ void ElementEditor::drawElementMode() {
                     std::string file = OpenFileDialog();
                     if (!file.empty()) {
                         strncpy(imagePathBuffer, file.c_str(), sizeof(imagePathBuffer));
-                        TraceLog(LOG_INFO, "Selected image file: %s", imagePathBuffer);
+                        LogInfo("Selected image file: %s", imagePathBuffer);
                         if (currentElementIndex >= 0 && elements[currentElementIndex].type == ElementType::CHARACTER) {
                             auto& character = std::get<CharacterElement>(elements[currentElementIndex].data);
                             if (showEditImage && editImageIndex >= 0 && editImageIndex < (int)character.images.size()) {
-                                if (character.textures[editImageIndex].id > 0) {
-                                    UnloadTexture(character.textures[editImageIndex]);
-                                }
                                 character.images[editImageIndex] = {imageNameBuffer, file};
-                                Image img = LoadImage(file.c_str());
-                                character.textures[editImageIndex] = LoadTextureFromImage(img);
-                                UnloadImage(img);
-                                if (character.textures[editImageIndex].id > 0) {
-                                    TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", character.textures[editImageIndex].id, file.c_str());
-                                } else {
-                                    TraceLog(LOG_WARNING, "Failed to load texture for path %s", file.c_str());
-                                }
+                                character.textures.resize(character.images.size());
+                                character.textures[editImageIndex] = TextureHandle(); // Loaded on demand by Render mode
+                                character.atlasRects.resize(character.images.size());
+                                character.atlasRects[editImageIndex] = {0, 0, 0, 0}; // A picked file is a whole image
+                                character.sourceSizes.resize(character.images.size());
+                                character.sourceSizes[editImageIndex] = {0, 0};
                                 strncpy(imagePathBuffer, file.c_str(), sizeof(imagePathBuffer));
+                                notifyChanged();
                             }
                         }
                     }
@@ -384,29 +353,21 @@ void ElementEditor::drawElementMode() {
                         auto& character = std::get<CharacterElement>(elements[currentElementIndex].data);
                         if (showAddImage && IsValidImagePath(imagePathBuffer)) {
                             character.images.emplace_back(imageNameBuffer, imagePathBuffer);
-                            Image img = LoadImage(imagePathBuffer);
-                            Texture2D texture = LoadTextureFromImage(img);
-                            UnloadImage(img);
-                            if (texture.id > 0) {
-                                TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", texture.id, imagePathBuffer);
-                            } else {
-                                TraceLog(LOG_WARNING, "Failed to load texture for path %s", imagePathBuffer);
-                            }
-                            character.textures.push_back(texture);
+                            character.textures.resize(character.images.size());
+                            character.atlasRects.resize(character.images.size());
+                            character.sourceSizes.resize(character.images.size());
                         } else if (showEditImage && editImageIndex >= 0 && editImageIndex < (int)character.images.size() && IsValidImagePath(imagePathBuffer)) {
-                            if (character.textures[editImageIndex].id > 0) {
-                                UnloadTexture(character.textures[editImageIndex]);
+                            if (character.images[editImageIndex].second != imagePathBuffer) {
+                                character.atlasRects.resize(character.images.size());
+                                character.atlasRects[editImageIndex] = {0, 0, 0, 0}; // New file, no longer an atlas region
+                                character.sourceSizes.resize(character.images.size());
+                                character.sourceSizes[editImageIndex] = {0, 0};
+                                character.textures.resize(character.images.size());
+                                character.textures[editImageIndex] = TextureHandle(); // Loaded on demand by Render mode
                             }
                             character.images[editImageIndex] = {imageNameBuffer, imagePathBuffer};
-                            Image img = LoadImage(imagePathBuffer);
-                            character.textures[editImageIndex] = LoadTextureFromImage(img);
-                            UnloadImage(img);
-                            if (character.textures[editImageIndex].id > 0) {
-                                TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", character.textures[editImageIndex].id, imagePathBuffer);
-                            } else {
-                                TraceLog(LOG_WARNING, "Failed to load texture for path %s", imagePathBuffer);
-                            }
                         }
+                        notifyChanged();
                     }
                     showAddImage = false;
                     showEditImage = false;
@@ -427,30 +388,25 @@ void ElementEditor::drawElementMode() {
                 std::string file = OpenFileDialog();
                 if (!file.empty()) {
                     strncpy(bgPathBuffer, file.c_str(), sizeof(bgPathBuffer));
-                    TraceLog(LOG_INFO, "Selected background file: %s", bgPathBuffer);
+                    LogInfo("Selected background file: %s", bgPathBuffer);
                     if (currentElementIndex >= 0 && elements[currentElementIndex].type == ElementType::BACKGROUND) {
                         auto& bg = std::get<BackgroundElement>(elements[currentElementIndex].data);
                         bg.imagePath = file;
-                        if (bg.texture.id > 0) {
-                            UnloadTexture(bg.texture);
-                        }
-                        Image img = LoadImage(file.c_str());
-                        bg.texture = LoadTextureFromImage(img);
-                        UnloadImage(img);
-                        if (bg.texture.id > 0) {
-                            TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", bg.texture.id, file.c_str());
-                        } else {
-                            TraceLog(LOG_WARNING, "Failed to load texture for path %s", file.c_str());
-                        }
+                        bg.texture = TextureHandle(); // Loaded on demand by Render mode
+                        notifyChanged();
                     }
                 }
             }
             if (currentElementIndex >= 0 && elements[currentElementIndex].type == ElementType::BACKGROUND) {
                 auto& bg = std::get<BackgroundElement>(elements[currentElementIndex].data);
-                if (bg.texture.id > 0) {
-                    float scale = 100.0f / std::max(bg.texture.width, bg.texture.height);
-                    DrawTextureEx(bg.texture, {340.0f, 130.0f}, 0, scale, WHITE);
-                    DrawText(TextFormat("Texture ID: %u", bg.texture.id), 340, 230, 10, DARKGRAY);
+                const Thumbnail& thumbnail = ThumbnailCache::instance().get(bg.imagePath, {0, 0, 0, 0}, 100);
+                if (thumbnail.texture.id > 0) {
+                    const Texture2D& texture = thumbnail.texture;
+                    float scale = 100.0f / std::max(texture.width, texture.height);
+                    DrawTextureEx(texture, {340.0f, 130.0f}, 0, scale, WHITE);
+                } else if (thumbnail.pending) {
+                    DrawRectangle(340, 130, 100, 100, LIGHTGRAY);
+                    DrawText("Loading...", 340, 230, 10, DARKGRAY);
                 }
             }
         }
@@ -459,7 +415,10 @@ void ElementEditor::drawElementMode() {
             saveElement();
             isEditing = false;
             loadElementToUI();
-            TraceLog(LOG_INFO, "Saved Element %d", currentElementIndex);
+            LogInfo("Saved Element %d", currentElementIndex);
+        }
+        if (currentElementIndex >= 0 && GuiButton((Rectangle){450.0f, 550.0f, 100.0f, 20.0f}, "Delete")) {
+            deleteElement();
         }
     }
 }
@@ -497,9 +456,9 @@ void ElementEditor::exportToJson() {
         j_scene["name"] = scene.name;
         json j_scene_elements = json::array();
         for (const auto& sceneElement : scene.elements) {
-            if (sceneElement.elementIndex < elements.size()) {
+            if (const Element* element = findElement(elements, sceneElement)) {
                 json j_scene_element;
-                j_scene_element["element_name"] = elements[sceneElement.elementIndex].name;
+                j_scene_element["element_name"] = element->name;
                 j_scene_element["start_time"] = sceneElement.startTime;
                 j_scene_element["end_time"] = sceneElement.endTime;
                 j_scene_elements.push_back(j_scene_element);
@@ -515,5 +474,5 @@ void ElementEditor::exportToJson() {
     std::ofstream file("elements_and_scenes.json");
     file << j_export.dump(4);
     file.close();
-    TraceLog(LOG_INFO, "Exported to elements_and_scenes.json");
+    LogInfo("Exported to elements_and_scenes.json");
 }
@@ -5,6 +5,7 @@
 #include "raygui.h"
 
 #include "Types.hpp"
+#include "ProjectObserver.hpp"
 #include "BasicUI.hpp"
 
 #include <vector>
@@ -14,15 +15,15 @@ class ElementEditor : BasicUI
 {
 public:
     ElementEditor();
-    ~ElementEditor();
     void update();
     void draw();
-    std::vector<Element>& getElements();
-    std::vector<Scene>& getScenes();
+    ElementMap& getElements();
+    SceneMap& getScenes();
+    void setObserver(ProjectObserver* observer) { this->observer = observer; }
 
 private:
-    std::vector<Element> elements;
-    std::vector<Scene> scenes; // Shared with SceneEditor
+    ElementMap elements;
+    SceneMap scenes; // Shared with SceneEditor
     int currentElementIndex;
     char nameBuffer[256];
     char textBuffer[1024];
@@ -38,12 +39,15 @@ private:
     bool isEditing;
     float elementScrollOffset;
     float imageScrollOffset;
+    ProjectObserver* observer = nullptr;
 
     void updateElementMode();
     void clearBuffers();
     void drawElementMode();
     void loadElementToUI();
     void saveElement();
+    void deleteElement();
+    void notifyChanged();
     void exportToJson();
 };
 
@@ -0,0 +1,202 @@
+#include "ExportManifest.hpp"
+#include "AssetBundle.hpp"
+#include "Log.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+
+bool statFile(const fs::path& path, uint64_t& size, long long& modTime) {
+    std::error_code ec;
+    size = fs::file_size(path, ec);
+    if (ec) return false;
+    auto writeTime = fs::last_write_time(path, ec);
+    if (ec) return false;
+    modTime = (long long)writeTime.time_since_epoch().count();
+    return true;
+}
+
+} // namespace
+
+ExportManifest::ExportManifest(const std::string& folderPath) : folderPath(folderPath) {
+    std::ifstream file(fs::path(folderPath) / FILE_NAME);
+    if (file.is_open()) {
+        previous = json::parse(file, nullptr, false);
+        if (previous.is_discarded() || previous.value("version", 0) != 1) {
+            LogWarning("Ignoring unreadable export manifest in %s", folderPath.c_str());
+            previous = json::object();
+        }
+    }
+    current = {{"version", 1}, {"files", json::object()}, {"steps", json::object()}, {"sources", json::object()}};
+}
+
+std::string ExportManifest::describeSource(const std::string& path) {
+    std::error_code ec;
+    fs::path canonical = fs::weakly_canonical(path, ec);
+    uint64_t size;
+    long long modTime;
+    if (ec || !statFile(canonical, size, modTime)) return "";
+    return canonical.string() + "|" + std::to_string(size) + "|" + std::to_string(modTime);
+}
+
+bool ExportManifest::checkFresh(const std::string& name, const std::string& source, json& record) {
+    if (used.count(name) > 0) {
+        // Already written or kept by this export
+        const json& files = current["files"];
+        return files.contains(name) && files[name].value("source", "") == source;
+    }
+    if (!previous.contains("files") || !previous["files"].contains(name)) return false;
+    record = previous["files"][name];
+    if (record.value("source", "") != source) return false;
+
+    uint64_t size;
+    long long modTime;
+    if (!statFile(fs::path(folderPath) / name, size, modTime) || size != record.value("size", (uint64_t)0)) return false;
+    if (modTime != record.value("mtime", 0LL)) {
+        // Touched but maybe not changed; the hash decides
+        if (toHex(hashFile((fs::path(folderPath) / name).string())) != record.value("hash", "")) return false;
+        record["mtime"] = modTime;
+    }
+    return true;
+}
+
+void ExportManifest::keep(const std::string& name, const json& record) {
+    if (!used.insert(name).second) return;
+    current["files"][name] = record;
+    stats.filesSkipped++;
+    stats.bytesSkipped += record.value("size", (uint64_t)0);
+}
+
+bool ExportManifest::isFresh(const std::string& name, const std::string& source) {
+    json record;
+    if (!checkFresh(name, source, record)) return false;
+    if (!record.is_null()) keep(name, record);
+    return true;
+}
+
+bool ExportManifest::copyFile(const std::string& src, const std::string& name) {
+    std::string source = describeSource(src);
+    if (source.empty()) {
+        LogWarning("Source file does not exist: %s", src.c_str());
+        return false;
+    }
+    if (isFresh(name, source)) return true;
+
+    try {
+        fs::path dst = fs::path(folderPath) / name;
+        fs::create_directories(dst.parent_path());
+        fs::copy_file(src, dst, fs::copy_options::overwrite_existing);
+    } catch (const fs::filesystem_error& e) {
+        LogWarning("Failed to copy %s: %s", src.c_str(), e.what());
+        return false;
+    }
+    recordWritten(name, source);
+    return true;
+}
+
+void ExportManifest::recordWritten(const std::string& name, const std::string& source) {
+    fs::path path = fs::path(folderPath) / name;
+    uint64_t size;
+    long long modTime;
+    if (!statFile(path, size, modTime)) return;
+    current["files"][name] = {{"size", size}, {"mtime", modTime}, {"hash", toHex(hashFile(path.string()))}, {"source", source}};
+    if (used.insert(name).second) {
+        stats.filesWritten++;
+        stats.bytesWritten += size;
+    }
+}
+
+uint64_t ExportManifest::getHash(const std::string& name) const {
+    const json& files = current["files"];
+    if (!files.contains(name)) return 0;
+    return std::stoull(files[name].value("hash", "0"), nullptr, 16);
+}
+
+bool ExportManifest::findStep(const std::string& step, const std::string& source, json& result) {
+    if (!previous.contains("steps") || !previous["steps"].contains(step)) return false;
+    const json& record = previous["steps"][step];
+    if (record.value("source", "") != source) return false;
+
+    // Check every output before keeping any, so a half-stale step is redone whole.
+    // The step's inputs are unchanged, so its outputs only need to be intact; they
+    // may have been recorded by another step that produced the same file.
+    std::vector<std::pair<std::string, json>> outputs;
+    for (const auto& output : record.value("outputs", json::array())) {
+        const std::string name = output.get<std::string>();
+        const json& files = used.count(name) > 0 ? current["files"] : previous["files"];
+        if (!files.contains(name)) return false;
+        json fileRecord;
+        if (!checkFresh(name, files[name].value("source", ""), fileRecord)) return false;
+        outputs.emplace_back(name, fileRecord);
+    }
+    for (const auto& [name, fileRecord] : outputs) {
+        if (!fileRecord.is_null()) keep(name, fileRecord);
+    }
+    current["steps"][step] = record;
+    result = record.value("result", json());
+    return true;
+}
+
+void ExportManifest::recordStep(const std::string& step, const std::string& source,
+                                const std::vector<std::string>& outputs, const json& result) {
+    current["steps"][step] = {{"source", source}, {"outputs", outputs}, {"result", result}};
+}
+
+ExportStats ExportManifest::finish() {
+    if (previous.contains("files")) {
+        for (const auto& [name, record] : previous["files"].items()) {
+            if (used.count(name) > 0) continue;
+            fs::path relative = fs::path(name).lexically_normal();
+            if (relative.is_absolute() || relative.empty() || *relative.begin() == "..") continue; // Never outside the folder
+            std::error_code ec;
+            if (fs::remove(fs::path(folderPath) / relative, ec)) {
+                stats.filesRemoved++;
+                LogInfo("Removed orphaned export output: %s", name.c_str());
+            }
+        }
+    }
+
+    std::ofstream file(fs::path(folderPath) / FILE_NAME);
+    if (file.is_open()) {
+        file << current.dump(2);
+    } else {
+        LogWarning("Failed to write export manifest in %s", folderPath.c_str());
+    }
+
+    LogInfo("Export to %s: %zu file(s) written (%llu bytes), %zu unchanged (%llu bytes skipped), %zu removed",
+             folderPath.c_str(), stats.filesWritten, (unsigned long long)stats.bytesWritten,
+             stats.filesSkipped, (unsigned long long)stats.bytesSkipped, stats.filesRemoved);
+    return stats;
+}
+
+uint64_t ExportManifest::hashSource(const std::string& path) {
+    std::string source = describeSource(path);
+    if (source.empty()) return 0;
+    json& sources = current["sources"];
+    if (!sources.contains(source)) {
+        bool cached = previous.contains("sources") && previous["sources"].contains(source);
+        sources[source] = cached ? previous["sources"][source].get<std::string>() : toHex(hashFile(path));
+    }
+    return std::stoull(sources[source].get<std::string>(), nullptr, 16);
+}
+
+std::string ExportManifest::toHex(uint64_t hash) {
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long)hash);
+    return buffer;
+}
+
+uint64_t ExportManifest::hashFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::vector<char> buffer(1 << 20);
+    uint64_t hash = AssetBundle::HASH_SEED;
+    while (file) {
+        file.read(buffer.data(), buffer.size());
+        hash = AssetBundle::hash(buffer.data(), (size_t)file.gcount(), hash);
+    }
+    return hash;
+}
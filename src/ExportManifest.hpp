@@ -0,0 +1,82 @@
+#ifndef EXPORT_MANIFEST_HPP
+#define EXPORT_MANIFEST_HPP
+
+#include "json.hpp"
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+// What an export did, for the caller to report
+struct ExportStats
+{
+    size_t filesWritten = 0;
+    size_t filesSkipped = 0;
+    size_t filesRemoved = 0;
+    uint64_t bytesWritten = 0;
+    uint64_t bytesSkipped = 0;
+};
+
+// Record of everything exportToFolder wrote into an output folder, kept there
+// as export-manifest.json so the next export only redoes stale work.
+//
+// Every output file is stored with its size, mtime, content hash and a
+// "source" string describing what it was produced from (source file path,
+// size and mtime, or the inputs of a bake step). An output is fresh when its
+// source string is unchanged and the file on disk still matches. Outputs of a
+// previous export that this one didn't write or keep are deleted by finish();
+// files the manifest never recorded are left alone.
+class ExportManifest
+{
+public:
+    static constexpr const char* FILE_NAME = "export-manifest.json";
+
+    explicit ExportManifest(const std::string& folderPath);
+
+    // "<canonical path>|<size>|<mtime>" of a source file, empty if it is missing
+    static std::string describeSource(const std::string& path);
+
+    // Copies src to name (relative to the folder) unless the existing copy is fresh
+    bool copyFile(const std::string& src, const std::string& name);
+
+    // True (and the output is kept) if name was produced from source and is unchanged
+    bool isFresh(const std::string& name, const std::string& source);
+
+    // Records a file just written to name from source
+    void recordWritten(const std::string& name, const std::string& source);
+
+    // Content hash of a recorded output, 0 if unknown
+    uint64_t getHash(const std::string& name) const;
+
+    // True once this export has written or kept name
+    bool isUsed(const std::string& name) const { return used.count(name) > 0; }
+
+    // Content hash of a source file, 0 if it is missing. Cached by path, size
+    // and mtime, so unchanged sources are only read by the first export.
+    uint64_t hashSource(const std::string& path);
+
+    // Multi-output steps (atlas packing, baking): the stored result is returned
+    // when the step's inputs are unchanged and all of its outputs are fresh
+    bool findStep(const std::string& step, const std::string& source, nlohmann::json& result);
+    void recordStep(const std::string& step, const std::string& source,
+                    const std::vector<std::string>& outputs, const nlohmann::json& result);
+
+    // Deletes orphaned outputs, saves the manifest and returns the totals
+    ExportStats finish();
+
+    static uint64_t hashFile(const std::string& path);
+    static std::string toHex(uint64_t hash);
+
+private:
+    bool checkFresh(const std::string& name, const std::string& source, nlohmann::json& record);
+    void keep(const std::string& name, const nlohmann::json& record);
+
+    std::string folderPath;
+    nlohmann::json previous; // Manifest of the last export
+    nlohmann::json current;  // Being built by this export
+    std::set<std::string> used;
+    ExportStats stats;
+};
+
+#endif // EXPORT_MANIFEST_HPP
@@ -0,0 +1,130 @@
+#include "FileWatcher.hpp"
+#include "raylib.h"
+#include "Log.hpp"
+#include <filesystem>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#include <chrono>
+#endif
+
+FileWatcher::FileWatcher() : stopping(false) {
+#ifdef __linux__
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (inotifyFd < 0 || wakeFd < 0) {
+        LogWarning("File watcher unavailable: inotify could not be initialized");
+        return;
+    }
+#endif
+    thread = std::thread(&FileWatcher::run, this);
+}
+
+FileWatcher::~FileWatcher() {
+    stopping = true;
+#ifdef __linux__
+    if (wakeFd >= 0) {
+        uint64_t one = 1;
+        if (write(wakeFd, &one, sizeof(one)) < 0) {
+            // Nothing else to do; the thread still wakes on the next inotify event
+        }
+    }
+#endif
+    if (thread.joinable()) thread.join();
+#ifdef __linux__
+    if (inotifyFd >= 0) close(inotifyFd);
+    if (wakeFd >= 0) close(wakeFd);
+#endif
+}
+
+void FileWatcher::watch(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!directories.insert(directory).second) return;
+#ifdef __linux__
+    if (inotifyFd < 0) return;
+    // Editors usually save through a temp file + rename, hence MOVED_TO
+    int wd = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd < 0) {
+        LogWarning("Failed to watch directory: %s", directory.c_str());
+        return;
+    }
+    watchDirectories[wd] = directory;
+#endif
+    LogInfo("Watching directory for changes: %s", directory.c_str());
+}
+
+bool FileWatcher::poll(std::vector<std::string>& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (changed.empty()) return false;
+    out.insert(out.end(), changed.begin(), changed.end());
+    changed.clear();
+    return true;
+}
+
+#ifdef __linux__
+
+void FileWatcher::run() {
+    alignas(struct inotify_event) char buffer[16 * 1024];
+    while (!stopping) {
+        struct pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+        if (::poll(fds, 2, -1) < 0) continue; // EINTR
+        if (stopping) break;
+
+        ssize_t length;
+        while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (char* p = buffer; p < buffer + length;) {
+                auto* event = (struct inotify_event*)p;
+                p += sizeof(struct inotify_event) + event->len;
+                auto it = watchDirectories.find(event->wd);
+                if (it == watchDirectories.end() || event->len == 0) continue;
+                changed.insert((std::filesystem::path(it->second) / event->name).string());
+            }
+        }
+    }
+}
+
+#else
+
+void FileWatcher::run() {
+    namespace fs = std::filesystem;
+    std::set<std::string> scanned;
+    while (!stopping) {
+        std::set<std::string> dirs;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            dirs = directories;
+        }
+        for (const auto& dir : dirs) {
+            // The first scan of a directory is a baseline, not a change
+            bool baseline = scanned.insert(dir).second;
+            std::error_code ec;
+            for (const auto& entry : fs::directory_iterator(dir, ec)) {
+                if (!entry.is_regular_file(ec)) continue;
+                long long modTime = (long long)entry.last_write_time(ec).time_since_epoch().count();
+                std::string path = (fs::path(dir) / entry.path().filename()).string();
+                auto seen = snapshot.find(path);
+                if (seen == snapshot.end()) {
+                    snapshot[path] = modTime;
+                    if (!baseline) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        changed.insert(path);
+                    }
+                } else if (seen->second != modTime) {
+                    seen->second = modTime;
+                    std::lock_guard<std::mutex> lock(mutex);
+                    changed.insert(path);
+                }
+            }
+        }
+        for (int i = 0; i < 10 && !stopping; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+}
+
+#endif
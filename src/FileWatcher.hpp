@@ -0,0 +1,49 @@
+#ifndef FILE_WATCHER_HPP
+#define FILE_WATCHER_HPP
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Watches directories on a background thread and queues the paths of files
+// that were written or moved into them. On Linux this is inotify (blocking
+// until something happens); elsewhere the thread rescans the watched
+// directories' mtimes once a second. The main thread drains the queue with
+// poll(); paths are the directory as passed to watch() joined with the file name.
+class FileWatcher
+{
+public:
+    FileWatcher();
+    ~FileWatcher();
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Adding a directory that is already watched is a no-op
+    void watch(const std::string& directory);
+
+    // Moves the changed paths queued since the last call into out (each path
+    // once, however many events it produced); returns false if there were none
+    bool poll(std::vector<std::string>& out);
+
+private:
+    void run();
+
+    std::mutex mutex;
+    std::set<std::string> directories;
+    std::set<std::string> changed;
+    std::atomic<bool> stopping;
+    std::thread thread;
+#ifdef __linux__
+    int inotifyFd = -1;
+    int wakeFd = -1;                              // eventfd that interrupts the blocking poll() on shutdown
+    std::map<int, std::string> watchDirectories;  // inotify watch descriptor -> directory
+#else
+    std::map<std::string, long long> snapshot;    // file path -> last seen mtime
+#endif
+};
+
+#endif // FILE_WATCHER_HPP
@@ -0,0 +1,33 @@
+#ifndef GRAPHICS_BACKEND_HPP
+#define GRAPHICS_BACKEND_HPP
+
+#include "TextureHandle.hpp"
+
+#include <memory>
+#include <string>
+
+// What the core needs from the program that draws the project: textures for
+// the images elements reference, and the window size backgrounds are chosen
+// for. The editor and renderer install one at startup (see RaylibBackend);
+// without one, as in headless tools, textures are skipped and every handle
+// stays empty.
+class GraphicsBackend
+{
+public:
+    virtual ~GraphicsBackend() = default;
+
+    virtual TextureHandle acquireTexture(const std::string& path) = 0;
+    // Called by TextureHandle::touch() for the handle's entry
+    virtual void touchTexture(const std::shared_ptr<TextureEntry>& entry) = 0;
+    virtual int getScreenWidth() const = 0;
+    virtual int getScreenHeight() const = 0;
+
+    static GraphicsBackend* get() { return current; }
+    // The backend must outlive every use of the core; nullptr uninstalls it
+    static void set(GraphicsBackend* backend) { current = backend; }
+
+private:
+    inline static GraphicsBackend* current = nullptr;
+};
+
+#endif // GRAPHICS_BACKEND_HPP
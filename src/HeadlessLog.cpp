@@ -0,0 +1,45 @@
+// TraceLog for NOVEL_HEADLESS builds, formatted like raylib's own so logs
+// from the core read the same with or without a window
+#ifdef NOVEL_HEADLESS
+
+#include "RaylibTypes.hpp"
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+int minimumLevel = LOG_INFO;
+
+} // namespace
+
+void TraceLog(int logLevel, const char* text, ...) {
+    if (logLevel < minimumLevel) return;
+
+    const char* prefix = "";
+    switch (logLevel) {
+    case LOG_TRACE: prefix = "TRACE: "; break;
+    case LOG_DEBUG: prefix = "DEBUG: "; break;
+    case LOG_INFO: prefix = "INFO: "; break;
+    case LOG_WARNING: prefix = "WARNING: "; break;
+    case LOG_ERROR: prefix = "ERROR: "; break;
+    case LOG_FATAL: prefix = "FATAL: "; break;
+    default: break;
+    }
+
+    FILE* out = logLevel >= LOG_WARNING ? stderr : stdout;
+    va_list args;
+    va_start(args, text);
+    std::fputs(prefix, out);
+    std::vfprintf(out, text, args);
+    std::fputc('\n', out);
+    va_end(args);
+
+    if (logLevel == LOG_FATAL) std::exit(EXIT_FAILURE);
+}
+
+void SetTraceLogLevel(int logLevel) {
+    minimumLevel = logLevel;
+}
+
+#endif // NOVEL_HEADLESS
@@ -0,0 +1,90 @@
+#include "ImageLoader.hpp"
+#include "TextureCache.hpp"
+#include "AssetBundle.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+
+ImageLoader::ImageLoader(unsigned int threadCount) : inFlight(0), stopping(false) {
+    if (threadCount == 0) {
+        // Leave one core for the main (render) thread
+        unsigned int cores = std::thread::hardware_concurrency();
+        threadCount = cores > 1 ? cores - 1 : 1;
+    }
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&ImageLoader::workerLoop, this);
+    }
+}
+
+ImageLoader::~ImageLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    jobAvailable.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+    for (auto& result : results) {
+        if (result.image.data != nullptr) UnloadImage(result.image);
+    }
+}
+
+void ImageLoader::submit(const std::string& path, std::weak_ptr<TextureEntry> entry,
+                         std::shared_ptr<const AssetBundle> bundle) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back({path, std::move(entry), std::move(bundle)});
+    }
+    jobAvailable.notify_one();
+}
+
+bool ImageLoader::poll(std::vector<Result>& out, size_t maxCount) {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t count = std::min(maxCount, results.size());
+    for (size_t i = 0; i < count; ++i) {
+        out.push_back(results.front());
+        results.pop_front();
+    }
+    return count > 0;
+}
+
+size_t ImageLoader::getPendingCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return jobs.size() + inFlight + results.size();
+}
+
+void ImageLoader::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            ++inFlight;
+        }
+
+        Image image = {0};
+        // Skip files nobody holds a handle to anymore
+        if (!job.entry.expired()) {
+            PROFILE_ZONE("Decode image");
+            size_t size = 0;
+            const unsigned char* data = job.bundle ? job.bundle->find(job.path, size) : nullptr;
+            if (data != nullptr) {
+                image = LoadImageFromMemory(GetFileExtension(job.path.c_str()), data, (int)size);
+            } else {
+                image = LoadImage(job.path.c_str());
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        --inFlight;
+        if (job.entry.expired()) {
+            if (image.data != nullptr) UnloadImage(image);
+            continue;
+        }
+        results.push_back({std::move(job.entry), image});
+    }
+}
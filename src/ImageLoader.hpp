@@ -0,0 +1,62 @@
+#ifndef IMAGE_LOADER_HPP
+#define IMAGE_LOADER_HPP
+
+#include "raylib.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct TextureEntry;
+class AssetBundle;
+
+// Worker pool that decodes image files into CPU-side Image buffers off the
+// main thread. Decoded images are collected in a queue that the main thread
+// drains (see TextureCache::processUploads), because GPU uploads must happen
+// on the thread that owns the GL context.
+class ImageLoader
+{
+public:
+    struct Result
+    {
+        std::weak_ptr<TextureEntry> entry;
+        Image image;
+    };
+
+    explicit ImageLoader(unsigned int threadCount = 0);
+    ~ImageLoader();
+
+    // With a bundle, path names an asset inside it and is decoded straight
+    // from the mapping; the job keeps the bundle mapped until it finishes
+    void submit(const std::string& path, std::weak_ptr<TextureEntry> entry,
+                std::shared_ptr<const AssetBundle> bundle = nullptr);
+
+    // Moves up to maxCount decoded images into out; returns false if none were ready
+    bool poll(std::vector<Result>& out, size_t maxCount);
+
+    size_t getPendingCount();
+
+private:
+    struct Job
+    {
+        std::string path;
+        std::weak_ptr<TextureEntry> entry;
+        std::shared_ptr<const AssetBundle> bundle;
+    };
+
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::deque<Job> jobs;
+    std::deque<Result> results;
+    size_t inFlight;
+    bool stopping;
+};
+
+#endif // IMAGE_LOADER_HPP
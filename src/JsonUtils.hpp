@@ -1,11 +1,24 @@
 #ifndef JSON_UTILS_HPP
 #define JSON_UTILS_HPP
 
-#include "Types.hpp"
+#include "ProjectJson.hpp"
+#include "AtlasBuilder.hpp"
+#include "BlockCompressor.hpp"
+#include "AssetBundle.hpp"
+#include "ExportManifest.hpp"
+#include "ProjectBinary.hpp"
+#include "JsonWriter.hpp"
+#include "Log.hpp"
 #include <fstream>
+#include <functional>
+#include <map>
+#include <set>
 #include <stdexcept>
 #include <filesystem>
 #include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
 
 #ifdef _WIN32
 #define RENDERNAME "renderer.exe"
@@ -14,605 +27,696 @@
 #endif
 namespace JsonUtils
 {
-    namespace fs = std::filesystem;
+    // Settings for exportToFolder
+    struct ExportOptions
+    {
+        bool packAtlases = true;  // Pack each character's poses into shared atlas pages
+        int atlasPageSize = 4096; // Max page edge; larger poses ship as standalone images
+        bool bakeImages = true;   // Shrink images to the size they are drawn at
+        std::vector<BakeTarget> bakeTargets = {{1000, 600}, {1920, 1080}}; // Window sizes backgrounds are baked for
+        bool compressTextures = false; // Also write a DXT-compressed .dds next to every shipped image
+        bool writeBundle = false;      // Also pack everything the renderer loads into one AssetBundle
+        JsonWriter::Style jsonStyle = JsonWriter::Style::COMPACT; // INDENTED makes project.json diffable
+    };
+
+    // Where a character pose ended up in the export folder
+    struct ExportedPose
+    {
+        std::string fileName;
+        Rectangle rect;     // Region inside fileName, zero width = whole file
+        Vector2 sourceSize; // Size before baking, zero = stored at its original size
+    };
+
+    // (element index, image index) -> exported pose; poses not listed are copied as-is
+    using ExportedPoses = std::map<std::pair<size_t, size_t>, ExportedPose>;
 
-    // Helper to convert Color to JSON
-    json colorToJson(const Color& color)
+    // Background element index -> variants, smallest target first
+    using BackgroundVariants = std::map<size_t, std::vector<BackgroundVariant>>;
+
+    // Load an image for re-encoding at export. Sources that are themselves
+    // exported .dds files are decoded back to RGBA8 so they can be cropped/resized.
+    Image loadSourceImage(const std::string& path)
     {
-        json j;
-        j["r"] = color.r;
-        j["g"] = color.g;
-        j["b"] = color.b;
-        j["a"] = color.a;
-        return j;
+        Image image = LoadImage(path.c_str());
+        if (image.data != nullptr && image.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB)
+        {
+            Image decoded = BlockCompressor::decompress(image);
+            UnloadImage(image);
+            image = decoded;
+        }
+        return image;
     }
 
-    // Helper to convert JSON to Color
-    Color jsonToColor(const json& j)
+    // Block-compressed textures are uploaded in whole 4x4 blocks, so baked
+    // sizes are rounded up to a multiple of 4
+    int alignToBlock(int size)
     {
-        return CLITERAL(Color){
-            static_cast<unsigned char>(j.value("r", 200)),
-            static_cast<unsigned char>(j.value("g", 200)),
-            static_cast<unsigned char>(j.value("b", 200)),
-            static_cast<unsigned char>(j.value("a", 255))
-        };
+        return (size + 3) & ~3;
     }
 
-    // Export Element to JSON
-    json elementToJson(const Element& element)
+    // Collision-safe output name for a source image: its content hash plus the
+    // original extension. Identical files referenced from several paths ship
+    // once, and different files that share a name no longer overwrite each other.
+    std::string exportedName(const std::string& path, ExportManifest& manifest)
     {
-        json j;
-        j["type"] = static_cast<int>(element.type);
-        j["name"] = element.name;
+        uint64_t hash = manifest.hashSource(path);
+        if (hash == 0) return fs::path(path).filename().string(); // Missing; the copy will warn
+        std::string extension = fs::path(path).extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+        return ExportManifest::toHex(hash) + extension;
+    }
 
-        switch (element.type)
+    // Load pose i of a character the way it is exported: cut out of its atlas page if it
+    // already is an atlas region and, with bake, shrunk to the size Render draws it at.
+    // sourceSize receives the size the pose had before any baking.
+    Image loadPoseImage(const CharacterElement& character, size_t i, bool bake, Vector2& sourceSize)
+    {
+        const std::string& path = character.images[i].second;
+        Image image = loadSourceImage(path);
+        if (image.data == nullptr)
         {
-            case ElementType::TEXT:
+            LogWarning("Failed to load pose image: %s", path.c_str());
+            return image;
+        }
+        if (i < character.atlasRects.size() && character.atlasRects[i].width > 0)
+        {
+            // Already on an atlas page from a previous export; cut the pose back out
+            Image pose = ImageFromImage(image, character.atlasRects[i]);
+            UnloadImage(image);
+            image = pose;
+        }
+
+        // A pose baked by a previous export remembers its original size
+        bool wasBaked = i < character.sourceSizes.size() && character.sourceSizes[i].x > 0;
+        sourceSize = wasBaked ? character.sourceSizes[i] : Vector2{(float)image.width, (float)image.height};
+        if (bake)
+        {
+            int width = alignToBlock((int)std::ceil(sourceSize.x * CHARACTER_DRAW_SCALE));
+            int height = alignToBlock((int)std::ceil(sourceSize.y * CHARACTER_DRAW_SCALE));
+            if (width < image.width && height < image.height)
             {
-                auto& text = std::get<TextElement>(element.data);
-                j["data"]["content"] = text.content;
-                break;
+                ImageResize(&image, width, height);
             }
-            case ElementType::CHARACTER:
+        }
+        return image;
+    }
+
+    // Write every character pose that can't simply be copied: poses are baked down to
+    // their drawn size and all poses of a character are packed into atlas page PNGs
+    // so it draws from one texture instead of one per pose
+    // Results are cached in the manifest, keyed by the pose files and options rather than
+    // the element's position, and pages are named after their pixels, so reordering or
+    // deleting characters neither repacks nor renames the pages of the others.
+    void exportCharacterPoses(const ElementMap& elements, const std::string& folderPath, const ExportOptions& options, ExportedPoses& exported,
+                              ExportManifest& manifest)
+    {
+        if (!options.packAtlases && !options.bakeImages) return; // Plain copies, nothing to decode
+
+        for (size_t e = 0; e < elements.size(); ++e)
+        {
+            if (!elements.isAlive(e) || elements[e].type != ElementType::CHARACTER) continue;
+            const auto& character = std::get<CharacterElement>(elements[e].data);
+
+            // One slot per distinct image: poses sharing file contents share a slot, atlas regions never do
+            std::vector<size_t> poseSlot(character.images.size(), SIZE_MAX);
+            std::vector<size_t> slotPose;
+            std::map<std::string, size_t> slotByContent;
+            for (size_t i = 0; i < character.images.size(); ++i)
             {
-                auto& character = std::get<CharacterElement>(element.data);
-                j["data"]["name"] = character.name;
-                j["data"]["positionIndex"] = character.positionIndex;
-                j["data"]["images"] = json::array();
-                for (const auto& [pose, path] : character.images)
+                const std::string& path = character.images[i].second;
+                if (path.empty()) continue;
+                bool hasRect = i < character.atlasRects.size() && character.atlasRects[i].width > 0;
+                std::string content = exportedName(path, manifest);
+                auto found = slotByContent.find(content);
+                if (!hasRect && found != slotByContent.end())
                 {
-                    json img;
-                    img["pose"] = pose;
-                    img["path"] = path;
-                    j["data"]["images"].push_back(img);
+                    poseSlot[i] = found->second;
+                    continue;
                 }
-                break;
+                poseSlot[i] = slotPose.size();
+                if (!hasRect) slotByContent[content] = slotPose.size();
+                slotPose.push_back(i);
             }
-            case ElementType::BACKGROUND:
+            bool pack = options.packAtlases && slotPose.size() >= 2; // A single pose gains nothing from a page
+
+            // Everything the step's output depends on
+            std::string source = "pack=" + std::to_string(pack) + "|page=" + std::to_string(options.atlasPageSize) +
+                                 "|bake=" + std::to_string(options.bakeImages) + "|scale=" + std::to_string(CHARACTER_DRAW_SCALE);
+            for (size_t i = 0; i < character.images.size(); ++i)
             {
-                auto& background = std::get<BackgroundElement>(element.data);
-                j["data"]["imagePath"] = background.imagePath;
-                break;
+                source += "|" + std::to_string(i) + ":" + ExportManifest::describeSource(character.images[i].second);
+                if (i < character.atlasRects.size()) source += ":" + rectangleToJson(character.atlasRects[i]).dump();
+                if (i < character.sourceSizes.size()) source += ":" + std::to_string(character.sourceSizes[i].x) + "x" + std::to_string(character.sourceSizes[i].y);
             }
-        }
-        return j;
-    }
+            std::string step = "poses:" + ExportManifest::toHex(AssetBundle::hash(source.data(), source.size()));
+            json cached;
+            if (manifest.findStep(step, source, cached))
+            {
+                for (const auto& pose : cached)
+                {
+                    exported[{e, pose.value("pose", (size_t)0)}] = {
+                        pose.value("file", ""),
+                        jsonToRectangle(pose["rect"]),
+                        {pose.value("sourceWidth", 0.0f), pose.value("sourceHeight", 0.0f)}
+                    };
+                }
+                continue;
+            }
+            std::vector<std::string> outputs;
+            json result = json::array();
 
-    // Import Element from JSON
-    Element jsonToElement(const json& j)
-    {
-        Element element;
-        element.type = static_cast<ElementType>(j.value("type", 0));
-        element.name = j.value("name", "New Element");
+            AtlasBuilder builder(options.atlasPageSize);
+            std::vector<Vector2> slotSourceSize(slotPose.size());
+            for (size_t s = 0; s < slotPose.size(); ++s)
+            {
+                builder.add(loadPoseImage(character, slotPose[s], options.bakeImages, slotSourceSize[s]));
+            }
 
-        if (j.contains("data"))
-        {
-            switch (element.type)
+            std::vector<AtlasPlacement> placements(slotPose.size(), {-1, {0, 0, 0, 0}});
+            std::vector<std::string> pageNames;
+            if (pack)
             {
-                case ElementType::TEXT:
+                std::vector<Image> pages = builder.build(placements);
+                for (size_t p = 0; p < pages.size(); ++p)
                 {
-                    TextElement text;
-                    text.content = j["data"].value("content", "");
-                    element.data = text;
-                    break;
+                    // Same pixels, same name: an unchanged page is kept rather than rewritten
+                    uint64_t hash = AssetBundle::hash(pages[p].data, GetPixelDataSize(pages[p].width, pages[p].height, pages[p].format));
+                    std::string pageName = ExportManifest::toHex(hash) + "_" + std::to_string(pages[p].width) + "x" + std::to_string(pages[p].height) + ".png";
+                    if (!manifest.isUsed(pageName) && !manifest.isFresh(pageName, source))
+                    {
+                        fs::path pagePath = fs::path(folderPath) / pageName;
+                        if (ExportImage(pages[p], pagePath.string().c_str()))
+                        {
+                            manifest.recordWritten(pageName, source);
+                        }
+                        else
+                        {
+                            LogWarning("Failed to write atlas page: %s", pagePath.string().c_str());
+                            pageName.clear();
+                        }
+                    }
+                    if (!pageName.empty()) outputs.push_back(pageName);
+                    pageNames.push_back(pageName);
+                    UnloadImage(pages[p]);
                 }
-                case ElementType::CHARACTER:
+                LogInfo("Packed %zu poses of character '%s' into %zu atlas page(s)",
+                         slotPose.size(), character.name.c_str(), pages.size());
+            }
+
+            for (size_t s = 0; s < slotPose.size(); ++s)
+            {
+                size_t i = slotPose[s];
+                const Image& image = builder.getImage(s);
+                if (image.data == nullptr) continue;
+
+                ExportedPose pose = {"", {0, 0, 0, 0}, {0, 0}};
+                if (image.width != (int)slotSourceSize[s].x || image.height != (int)slotSourceSize[s].y)
+                {
+                    pose.sourceSize = slotSourceSize[s];
+                }
+                bool hasRect = i < character.atlasRects.size() && character.atlasRects[i].width > 0;
+                const AtlasPlacement& placement = placements[s];
+                if (placement.page >= 0 && !pageNames[placement.page].empty())
+                {
+                    pose.fileName = pageNames[placement.page];
+                    pose.rect = placement.rect;
+                }
+                else if (pose.sourceSize.x > 0 || hasRect)
                 {
-                    CharacterElement character;
-                    character.name = j["data"].value("name", "");
-                    character.positionIndex = j["data"].value("positionIndex", 0);
-                    if (j["data"].contains("images"))
+                    // Baked or cut out of an old page, so it no longer matches any source file.
+                    // Named after the source content (and region) so characters sharing it share the file.
+                    uint64_t hash = manifest.hashSource(character.images[i].second);
+                    if (hasRect)
+                    {
+                        std::string region = rectangleToJson(character.atlasRects[i]).dump();
+                        hash = AssetBundle::hash(region.data(), region.size(), hash);
+                    }
+                    std::string poseName = ExportManifest::toHex(hash) + "_" + std::to_string(image.width) + "x" + std::to_string(image.height) + ".png";
+                    if (!manifest.isUsed(poseName))
                     {
-                        for (const auto& img : j["data"]["images"])
+                        fs::path posePath = fs::path(folderPath) / poseName;
+                        if (!ExportImage(image, posePath.string().c_str()))
                         {
-                            character.images.emplace_back(
-                                img.value("pose", ""),
-                                img.value("path", "")
-                            );
+                            LogWarning("Failed to write pose image: %s", posePath.string().c_str());
+                            continue;
                         }
+                        manifest.recordWritten(poseName, source);
                     }
-                    element.data = character;
-                    break;
+                    outputs.push_back(poseName);
+                    pose.fileName = poseName;
                 }
-                case ElementType::BACKGROUND:
+                else
                 {
-                    BackgroundElement background;
-                    background.imagePath = j["data"].value("imagePath", "");
-                    element.data = background;
-                    break;
+                    continue; // Unchanged, copied as-is
+                }
+                for (size_t p = 0; p < poseSlot.size(); ++p)
+                {
+                    if (poseSlot[p] != s) continue;
+                    exported[{e, p}] = pose;
+                    result.push_back({{"pose", p}, {"file", pose.fileName}, {"rect", rectangleToJson(pose.rect)},
+                                      {"sourceWidth", pose.sourceSize.x}, {"sourceHeight", pose.sourceSize.y}});
                 }
             }
+            manifest.recordStep(step, source, outputs, result);
         }
-        else
-        {
-            element.data = TextElement{""};
-        }
-        return element;
     }
 
-    // Export Scene to JSON
-    json sceneToJson(const Scene& scene)
+    // Bake a copy of every background for each target window size. Render scales
+    // backgrounds to cover the window, so the baked size is the smallest size that
+    // still covers the target. Targets the image is already small enough for use the
+    // original file (fileName is then the source file name).
+    void bakeBackgroundVariants(const ElementMap& elements, const std::string& folderPath, std::vector<BakeTarget> targets, BackgroundVariants& variants,
+                                ExportManifest& manifest)
     {
-        json j;
-        j["name"] = scene.name;
-        j["elements"] = json::array();
-        for (const auto& sceneElement : scene.elements)
+        std::sort(targets.begin(), targets.end(),
+                  [](const BakeTarget& a, const BakeTarget& b) { return a.width * a.height < b.width * b.height; });
+        std::string targetList;
+        for (const auto& target : targets)
         {
-            json se;
-            se["elementIndex"] = sceneElement.elementIndex;
-            se["startTime"] = sceneElement.startTime;
-            se["endTime"] = sceneElement.endTime;
-            se["renderlevel"] = sceneElement.renderlevel;
-            se["selectedPose"] = sceneElement.selectedPose;
-            j["elements"].push_back(se);
+            targetList += std::to_string(target.width) + "x" + std::to_string(target.height) + ",";
         }
-        return j;
-    }
 
-    // Import Scene from JSON
-    Scene jsonToScene(const json& j)
-    {
-        Scene scene;
-        scene.name = j.value("name", "");
-        if (j.contains("elements"))
+        std::map<std::string, std::vector<BackgroundVariant>> bakedByContent; // Backgrounds with equal contents bake once
+        for (size_t e = 0; e < elements.size(); ++e)
         {
-            for (const auto& se : j["elements"])
+            if (!elements.isAlive(e) || elements[e].type != ElementType::BACKGROUND) continue;
+            const std::string& path = std::get<BackgroundElement>(elements[e].data).imagePath;
+            if (path.empty()) continue;
+            std::string originalName = exportedName(path, manifest);
+            auto found = bakedByContent.find(originalName);
+            if (found != bakedByContent.end())
             {
-                SceneElement sceneElement;
-                sceneElement.elementIndex = se.value("elementIndex", 0);
-                sceneElement.startTime = se.value("startTime", 0.0f);
-                sceneElement.endTime = se.value("endTime", 1.0f);
-                sceneElement.renderlevel = se.value("renderlevel", 0);
-                sceneElement.selectedPose = se.value("selectedPose", "");
-                scene.elements.push_back(sceneElement);
+                variants[e] = found->second;
+                continue;
             }
-        }
-        return scene;
-    }
 
-    // Export Node to JSON
-    json nodeToJson(const Node& node)
-    {
-        json j;
-        j["name"] = node.name;
-        j["sceneIndex"] = node.sceneIndex;
-        j["position"]["x"] = node.position.x;
-        j["position"]["y"] = node.position.y;
-        j["dragType"] = static_cast<int>(node.dragType);
-        j["color"] = colorToJson(node.color);
-        j["isStartNode"] = node.isStartNode;
-        j["connections"] = json::array();
-        for (const auto& conn : node.connections)
-        {
-            json c;
-            c["toNodeIndex"] = conn.toNodeIndex;
-            c["choiceText"] = conn.choiceText;
-            j["connections"].push_back(c);
-        }
-        return j;
-    }
+            std::string step = "background:" + originalName;
+            std::string source = "targets=" + targetList + "|" + ExportManifest::describeSource(path);
+            json cached;
+            if (manifest.findStep(step, source, cached))
+            {
+                std::vector<BackgroundVariant> baked;
+                for (const auto& v : cached)
+                {
+                    baked.push_back({{v.value("targetWidth", 0), v.value("targetHeight", 0)}, v.value("path", ""), v.value("width", 0), v.value("height", 0)});
+                }
+                bakedByContent[originalName] = baked;
+                variants[e] = baked;
+                continue;
+            }
+            std::vector<std::string> outputs;
+            json result = json::array();
 
-    // Import Node from JSON
-    Node jsonToNode(const json& j)
-    {
-        Node node;
-        node.name = j.value("name", "Node");
-        node.sceneIndex = j.value("sceneIndex", -1);
-        node.position.x = j["position"].value("x", 0.0f);
-        node.position.y = j["position"].value("y", 0.0f);
-        node.dragType = static_cast<DragType>(j.value("dragType", 0));
-        node.color = j.contains("color") ? jsonToColor(j["color"]) : CLITERAL(Color){200, 200, 200, 255};
-        node.isStartNode = j.value("isStartNode", false);
-        if (j.contains("connections"))
-        {
-            for (const auto& c : j["connections"])
+            Image image = loadSourceImage(path);
+            if (image.data == nullptr)
+            {
+                LogWarning("Failed to load background for baking: %s", path.c_str());
+                continue;
+            }
+            std::vector<BackgroundVariant> baked;
+            for (const auto& target : targets)
             {
-                NodeConnection conn;
-                conn.toNodeIndex = c.value("toNodeIndex", 0);
-                conn.choiceText = c.value("choiceText", "");
-                node.connections.push_back(conn);
+                float scale = std::max((float)target.width / image.width, (float)target.height / image.height);
+                BackgroundVariant variant = {target, originalName, image.width, image.height};
+                if (scale < 1.0f)
+                {
+                    variant.width = alignToBlock((int)std::ceil(image.width * scale));
+                    variant.height = alignToBlock((int)std::ceil(image.height * scale));
+                    variant.fileName = fs::path(originalName).stem().string() + "_" + std::to_string(variant.width) + "x" + std::to_string(variant.height) + ".png";
+                    Image resized = ImageCopy(image);
+                    ImageResize(&resized, variant.width, variant.height);
+                    fs::path variantPath = fs::path(folderPath) / variant.fileName;
+                    bool written = ExportImage(resized, variantPath.string().c_str());
+                    UnloadImage(resized);
+                    if (!written)
+                    {
+                        LogWarning("Failed to write background variant: %s", variantPath.string().c_str());
+                        continue;
+                    }
+                    manifest.recordWritten(variant.fileName, source);
+                    outputs.push_back(variant.fileName);
+                }
+                baked.push_back(variant);
+                result.push_back({{"targetWidth", target.width}, {"targetHeight", target.height}, {"path", variant.fileName},
+                                  {"width", variant.width}, {"height", variant.height}});
             }
+            UnloadImage(image);
+            manifest.recordStep(step, source, outputs, result);
+            LogInfo("Baked %zu variant(s) of background %s", baked.size(), path.c_str());
+            bakedByContent[originalName] = baked;
+            variants[e] = baked;
         }
-        return node;
     }
 
-    // Export all data to file
-    void exportToFile(const std::vector<Element>& elements, const std::vector<Scene>& scenes, const std::vector<Node>& nodes, const std::string& filename)
+    // Write a DXT-compressed .dds next to every shipped image; importFromFolder
+    // prefers it over the PNG, so the renderer skips decoding and keeps the
+    // texture compressed in VRAM. With compress == false stale .dds files from
+    // an earlier export are removed instead so they can't shadow new PNGs.
+    void writeCompressedTextures(const std::string& folderPath, const std::set<std::string>& fileNames, bool compress, ExportManifest& manifest)
     {
-        json j;
-        j["elements"] = json::array();
-        for (const auto& element : elements)
-        {
-            j["elements"].push_back(elementToJson(element));
-        }
-        j["scenes"] = json::array();
-        for (const auto& scene : scenes)
-        {
-            j["scenes"].push_back(sceneToJson(scene));
-        }
-        j["nodes"] = json::array();
-        for (const auto& node : nodes)
-        {
-            j["nodes"].push_back(nodeToJson(node));
-        }
-
-        std::ofstream file(filename);
-        if (!file.is_open())
+        for (const auto& fileName : fileNames)
         {
-            throw std::runtime_error("Failed to open file for writing: " + filename);
-        }
-        file << j.dump(4);
-        file.close();
-    }
-
-    // Export all data to a folder, copying images and saving JSON to project.json
-    void exportToFolder(const std::vector<Element>& elements, const std::vector<Scene>& scenes, const std::vector<Node>& nodes, const std::string& folderPath)
-    {
-
-
-
-
-
-
-        // Create the output directory if it doesn't exist
-        fs::create_directories(folderPath);
-
+            fs::path path = fs::path(folderPath) / fileName;
+            if (path.extension() == ".dds") continue; // Shipped already compressed
+            fs::path ddsPath = fs::path(path).replace_extension(".dds");
+            std::string ddsName = fs::path(fileName).replace_extension(".dds").generic_string();
+            std::error_code ec;
+            if (!compress)
+            {
+                fs::remove(ddsPath, ec);
+                continue;
+            }
+            // Derived from the shipped image, so unchanged as long as its content is
+            std::string source = "dds|" + std::to_string(manifest.getHash(fileName));
+            if (manifest.isFresh(ddsName, source)) continue;
 
-        try
-        {
-            fs::path exeDir = fs::current_path();
-            fs::path srcRenderer = exeDir / RENDERNAME;
-            fs::path dstRenderer = fs::path(folderPath) / RENDERNAME;
-            if (fs::exists(srcRenderer))
+            Image image = LoadImage(path.string().c_str());
+            if (image.data == nullptr)
             {
-                fs::copy_file(srcRenderer, dstRenderer, fs::copy_options::overwrite_existing);
+                LogWarning("Failed to load image for compression: %s", path.string().c_str());
+                continue;
             }
-            else
+            if (image.width % 4 != 0 || image.height % 4 != 0)
             {
-                TraceLog(LOG_WARNING, "Renderer binary does not exist: %s", srcRenderer.string().c_str());
+                // Unbaked originals can have any size; they ship as PNG only
+                LogInfo("Not compressing %s: %dx%d is not a multiple of 4", fileName.c_str(), image.width, image.height);
+                fs::remove(ddsPath, ec);
+                UnloadImage(image);
+                continue;
             }
-        }
-        catch (const fs::filesystem_error& e)
-        {
-            TraceLog(LOG_WARNING, "Failed to copy RENDERNAME: %s", e.what());
-        }
-
-        try
-        {
-            fs::path exeDir = fs::current_path();
-            fs::path srcFontDir = exeDir / "font";
-            fs::path dstFontDir = fs::path(folderPath) / "font";
-            if (fs::exists(srcFontDir))
+            Image compressed = BlockCompressor::compress(image);
+            if (BlockCompressor::exportDDS(compressed, ddsPath.string().c_str()))
             {
-                fs::create_directories(dstFontDir); // Ensure destination directory exists
-                fs::copy(srcFontDir, dstFontDir, fs::copy_options::recursive | fs::copy_options::overwrite_existing);
+                manifest.recordWritten(ddsName, source);
+                LogInfo("Compressed %s (%.1f dB PSNR)", fileName.c_str(), BlockCompressor::computePSNR(image, compressed));
             }
             else
             {
-                TraceLog(LOG_WARNING, "Font directory does not exist: %s", srcFontDir.string().c_str());
+                LogWarning("Failed to write compressed texture: %s", ddsPath.string().c_str());
             }
+            UnloadImage(compressed);
+            UnloadImage(image);
         }
-        catch (const fs::filesystem_error& e)
+    }
+
+    // Pack project.json, the fonts and every shipped image (plus .dds twins) from
+    // folderPath into a single AssetBundle the renderer maps at startup. The loose
+    // files stay so the folder can still be imported by the editor. Without
+    // bundling a stale bundle is removed, since the renderer would prefer it.
+    void writeAssetBundle(const std::string& folderPath, const std::set<std::string>& fileNames, bool enabled, ExportManifest& manifest)
+    {
+        fs::path bundlePath = fs::path(folderPath) / AssetBundle::DEFAULT_NAME;
+        if (!enabled)
         {
-            TraceLog(LOG_WARNING, "Failed to copy font directory: %s", e.what());
+            std::error_code ec;
+            fs::remove(bundlePath, ec);
+            return;
         }
 
-
-        // Collect all image paths to copy
-        std::vector<std::string> imagePaths;
-        for (const auto& element : elements)
+        // (entry name, file) pairs; fonts keep the relative name the renderer opens, e.g. "font/x.ttf"
+        std::vector<std::pair<std::string, fs::path>> contents;
+        contents.emplace_back("project.json", fs::path(folderPath) / "project.json");
+        contents.emplace_back(ProjectBinary::FILE_NAME, fs::path(folderPath) / ProjectBinary::FILE_NAME);
+        fs::path fontDir = fs::path(folderPath) / "font";
+        std::error_code ec;
+        if (fs::is_directory(fontDir, ec))
         {
-            if (element.type == ElementType::CHARACTER)
-            {
-                auto& character = std::get<CharacterElement>(element.data);
-                for (const auto& [pose, path] : character.images)
-                {
-                    if (!path.empty())
-                    {
-                        imagePaths.push_back(path);
-                    }
-                }
-            }
-            else if (element.type == ElementType::BACKGROUND)
+            for (const auto& entry : fs::recursive_directory_iterator(fontDir, ec))
             {
-                auto& background = std::get<BackgroundElement>(element.data);
-                if (!background.imagePath.empty())
-                {
-                    imagePaths.push_back(background.imagePath);
-                }
+                if (!entry.is_regular_file()) continue;
+                contents.emplace_back(fs::relative(entry.path(), folderPath).generic_string(), entry.path());
             }
         }
-
-        // Copy images to the output folder
-        for (const auto& srcPath : imagePaths)
+        for (const auto& fileName : fileNames)
         {
-            try
-            {
-                fs::path src = srcPath;
-                if (fs::exists(src))
-                {
-                    fs::path dst = fs::path(folderPath) / src.filename();
-                    fs::copy_file(src, dst, fs::copy_options::overwrite_existing);
-                }
-                else
-                {
-                    TraceLog(LOG_WARNING, "Image file does not exist: %s", srcPath.c_str());
-                }
-            }
-            catch (const fs::filesystem_error& e)
+            fs::path path = fs::path(folderPath) / fileName;
+            contents.emplace_back(fileName, path);
+            fs::path ddsPath = fs::path(path).replace_extension(".dds");
+            if (ddsPath != path && fs::exists(ddsPath, ec))
             {
-                TraceLog(LOG_WARNING, "Failed to copy image %s: %s", srcPath.c_str(), e.what());
+                contents.emplace_back(fs::path(fileName).replace_extension(".dds").generic_string(), ddsPath);
             }
         }
 
-        // Create JSON with updated relative paths
-        json j;
-        j["elements"] = json::array();
-        for (const auto& element : elements)
+        // The bundle only needs rebuilding when one of its inputs changed
+        std::string source = "bundle";
+        for (const auto& [name, path] : contents)
         {
-            json jElement = elementToJson(element);
-            if (element.type == ElementType::CHARACTER)
-            {
-                auto& character = std::get<CharacterElement>(element.data);
-                for (auto& img : jElement["data"]["images"])
-                {
-                    if (!img["path"].get<std::string>().empty())
-                    {
-                        img["path"] = fs::path(img["path"].get<std::string>()).filename().string();
-                    }
-                }
-            }
-            else if (element.type == ElementType::BACKGROUND)
-            {
-                if (!jElement["data"]["imagePath"].get<std::string>().empty())
-                {
-                    jElement["data"]["imagePath"] = fs::path(jElement["data"]["imagePath"].get<std::string>()).filename().string();
-                }
-            }
-            j["elements"].push_back(jElement);
+            source += "|" + name + ":" + std::to_string(manifest.getHash(name));
         }
-        j["scenes"] = json::array();
-        for (const auto& scene : scenes)
+        if (manifest.isFresh(AssetBundle::DEFAULT_NAME, source)) return;
+
+        AssetBundleWriter writer(bundlePath.string());
+        for (const auto& [name, path] : contents)
         {
-            j["scenes"].push_back(sceneToJson(scene));
+            writer.addFile(name, path.string());
         }
-        j["nodes"] = json::array();
-        for (const auto& node : nodes)
+        if (!writer.finish())
         {
-            j["nodes"].push_back(nodeToJson(node));
+            throw std::runtime_error("Failed to write asset bundle: " + bundlePath.string());
         }
+        manifest.recordWritten(AssetBundle::DEFAULT_NAME, source);
+    }
 
-        // Write JSON to project.json
-        fs::path outputFile = fs::path(folderPath) / "project.json";
-        std::ofstream file(outputFile);
+    // Write project.bin, the binary twin of the exported project.json that the
+    // renderer maps instead of parsing JSON. writer holds the same project and
+    // jsonSource identifies the JSON's content.
+    void writeProjectBinary(ProjectBinary::Writer& writer, const std::string& folderPath, const std::string& jsonSource, ExportManifest& manifest)
+    {
+        std::string source = jsonSource + "|binary v" + std::to_string(ProjectBinary::VERSION);
+        if (manifest.isFresh(ProjectBinary::FILE_NAME, source)) return;
+
+        std::string content = writer.finish();
+        fs::path outputFile = fs::path(folderPath) / ProjectBinary::FILE_NAME;
+        std::ofstream file(outputFile, std::ios::binary);
         if (!file.is_open())
         {
             throw std::runtime_error("Failed to open file for writing: " + outputFile.string());
         }
-        file << j.dump(4);
+        file.write(content.data(), content.size());
         file.close();
-
+        manifest.recordWritten(ProjectBinary::FILE_NAME, source);
     }
 
-    // Import all data from file and load textures
-    void importFromFile(std::vector<Element>& elements, std::vector<Scene>& scenes, std::vector<Node>& nodes, const std::string& filename)
+    // Copy of element e as it ships: image paths renamed to the exported files,
+    // written poses pointing at their atlas regions and backgrounds at their
+    // largest baked variant. Shipped file names are added to shippedImages.
+    Element exportedElement(const Element& element, size_t e, const ExportedPoses& exportedPoses, const BackgroundVariants& backgroundVariants,
+                            ExportManifest& manifest, std::set<std::string>& shippedImages)
     {
-        std::ifstream file(filename);
-        if (!file.is_open())
+        Element shipped = element;
+        if (element.type == ElementType::CHARACTER)
         {
-            throw std::runtime_error("Failed to open file for reading: " + filename);
-        }
-
-        json j;
-        file >> j;
-        file.close();
-
-        elements.clear();
-        if (j.contains("elements"))
-        {
-            for (const auto& je : j["elements"])
+            auto& character = std::get<CharacterElement>(shipped.data);
+            character.atlasRects.resize(character.images.size(), Rectangle{0, 0, 0, 0});
+            character.sourceSizes.resize(character.images.size(), Vector2{0, 0});
+            for (size_t i = 0; i < character.images.size(); ++i)
             {
-                elements.push_back(jsonToElement(je));
-            }
-        }
-
-        // Load textures for CharacterElement and BackgroundElement
-        for (auto& element : elements)
-        {
-            if (element.type == ElementType::CHARACTER)
-            {
-                auto& character = std::get<CharacterElement>(element.data);
-                character.textures.clear();
-                for (const auto& img : character.images)
+                std::string& path = character.images[i].second;
+                auto pose = exportedPoses.find({e, i});
+                if (pose != exportedPoses.end())
                 {
-                    if (!img.second.empty())
-                    {
-                        Image image = LoadImage(img.second.c_str());
-                        if (image.data != nullptr)
-                        {
-                            Texture2D texture = LoadTextureFromImage(image);
-                            character.textures.push_back(texture);
-                            UnloadImage(image);
-                        }
-                        else
-                        {
-                            TraceLog(LOG_WARNING, "Failed to load image: %s", img.second.c_str());
-                            character.textures.push_back({0});
-                        }
-                    }
-                    else
-                    {
-                        character.textures.push_back({0});
-                    }
+                    path = pose->second.fileName;
+                    character.atlasRects[i] = pose->second.rect;
+                    character.sourceSizes[i] = pose->second.sourceSize;
                 }
-            }
-            else if (element.type == ElementType::BACKGROUND)
-            {
-                auto& background = std::get<BackgroundElement>(element.data);
-                if (!background.imagePath.empty())
+                else if (!path.empty())
                 {
-                    Image image = LoadImage(background.imagePath.c_str());
-                    if (image.data != nullptr)
-                    {
-                        background.texture = LoadTextureFromImage(image);
-                        UnloadImage(image);
-                    }
-                    else
-                    {
-                        TraceLog(LOG_WARNING, "Failed to load image: %s", background.imagePath.c_str());
-                        background.texture = {0};
-                    }
+                    path = exportedName(path, manifest);
                 }
-                else
+                if (!path.empty())
                 {
-                    background.texture = {0};
+                    shippedImages.insert(path);
                 }
             }
         }
-
-        scenes.clear();
-        if (j.contains("scenes"))
+        else if (element.type == ElementType::BACKGROUND)
         {
-            for (const auto& js : j["scenes"])
+            auto& background = std::get<BackgroundElement>(shipped.data);
+            auto baked = backgroundVariants.find(e);
+            if (baked != backgroundVariants.end() && !baked->second.empty())
             {
-                scenes.push_back(jsonToScene(js));
+                // Variants are sorted by target size; the largest doubles as the
+                // default for readers that don't pick by window size
+                background.imagePath = baked->second.back().fileName;
+                for (const auto& variant : baked->second)
+                {
+                    shippedImages.insert(variant.fileName);
+                }
             }
-        }
-
-        nodes.clear();
-        if (j.contains("nodes"))
-        {
-            for (const auto& jn : j["nodes"])
+            else if (!background.imagePath.empty())
             {
-                nodes.push_back(jsonToNode(jn));
+                background.imagePath = exportedName(background.imagePath, manifest);
+                shippedImages.insert(background.imagePath);
             }
         }
+        return shipped;
     }
 
-    // Import all data from a folder, loading textures with full paths from project.json
-    void importFromFolder(std::vector<Element>& elements, std::vector<Scene>& scenes, std::vector<Node>& nodes, const std::string& folderPath)
+    // Export all data to a folder, copying images and saving JSON to project.json.
+    // Outputs are tracked in an ExportManifest, so a re-export only rewrites what
+    // changed and deletes outputs that are no longer referenced.
+    ExportStats exportToFolder(const ElementMap& elements, const SceneMap& scenes, const NodeMap& nodes, const std::string& folderPath,
+                               const ExportOptions& options = ExportOptions())
     {
-        // Construct path to project.json
-        fs::path inputFile = fs::path(folderPath) / "project.json";
-        std::ifstream file(inputFile);
-        if (!file.is_open())
+        // Create the output directory if it doesn't exist
+        fs::create_directories(folderPath);
+        ExportManifest manifest(folderPath);
+
+        fs::path exeDir = fs::current_path();
+        fs::path srcRenderer = exeDir / RENDERNAME;
+        if (fs::exists(srcRenderer))
         {
-            throw std::runtime_error("Failed to open file for reading: " + inputFile.string());
+            manifest.copyFile(srcRenderer.string(), RENDERNAME);
+        }
+        else
+        {
+            LogWarning("Renderer binary does not exist: %s", srcRenderer.string().c_str());
         }
 
-        json j;
-        file >> j;
-        file.close();
-
-        elements.clear();
-        if (j.contains("elements"))
+        try
         {
-            for (const auto& je : j["elements"])
+            fs::path srcFontDir = exeDir / "font";
+            if (fs::exists(srcFontDir))
             {
-                Element element = jsonToElement(je);
-                // Update image paths to include folder path
-                if (element.type == ElementType::CHARACTER)
-                {
-                    auto& character = std::get<CharacterElement>(element.data);
-                    std::vector<std::pair<std::string, std::string>> updatedImages;
-                    for (const auto& img : character.images)
-                    {
-                        if (!img.second.empty())
-                        {
-                            fs::path fullPath = fs::path(folderPath) / img.second;
-                            updatedImages.emplace_back(img.first, fullPath.string());
-                        }
-                        else
-                        {
-                            updatedImages.emplace_back(img.first, "");
-                        }
-                    }
-                    character.images = updatedImages;
-                }
-                else if (element.type == ElementType::BACKGROUND)
+                for (const auto& entry : fs::recursive_directory_iterator(srcFontDir))
                 {
-                    auto& background = std::get<BackgroundElement>(element.data);
-                    if (!background.imagePath.empty())
-                    {
-                        fs::path fullPath = fs::path(folderPath) / background.imagePath;
-                        background.imagePath = fullPath.string();
-                    }
+                    if (!entry.is_regular_file()) continue;
+                    std::string name = (fs::path("font") / fs::relative(entry.path(), srcFontDir)).generic_string();
+                    manifest.copyFile(entry.path().string(), name);
                 }
-                elements.push_back(element);
+            }
+            else
+            {
+                LogWarning("Font directory does not exist: %s", srcFontDir.string().c_str());
             }
         }
+        catch (const fs::filesystem_error& e)
+        {
+            LogWarning("Failed to copy font directory: %s", e.what());
+        }
+
+        ExportedPoses exportedPoses;
+        exportCharacterPoses(elements, folderPath, options, exportedPoses, manifest);
+
+        BackgroundVariants backgroundVariants;
+        if (options.bakeImages && !options.bakeTargets.empty())
+        {
+            bakeBackgroundVariants(elements, folderPath, options.bakeTargets, backgroundVariants, manifest);
+        }
 
-        // Load textures for CharacterElement and BackgroundElement
-        for (auto& element : elements)
+        // Collect all image paths to copy (written poses and baked variants are already there)
+        std::vector<std::string> imagePaths;
+        for (size_t e = 0; e < elements.size(); ++e)
         {
+            if (!elements.isAlive(e)) continue;
+            const Element& element = elements[e];
             if (element.type == ElementType::CHARACTER)
             {
                 auto& character = std::get<CharacterElement>(element.data);
-                character.textures.clear();
-                for (const auto& img : character.images)
+                for (size_t i = 0; i < character.images.size(); ++i)
                 {
-                    if (!img.second.empty())
+                    const std::string& path = character.images[i].second;
+                    if (!path.empty() && exportedPoses.count({e, i}) == 0)
                     {
-                        Image image = LoadImage(img.second.c_str());
-                        if (image.data != nullptr)
-                        {
-                            Texture2D texture = LoadTextureFromImage(image);
-                            character.textures.push_back(texture);
-                            UnloadImage(image);
-                        }
-                        else
-                        {
-                            TraceLog(LOG_WARNING, "Failed to load image: %s", img.second.c_str());
-                            character.textures.push_back({0});
-                        }
-                    }
-                    else
-                    {
-                        character.textures.push_back({0});
+                        imagePaths.push_back(path);
                     }
                 }
             }
             else if (element.type == ElementType::BACKGROUND)
             {
                 auto& background = std::get<BackgroundElement>(element.data);
-                if (!background.imagePath.empty())
+                if (background.imagePath.empty()) continue;
+                auto baked = backgroundVariants.find(e);
+                std::string fileName = exportedName(background.imagePath, manifest);
+                // The original is only shipped if some target uses it unscaled
+                bool originalUsed = baked == backgroundVariants.end() ||
+                                    std::any_of(baked->second.begin(), baked->second.end(),
+                                                [&](const BackgroundVariant& v) { return v.fileName == fileName; });
+                if (originalUsed)
                 {
-                    Image image = LoadImage(background.imagePath.c_str());
-                    if (image.data != nullptr)
-                    {
-                        background.texture = LoadTextureFromImage(image);
-                        UnloadImage(image);
-                    }
-                    else
-                    {
-                        TraceLog(LOG_WARNING, "Failed to load image: %s", background.imagePath.c_str());
-                        background.texture = {0};
-                    }
-                }
-                else
-                {
-                    background.texture = {0};
+                    imagePaths.push_back(background.imagePath);
                 }
             }
         }
 
-        scenes.clear();
-        if (j.contains("scenes"))
+        // Copy images to the output folder under content-hash names (unchanged copies
+        // are skipped, and files with equal contents are copied once)
+        for (const auto& srcPath : imagePaths)
         {
-            for (const auto& js : j["scenes"])
+            std::string name = exportedName(srcPath, manifest);
+            if (!manifest.isUsed(name))
             {
-                scenes.push_back(jsonToScene(js));
+                manifest.copyFile(srcPath, name);
             }
         }
 
-        nodes.clear();
-        if (j.contains("nodes"))
+        // project.json is streamed from the elements with paths rewritten one element
+        // at a time. A first pass only hashes the output (and fills project.bin's
+        // records); the file is written in a second pass if that hash changed.
+        std::set<std::string> shippedImages;
+        ProjectBinary::Writer binary;
+        auto writeShipped = [&](JsonWriter& writer, bool collect)
         {
-            for (const auto& jn : j["nodes"])
+            writeProject(writer, elements,
+                         [&](JsonWriter& w, size_t e)
+                         {
+                             static const std::vector<BackgroundVariant> noVariants;
+                             auto baked = backgroundVariants.find(e);
+                             const auto& variants = baked != backgroundVariants.end() ? baked->second : noVariants;
+                             Element shipped = exportedElement(elements[e], e, exportedPoses, backgroundVariants, manifest, shippedImages);
+                             writeElement(w, shipped, variants);
+                             if (!collect) return;
+                             binary.addElement(shipped);
+                             for (const auto& variant : variants)
+                             {
+                                 binary.addVariant(variant.target.width, variant.target.height, variant.fileName, variant.width, variant.height);
+                             }
+                         },
+                         scenes, nodes);
+        };
+
+        uint64_t contentHash = AssetBundle::HASH_SEED;
+        {
+            JsonWriter hasher([&](const char* data, size_t size) { contentHash = AssetBundle::hash(data, size, contentHash); }, options.jsonStyle);
+            writeShipped(hasher, true);
+        }
+        SavedIndices indices(elements, scenes, nodes, SlotIndexing::DENSE);
+        for (const auto& scene : scenes)
+        {
+            binary.addScene(scene, elements, indices);
+        }
+        for (const auto& node : nodes)
+        {
+            binary.addNode(node, scenes, nodes, indices);
+        }
+
+        // Write project.json unless it is unchanged
+        std::string source = "json|" + std::to_string(contentHash);
+        if (!manifest.isFresh("project.json", source))
+        {
+            fs::path outputFile = fs::path(folderPath) / "project.json";
+            std::ofstream file(outputFile);
+            if (!file.is_open())
+            {
+                throw std::runtime_error("Failed to open file for writing: " + outputFile.string());
+            }
+            {
+                JsonWriter writer([&](const char* data, size_t size) { file.write(data, size); }, options.jsonStyle);
+                writeShipped(writer, false);
+            }
+            file.close();
+            if (file.fail())
             {
-                nodes.push_back(jsonToNode(jn));
+                throw std::runtime_error("Failed to write file: " + outputFile.string());
             }
+            manifest.recordWritten("project.json", source);
         }
+        writeProjectBinary(binary, folderPath, source, manifest);
+
+        writeCompressedTextures(folderPath, shippedImages, options.compressTextures, manifest);
+        writeAssetBundle(folderPath, shippedImages, options.writeBundle, manifest);
+        return manifest.finish();
     }
 }
 
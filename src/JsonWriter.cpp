@@ -0,0 +1,175 @@
+#include "JsonWriter.hpp"
+#include "json.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+JsonWriter::JsonWriter(Sink sink, Style style) : sink(std::move(sink)), style(style) {
+    buffer.reserve(BUFFER_SIZE);
+}
+
+JsonWriter::~JsonWriter() {
+    flush();
+}
+
+void JsonWriter::flush() {
+    if (!buffer.empty()) {
+        sink(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+}
+
+void JsonWriter::write(const char* data, size_t size) {
+    if (buffer.size() + size > BUFFER_SIZE) {
+        flush();
+        if (size > BUFFER_SIZE) {
+            sink(data, size);
+            return;
+        }
+    }
+    buffer.append(data, size);
+}
+
+void JsonWriter::write(char c) {
+    if (buffer.size() >= BUFFER_SIZE) flush();
+    buffer.push_back(c);
+}
+
+void JsonWriter::newline() {
+    if (style != Style::INDENTED) return;
+    write('\n');
+    for (size_t i = 0; i < levels.size(); ++i) write("    ", 4);
+}
+
+void JsonWriter::beforeValue() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (levels.empty()) return;
+    if (levels.back().count++ > 0) write(',');
+    newline();
+}
+
+void JsonWriter::beginObject() {
+    beforeValue();
+    write('{');
+    levels.push_back({true, 0});
+}
+
+void JsonWriter::endObject() {
+    bool empty = levels.back().count == 0;
+    levels.pop_back();
+    if (!empty) newline();
+    write('}');
+}
+
+void JsonWriter::beginArray() {
+    beforeValue();
+    write('[');
+    levels.push_back({false, 0});
+}
+
+void JsonWriter::endArray() {
+    bool empty = levels.back().count == 0;
+    levels.pop_back();
+    if (!empty) newline();
+    write(']');
+}
+
+void JsonWriter::key(const std::string& name) {
+    beforeValue();
+    writeString(name);
+    if (style == Style::INDENTED) {
+        write(": ", 2);
+    } else {
+        write(':');
+    }
+    afterKey = true;
+}
+
+void JsonWriter::value(const std::string& text) {
+    beforeValue();
+    writeString(text);
+}
+
+void JsonWriter::value(bool flag) {
+    beforeValue();
+    if (flag) {
+        write("true", 4);
+    } else {
+        write("false", 5);
+    }
+}
+
+void JsonWriter::value(int64_t number) {
+    beforeValue();
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), number);
+    write(digits, result.ptr - digits);
+}
+
+void JsonWriter::value(uint64_t number) {
+    beforeValue();
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), number);
+    write(digits, result.ptr - digits);
+}
+
+void JsonWriter::value(double number) {
+    beforeValue();
+    if (!std::isfinite(number)) {
+        write("null", 4); // As nlohmann does
+        return;
+    }
+
+    // nlohmann's own formatter, so numbers come out exactly as dump() writes them
+    char digits[64];
+    char* end = nlohmann::detail::to_chars(digits, digits + sizeof(digits), number);
+    write(digits, end - digits);
+}
+
+void JsonWriter::writeString(const std::string& text) {
+    static const char HEX[] = "0123456789abcdef";
+    write('"');
+    size_t runStart = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = (unsigned char)text[i];
+        const char* escape = nullptr;
+        switch (c) {
+        case '"': escape = "\\\""; break;
+        case '\\': escape = "\\\\"; break;
+        case '\b': escape = "\\b"; break;
+        case '\f': escape = "\\f"; break;
+        case '\n': escape = "\\n"; break;
+        case '\r': escape = "\\r"; break;
+        case '\t': escape = "\\t"; break;
+        default:
+            if (c >= 0x20) {
+                if (c >= 0x80) {
+                    // Multi-byte sequence: reject what the parser would reject on import
+                    size_t extra = (c & 0xE0) == 0xC0 ? 1 : (c & 0xF0) == 0xE0 ? 2 : (c & 0xF8) == 0xF0 ? 3 : 0;
+                    bool valid = extra > 0 && c >= 0xC2 && c <= 0xF4 && i + extra < text.size();
+                    for (size_t j = 1; valid && j <= extra; ++j) {
+                        valid = ((unsigned char)text[i + j] & 0xC0) == 0x80;
+                    }
+                    if (!valid) throw std::runtime_error("Invalid UTF-8 in string at byte " + std::to_string(i));
+                    i += extra;
+                }
+                continue;
+            }
+            break;
+        }
+        write(text.data() + runStart, i - runStart);
+        if (escape != nullptr) {
+            write(escape, std::strlen(escape));
+        } else {
+            char unicode[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]};
+            write(unicode, sizeof(unicode));
+        }
+        runStart = i + 1;
+    }
+    write(text.data() + runStart, text.size() - runStart);
+    write('"');
+}
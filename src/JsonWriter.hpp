@@ -0,0 +1,74 @@
+#ifndef JSON_WRITER_HPP
+#define JSON_WRITER_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Streaming JSON emitter: values go into a fixed-size buffer that is handed
+// to a sink whenever it fills, so nothing but the current nesting is kept in
+// memory. Output is formatted the way nlohmann::json::dump() does it (INDENTED
+// matches dump(4), COMPACT matches dump()) as long as callers emit object keys
+// in sorted order, which keeps exported files diffable against older ones.
+class JsonWriter
+{
+public:
+    enum class Style { COMPACT, INDENTED };
+
+    // Receives the formatted output in chunks, in order
+    using Sink = std::function<void(const char* data, size_t size)>;
+
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+    JsonWriter(Sink sink, Style style = Style::INDENTED);
+    ~JsonWriter(); // Flushes whatever is buffered
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    void key(const std::string& name);
+
+    void value(const std::string& text);
+    void value(const char* text) { value(std::string(text)); }
+    void value(bool flag);
+    void value(int number) { value((int64_t)number); }
+    void value(int64_t number);
+    void value(uint64_t number);
+    void value(float number) { value((double)number); }
+    void value(double number);
+
+    // key() followed by value()
+    template <typename T>
+    void member(const std::string& name, const T& v)
+    {
+        key(name);
+        value(v);
+    }
+
+    void flush();
+
+private:
+    void beforeValue();
+    void newline();
+    void write(const char* data, size_t size);
+    void write(char c);
+    void writeString(const std::string& text);
+
+    struct Level
+    {
+        bool isObject;
+        size_t count;
+    };
+
+    Sink sink;
+    Style style;
+    std::string buffer;
+    std::vector<Level> levels;
+    bool afterKey = false;
+};
+
+#endif // JSON_WRITER_HPP
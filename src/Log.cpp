@@ -0,0 +1,192 @@
+#include "Log.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+namespace Log {
+
+namespace {
+
+constexpr size_t RING_SIZE = 1024; // Power of two
+constexpr size_t MESSAGE_SIZE = 512;
+constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(10);
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Bounded multi-producer queue (Vyukov): a slot's sequence says whose turn it
+// is. sequence == position: free for the producer claiming position;
+// position + 1: written, waiting for the consumer; position + RING_SIZE: read,
+// free for the producer one lap later.
+struct Slot {
+    std::atomic<size_t> sequence;
+    int level;
+    char text[MESSAGE_SIZE];
+};
+
+class Logger {
+public:
+    Logger() {
+        for (size_t i = 0; i < RING_SIZE; ++i) slots[i].sequence.store(i, std::memory_order_relaxed);
+        worker = std::thread(&Logger::workerLoop, this);
+    }
+
+    // Drain and stop the worker; later messages are written directly
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        if (worker.joinable()) worker.join();
+        stopped.store(true, std::memory_order_release);
+    }
+
+    bool isStopped() const { return stopped.load(std::memory_order_acquire); }
+
+    // Claim a slot, or nullptr if the ring is full
+    Slot* claim(size_t& position) {
+        position = enqueuePosition.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots[position & (RING_SIZE - 1)];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) return &slot;
+            } else if (difference < 0) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void publish(Slot& slot, size_t position) { slot.sequence.store(position + 1, std::memory_order_release); }
+
+    void flush() {
+        size_t target = enqueuePosition.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(mutex);
+        flushRequested = true;
+        wake.notify_all();
+        drained.wait(lock, [&] { return dequeuePosition.load(std::memory_order_acquire) >= target || stopping; });
+    }
+
+private:
+    // Hand everything published so far to TraceLog
+    void drain() {
+        while (true) {
+            size_t position = dequeuePosition.load(std::memory_order_relaxed);
+            Slot& slot = slots[position & (RING_SIZE - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != position + 1) break;
+            TraceLog(slot.level, "%s", slot.text);
+            slot.sequence.store(position + RING_SIZE, std::memory_order_release);
+            dequeuePosition.store(position + 1, std::memory_order_release);
+        }
+        uint64_t lost = dropped.exchange(0, std::memory_order_relaxed);
+        if (lost > 0) TraceLog(LOG_WARNING, "Log: %llu message(s) dropped, the log buffer was full", (unsigned long long)lost);
+    }
+
+    void workerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            lock.unlock();
+            drain();
+            lock.lock();
+            drained.notify_all();
+            if (stopping) {
+                // Producers may have published since the last drain
+                lock.unlock();
+                drain();
+                lock.lock();
+                drained.notify_all();
+                return;
+            }
+            wake.wait_for(lock, FLUSH_INTERVAL, [this] { return stopping || flushRequested; });
+            flushRequested = false;
+        }
+    }
+
+    Slot slots[RING_SIZE];
+    std::atomic<size_t> enqueuePosition{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<size_t> dequeuePosition{0}; // Written by the worker only
+    std::atomic<bool> stopped{false};
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable drained;
+    bool stopping = false;
+    bool flushRequested = false;
+};
+
+// Never destroyed, so objects destroyed at exit can still log; the worker is
+// stopped (and the ring drained) by an atexit handler instead
+Logger& logger() {
+    static Logger* instance = [] {
+        Logger* created = new Logger();
+        std::atexit([] { logger().stop(); });
+        return created;
+    }();
+    return *instance;
+}
+
+// Truncated to size, with the site's suppressed count appended
+void formatMessage(char* text, size_t size, const char* format, va_list args, uint32_t suppressed) {
+    int length = std::vsnprintf(text, size, format, args);
+    if (suppressed > 0 && length >= 0 && (size_t)length < size) {
+        std::snprintf(text + length, size - length, " (%u similar message(s) suppressed)", suppressed);
+    }
+}
+
+} // namespace
+
+bool Site::allow() {
+    if (level >= LOG_FATAL) return true;
+    int64_t now = nowMs();
+    int64_t start = windowStart.load(std::memory_order_relaxed);
+    if (now - start >= 1000 && windowStart.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+        windowCount.store(0, std::memory_order_relaxed);
+    }
+    if (windowCount.fetch_add(1, std::memory_order_relaxed) < SITE_BURST) return true;
+    suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void write(Site& site, const char* format, ...) {
+    uint32_t suppressed = site.takeSuppressed();
+    Logger& instance = logger();
+    va_list args;
+    va_start(args, format);
+    if (site.level >= LOG_FATAL || instance.isStopped()) {
+        // Written here and now: the process is about to end
+        char message[MESSAGE_SIZE];
+        formatMessage(message, sizeof(message), format, args, suppressed);
+        va_end(args);
+        if (!instance.isStopped()) instance.flush();
+        TraceLog(site.level, "%s", message); // Exits on FATAL
+        return;
+    }
+
+    size_t position;
+    Slot* slot = instance.claim(position);
+    if (slot != nullptr) {
+        slot->level = site.level;
+        formatMessage(slot->text, sizeof(slot->text), format, args, suppressed);
+        instance.publish(*slot, position);
+    }
+    va_end(args);
+}
+
+void flush() {
+    logger().flush();
+}
+
+} // namespace Log
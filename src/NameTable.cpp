@@ -0,0 +1,31 @@
+#include "NameTable.hpp"
+
+NameTable& NameTable::instance() {
+    static NameTable table;
+    return table;
+}
+
+NameTable::NameTable() {
+    names.emplace_back();
+    ids.emplace(std::string(), EMPTY);
+}
+
+NameId NameTable::intern(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = ids.find(name);
+    if (it != ids.end()) return it->second;
+    NameId id = (NameId)names.size();
+    names.push_back(name);
+    ids.emplace(name, id);
+    return id;
+}
+
+const std::string& NameTable::getName(NameId id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return id < names.size() ? names[id] : names[EMPTY];
+}
+
+size_t NameTable::getCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return names.size();
+}
@@ -0,0 +1,38 @@
+#ifndef NAME_TABLE_HPP
+#define NAME_TABLE_HPP
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Interned string ID. Equal names get equal IDs for the life of the process,
+// so code that runs every frame compares integers instead of strings. IDs are
+// not stable across runs; files keep the names.
+using NameId = uint32_t;
+
+// Process-wide string interning table. The empty name is always ID 0.
+class NameTable
+{
+public:
+    static constexpr NameId EMPTY = 0;
+
+    static NameTable& instance();
+
+    NameId intern(const std::string& name);
+    // The name an ID was interned from; empty for unknown IDs
+    const std::string& getName(NameId id) const;
+    size_t getCount() const;
+
+private:
+    NameTable();
+    NameTable(const NameTable&) = delete;
+    NameTable& operator=(const NameTable&) = delete;
+
+    mutable std::mutex mutex; // So worker threads can build project data too
+    std::deque<std::string> names; // Indexed by ID; a deque keeps references stable
+    std::unordered_map<std::string, NameId> ids;
+};
+
+#endif // NAME_TABLE_HPP
@@ -1,10 +1,13 @@
 #include "NodeManager.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
 #include <raylib.h>
 
-NodeManager::NodeManager(std::vector<Scene>& scenes) :
+NodeManager::NodeManager(SceneMap& scenes) :
     scenes(scenes),
     offset{0, 0},
     draggingNode(-1),
+    dragStartPosition{0, 0},
     draggingCanvas(false),
     creatingConnection(false),
     selectedNode(-1),
@@ -20,11 +23,12 @@ NodeManager::NodeManager(std::vector<Scene>& scenes) :
     connectionRenderMode(ConnectionRenderMode::SINGLE_POINT)
 {
     // Initialize the first node as the start node
-    nodes.emplace_back(Node{"Start Node", -1, {}, {100, 100}, DragType::SIMPLE, LIGHTGRAY, true});
+    nodes.push_back(Node{"Start Node", -1, {}, {100, 100}, DragType::SIMPLE, LIGHTGRAY, true});
 }
 
 void NodeManager::update()
 {
+    PROFILE_ZONE("NodeManager::update");
     Vector2 mouse = GetMousePosition();
     Vector2 mouseDelta = GetMouseDelta();
 
@@ -35,6 +39,7 @@ void NodeManager::update()
         {
             if (isMouseOverNode(i)) {
                 draggingNode = static_cast<int>(i);
+                dragStartPosition = nodes[i].position;
                 break;
             }
         }
@@ -42,6 +47,11 @@ void NodeManager::update()
 
     if (IsMouseButtonReleased(MOUSE_RIGHT_BUTTON))
     {
+        // A move is recorded once it is finished, not every frame of the drag
+        if (draggingNode != -1 && (nodes[draggingNode].position.x != dragStartPosition.x ||
+                                   nodes[draggingNode].position.y != dragStartPosition.y)) {
+            notifyChanged(draggingNode);
+        }
         draggingNode = -1;
     }
 
@@ -68,18 +78,19 @@ void NodeManager::update()
             {
                 if (i != fromNode && isMouseOverNodeInput(i))
                 {
-                    if (i < nodes.size()) {
+                    if (nodes.isAlive(fromNode)) {
                         char buffer[256] = "Enter choice text";
-                        nodes[fromNode].connections.push_back({i, buffer});
-                        TraceLog(LOG_INFO, "Created connection from node %zu to node %zu with choice text: %s", fromNode, i, buffer);
+                        connect(nodes, fromNode, i, buffer);
+                        notifyChanged(fromNode);
+                        LogInfo("Created connection from node %zu to node %zu with choice text: %s", fromNode, i, buffer);
                     } else {
-                        TraceLog(LOG_WARNING, "Attempted to create connection to invalid node index %zu", i);
+                        LogWarning("Attempted to create connection to invalid node index %zu", i);
                     }
                     break;
                 }
             }
             creatingConnection = false;
-            TraceLog(LOG_INFO, "Connection creation ended");
+            LogInfo("Connection creation ended");
         }
     }
 
@@ -96,7 +107,7 @@ void NodeManager::update()
             if (isMouseOverNodeOutput(i)) {
                 creatingConnection = true;
                 fromNode = i;
-                TraceLog(LOG_INFO, "Started connection creation from node %zu", i);
+                LogInfo("Started connection creation from node %zu", i);
                 break;
             }
         }
@@ -124,12 +135,11 @@ void NodeManager::update()
                 } else {
                     choiceTextBuffer[0] = '\0';
                 }
-                TraceLog(LOG_INFO, "Opened edit UI for node %zu: %s", i, nodes[i].name.c_str());
-                TraceLog(LOG_DEBUG, "Node %zu has %zu connections:", i, nodes[i].connections.size());
+                LogInfo("Opened edit UI for node %zu: %s", i, nodes[i].name.c_str());
+                LogDebug("Node %zu has %zu connections:", i, nodes[i].connections.size());
                 for (size_t j = 0; j < nodes[i].connections.size(); ++j) {
-                    size_t toNodeIndex = nodes[i].connections[j].toNodeIndex;
-                    TraceLog(LOG_DEBUG, "  Connection %zu: toNodeIndex=%zu, choiceText=%s",
-                        j, toNodeIndex, nodes[i].connections[j].choiceText.c_str());
+                    LogDebug("  Connection %zu: toNodeIndex=%zu, choiceText=%s",
+                        j, nodes[i].connections[j].toNodeIndex, nodes[i].connections[j].choiceText.c_str());
                 }
                 break;
             }
@@ -146,19 +156,21 @@ void NodeManager::update()
         deleteNode(selectedNode);
         selectedNode = -1;
         editingNode = false;
-        TraceLog(LOG_INFO, "Deleted node");
+        LogInfo("Deleted node");
     }
 }
 
 void NodeManager::draw()
 {
+    PROFILE_ZONE("NodeManager::draw");
     // Draw connections
     for (size_t i = 0; i < nodes.size(); ++i)
     {
+        if (!nodes.isAlive(i)) continue;
         for (size_t j = 0; j < nodes[i].connections.size(); ++j)
         {
             const auto& conn = nodes[i].connections[j];
-            if (conn.toNodeIndex < nodes.size()) {
+            if (isLinked(nodes, conn)) {
                 size_t inputSlotIndex = getIncomingConnectionIndex(conn.toNodeIndex, i, j);
                 Vector2 start = getNodeOutputPos(i, j);
                 Vector2 end = getNodeInputPos(conn.toNodeIndex, connectionRenderMode == ConnectionRenderMode::MULTI_POINT ? inputSlotIndex : 0);
@@ -166,8 +178,6 @@ void NodeManager::draw()
                 // DrawTextEx(conn.choiceText.c_str(), (start.x + end.x) / 2, (start.y + end.y) / 2 - 10, 10, BLACK);
                 DrawTextEx(customFont, conn.choiceText.c_str(), (Vector2){(start.x + end.x) / 2,  (start.y + end.y) / 2 -10}, 20, 1,  BLACK);
 
-            } else {
-                TraceLog(LOG_WARNING, "Invalid toNodeIndex %zu in connection %zu for node %zu", conn.toNodeIndex, j, i);
             }
         }
     }
@@ -175,6 +185,7 @@ void NodeManager::draw()
     // Draw nodes
     for (size_t i = 0; i < nodes.size(); ++i)
     {
+        if (!nodes.isAlive(i)) continue;
         float nodeHeight = getNodeHeight(i);
         Vector2 pos = {nodes[i].position.x + offset.x, nodes[i].position.y + offset.y};
         Rectangle rect = {pos.x, pos.y, 150, nodeHeight};
@@ -210,7 +221,7 @@ void NodeManager::draw()
     }
 
     // Draw node editor UI
-    if (editingNode && selectedNode != -1 && selectedNode < static_cast<int>(nodes.size()))
+    if (editingNode && selectedNode != -1 && nodes.isAlive(selectedNode))
     {
         drawEditUI();
     }
@@ -221,44 +232,30 @@ void NodeManager::draw()
 
 void NodeManager::addNode(float x, float y)
 {
-    nodes.emplace_back(Node{"Node " + std::to_string(nodes.size() + 1), -1, {}, {x, y}, DragType::SIMPLE, LIGHTGRAY});
-    TraceLog(LOG_INFO, "Added node at (%f, %f)", x, y);
+    size_t index = nodes.insert(Node{"Node " + std::to_string(nodes.liveCount() + 1), -1, {}, {x, y}, DragType::SIMPLE, LIGHTGRAY});
+    notifyChanged(index);
+    LogInfo("Added node at (%f, %f)", x, y);
+}
+
+void NodeManager::notifyChanged(size_t index)
+{
+    if (observer) observer->nodeChanged(index);
 }
 
 void NodeManager::deleteNode(size_t index)
 {
-    if (index >= nodes.size()) {
-        TraceLog(LOG_WARNING, "Attempted to delete invalid node index %zu", index);
+    if (!nodes.isAlive(index)) {
+        LogWarning("Attempted to delete invalid node index %zu", index);
         return;
     }
-    bool wasStartNode = nodes[index].isStartNode;
-    nodes.erase(nodes.begin() + index);
-    for (auto& node : nodes)
-    {
-        auto it = node.connections.begin();
-        while (it != node.connections.end()) {
-            if (it->toNodeIndex == index) {
-                it = node.connections.erase(it);
-                TraceLog(LOG_INFO, "Removed connection to deleted node %zu", index);
-            } else {
-                if (it->toNodeIndex > index) {
-                    it->toNodeIndex--;
-                    TraceLog(LOG_INFO, "Adjusted toNodeIndex to %zu for connection", it->toNodeIndex);
-                }
-                ++it;
-            }
-        }
-    }
-    // If the deleted node was the start node, assign the first node as the new start node
-    if (wasStartNode && !nodes.empty()) {
-        nodes[0].isStartNode = true;
-        TraceLog(LOG_INFO, "Assigned node 0 as new start node after deletion");
-    }
+    eraseNode(nodes, index);
+    if (observer) observer->nodeErased(index);
+    LogInfo("Removed node %zu", index);
 }
 
 bool NodeManager::isMouseOverNode(size_t index)
 {
-    if (index >= nodes.size()) return false;
+    if (!nodes.isAlive(index)) return false;
     float nodeHeight = getNodeHeight(index);
     Vector2 pos = {nodes[index].position.x + offset.x, nodes[index].position.y + offset.y};
     Vector2 size = {150, nodeHeight};
@@ -268,7 +265,7 @@ bool NodeManager::isMouseOverNode(size_t index)
 
 bool NodeManager::isMouseOverNodeInput(size_t index)
 {
-    if (index >= nodes.size()) return false;
+    if (!nodes.isAlive(index)) return false;
     Vector2 mouse = GetMousePosition();
     if (connectionRenderMode == ConnectionRenderMode::SINGLE_POINT) {
         Vector2 inputPos = getNodeInputPos(index, 0);
@@ -288,7 +285,7 @@ bool NodeManager::isMouseOverNodeInput(size_t index)
 
 bool NodeManager::isMouseOverNodeOutput(size_t index)
 {
-    if (index >= nodes.size()) return false;
+    if (!nodes.isAlive(index)) return false;
     Vector2 mouse = GetMousePosition();
     if (connectionRenderMode == ConnectionRenderMode::SINGLE_POINT) {
         Vector2 outputPos = getNodeOutputPos(index, 0);
@@ -320,7 +317,7 @@ size_t NodeManager::getIncomingConnectionCount(size_t nodeIndex)
     size_t count = 0;
     for (size_t i = 0; i < nodes.size(); ++i) {
         for (const auto& conn : nodes[i].connections) {
-            if (conn.toNodeIndex == nodeIndex) {
+            if (conn.toNodeIndex == nodeIndex && isLinked(nodes, conn)) {
                 ++count;
             }
         }
@@ -333,7 +330,8 @@ size_t NodeManager::getIncomingConnectionIndex(size_t targetNodeIndex, size_t so
     size_t index = 0;
     for (size_t i = 0; i < nodes.size(); ++i) {
         for (size_t j = 0; j < nodes[i].connections.size(); ++j) {
-            if (nodes[i].connections[j].toNodeIndex == targetNodeIndex) {
+            const auto& conn = nodes[i].connections[j];
+            if (conn.toNodeIndex == targetNodeIndex && isLinked(nodes, conn)) {
                 if (i == sourceNodeIndex && j == sourceConnIndex) {
                     return index;
                 }
@@ -341,14 +339,14 @@ size_t NodeManager::getIncomingConnectionIndex(size_t targetNodeIndex, size_t so
             }
         }
     }
-    TraceLog(LOG_WARNING, "Could not find incoming connection index for target %zu from source %zu, conn %zu", targetNodeIndex, sourceNodeIndex, sourceConnIndex);
+    LogWarning("Could not find incoming connection index for target %zu from source %zu, conn %zu", targetNodeIndex, sourceNodeIndex, sourceConnIndex);
     return 0;
 }
 
 float NodeManager::getNodeHeight(size_t index)
 {
-    if (index >= nodes.size()) {
-        TraceLog(LOG_WARNING, "Invalid node index %zu for getNodeHeight", index);
+    if (!nodes.isAlive(index)) {
+        LogWarning("Invalid node index %zu for getNodeHeight", index);
         return 60.0f;
     }
     if (connectionRenderMode == ConnectionRenderMode::SINGLE_POINT) {
@@ -365,8 +363,8 @@ float NodeManager::getNodeHeight(size_t index)
 
 Vector2 NodeManager::getNodeInputPos(size_t index, size_t connectionIndex)
 {
-    if (index >= nodes.size()) {
-        TraceLog(LOG_WARNING, "Invalid node index %zu for getNodeInputPos", index);
+    if (!nodes.isAlive(index)) {
+        LogWarning("Invalid node index %zu for getNodeInputPos", index);
         return {0, 0};
     }
     float nodeHeight = getNodeHeight(index);
@@ -383,8 +381,8 @@ Vector2 NodeManager::getNodeInputPos(size_t index, size_t connectionIndex)
 
 Vector2 NodeManager::getNodeOutputPos(size_t index, size_t connectionIndex)
 {
-    if (index >= nodes.size()) {
-        TraceLog(LOG_WARNING, "Invalid node index %zu for getNodeOutputPos", index);
+    if (!nodes.isAlive(index)) {
+        LogWarning("Invalid node index %zu for getNodeOutputPos", index);
         return {0, 0};
     }
     float nodeHeight = getNodeHeight(index);
@@ -401,8 +399,8 @@ Vector2 NodeManager::getNodeOutputPos(size_t index, size_t connectionIndex)
 
 void NodeManager::drawEditUI()
 {
-    if (selectedNode < 0 || selectedNode >= static_cast<int>(nodes.size())) {
-        TraceLog(LOG_WARNING, "Invalid selectedNode %d in drawEditUI", selectedNode);
+    if (selectedNode < 0 || !nodes.isAlive(selectedNode)) {
+        LogWarning("Invalid selectedNode %d in drawEditUI", selectedNode);
         editingNode = false;
         selectedNode = -1;
         selectedConnection = -1;
@@ -424,7 +422,7 @@ void NodeManager::drawEditUI()
     if (GuiTextBox({panelX + 10, 110, 160, 20}, textBuffer, 256, editTextFlag))
     {
         editTextFlag = !editTextFlag;
-        TraceLog(LOG_INFO, "Toggled node name edit: %s", textBuffer);
+        LogInfo("Toggled node name edit: %s", textBuffer);
     }
 
     DrawText("Drag Type:", panelX + 10, 190, 12, BLACK);
@@ -438,13 +436,18 @@ void NodeManager::drawEditUI()
     {
         if (isStartNode && !nodes[selectedNode].isStartNode) {
             // Clear existing start node
-            for (auto& node : nodes) {
-                node.isStartNode = false;
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                if (nodes[i].isStartNode) {
+                    nodes[i].isStartNode = false;
+                    notifyChanged(i);
+                }
             }
             nodes[selectedNode].isStartNode = true;
-            TraceLog(LOG_INFO, "Set node %d as start node", selectedNode);
+            notifyChanged(selectedNode);
+            LogInfo("Set node %d as start node", selectedNode);
         } else if (!isStartNode && nodes[selectedNode].isStartNode) {
             nodes[selectedNode].isStartNode = false;
+            notifyChanged(selectedNode);
             // Assign first node as start node if no other is selected
             bool hasStartNode = false;
             for (const auto& node : nodes) {
@@ -454,8 +457,10 @@ void NodeManager::drawEditUI()
                 }
             }
             if (!hasStartNode && !nodes.empty()) {
-                nodes[0].isStartNode = true;
-                TraceLog(LOG_INFO, "Assigned node 0 as start node after unsetting");
+                size_t first = nodes.firstAlive();
+                nodes[first].isStartNode = true;
+                notifyChanged(first);
+                LogInfo("Assigned node %zu as start node after unsetting", first);
             }
         }
     }
@@ -467,7 +472,7 @@ void NodeManager::drawEditUI()
         if (GuiTextBox({panelX + 10, 380, 160, 20}, choiceTextBuffer, 256, editChoiceTextFlag)) {
             editChoiceTextFlag = !editChoiceTextFlag;
             isEditingChoiceText = editChoiceTextFlag;
-            TraceLog(LOG_INFO, "Toggled choice text edit: %s, isEditingChoiceText: %d", choiceTextBuffer, isEditingChoiceText);
+            LogInfo("Toggled choice text edit: %s, isEditingChoiceText: %d", choiceTextBuffer, isEditingChoiceText);
         }
     } else {
         isEditingChoiceText = false;
@@ -478,6 +483,7 @@ void NodeManager::drawEditUI()
     if (GuiButton({panelX + 10, 430, 160, 20}, "Delete Connection") && selectedConnection >= 0 && selectedConnection < static_cast<int>(nodes[selectedNode].connections.size()))
     {
         nodes[selectedNode].connections.erase(nodes[selectedNode].connections.begin() + selectedConnection);
+        notifyChanged(selectedNode);
         selectedConnection = nodes[selectedNode].connections.empty() ? -1 : 0;
         choiceTextBuffer[0] = '\0';
         connDropdownEditMode = false;
@@ -485,7 +491,7 @@ void NodeManager::drawEditUI()
         if (selectedConnection >= 0) {
             strncpy(choiceTextBuffer, nodes[selectedNode].connections[selectedConnection].choiceText.c_str(), 256);
         }
-        TraceLog(LOG_INFO, "Connection deleted for node %d, new selectedConnection: %d", selectedNode, selectedConnection);
+        LogInfo("Connection deleted for node %d, new selectedConnection: %d", selectedNode, selectedConnection);
     }
 
     if (GuiButton({panelX + 10, 460, 160, 20}, "Save"))
@@ -493,9 +499,10 @@ void NodeManager::drawEditUI()
         nodes[selectedNode].name = textBuffer;
         if (selectedConnection >= 0 && selectedConnection < static_cast<int>(nodes[selectedNode].connections.size())) {
             nodes[selectedNode].connections[selectedConnection].choiceText = choiceTextBuffer;
-            TraceLog(LOG_INFO, "Saved choice text for connection %d: %s", selectedConnection, choiceTextBuffer);
+            LogInfo("Saved choice text for connection %d: %s", selectedConnection, choiceTextBuffer);
         }
-        TraceLog(LOG_INFO, "Saved node name: %s", textBuffer);
+        notifyChanged(selectedNode);
+        LogInfo("Saved node name: %s", textBuffer);
         isEditingChoiceText = false;
     }
 
@@ -506,14 +513,14 @@ void NodeManager::drawEditUI()
         selectedNode = -1;
         selectedConnection = -1;
         isEditingChoiceText = false;
-        TraceLog(LOG_INFO, "Node deleted");
+        LogInfo("Node deleted");
     }
 
     if (GuiButton({panelX + 10, 520, 160, 20}, "Add New Node"))
     {
         Vector2 mouse = GetMousePosition();
         addNode(mouse.x - offset.x, mouse.y - offset.y);
-        TraceLog(LOG_INFO, "Node added at (%f, %f)", mouse.x - offset.x, mouse.y - offset.y);
+        LogInfo("Node added at (%f, %f)", mouse.x - offset.x, mouse.y - offset.y);
     }
 
     if (GuiButton({panelX + 10, 550, 160, 20}, "Close"))
@@ -528,7 +535,7 @@ void NodeManager::drawEditUI()
         editTextFlag = false;
         editChoiceTextFlag = false;
         isEditingChoiceText = false;
-        TraceLog(LOG_INFO, "Edit UI closed");
+        LogInfo("Edit UI closed");
     }
 
     static int prevSelectedConnection = -1;
@@ -539,24 +546,21 @@ void NodeManager::drawEditUI()
         connDropdownText.clear();
         for (size_t i = 0; i < nodes[selectedNode].connections.size(); ++i)
         {
-            size_t toNodeIndex = nodes[selectedNode].connections[i].toNodeIndex;
-            if (toNodeIndex < nodes.size()) {
-                connDropdownText += "To " + nodes[toNodeIndex].name;
-                if (i < nodes[selectedNode].connections.size() - 1) {
-                    connDropdownText += ";";
-                }
-            } else {
-                TraceLog(LOG_WARNING, "Invalid toNodeIndex %zu in connection %zu for node %d", toNodeIndex, i, selectedNode);
+            const auto& conn = nodes[selectedNode].connections[i];
+            // Kept in the list so dropdown positions match connection indices
+            connDropdownText += isLinked(nodes, conn) ? "To " + nodes[conn.toNodeIndex].name : "To (deleted node)";
+            if (i < nodes[selectedNode].connections.size() - 1) {
+                connDropdownText += ";";
             }
         }
         if (connDropdownText.empty()) {
             connDropdownText = "None";
-            TraceLog(LOG_DEBUG, "No valid connections for node %d", selectedNode);
+            LogDebug("No valid connections for node %d", selectedNode);
         }
     } else {
-        TraceLog(LOG_DEBUG, "Node %d has no connections", selectedNode);
+        LogDebug("Node %d has no connections", selectedNode);
     }
-    TraceLog(LOG_DEBUG, "Connections dropdown text: %s, connectionIndex: %d", connDropdownText.c_str(), connectionIndex);
+    LogDebug("Connections dropdown text: %s, connectionIndex: %d", connDropdownText.c_str(), connectionIndex);
     if (GuiDropdownBox({panelX + 10, 350, 160, 20}, connDropdownText.c_str(), &connectionIndex, connDropdownEditMode))
     {
         connDropdownEditMode = !connDropdownEditMode;
@@ -568,8 +572,8 @@ void NodeManager::drawEditUI()
                 if (!isEditingChoiceText && selectedConnection != prevSelectedConnection) {
                     strncpy(choiceTextBuffer, nodes[selectedNode].connections[selectedConnection].choiceText.c_str(), 256);
                 }
-                TraceLog(LOG_INFO, "Selected connection %d (To %s) with choice text: %s",
-                    selectedConnection, nodes[nodes[selectedNode].connections[selectedConnection].toNodeIndex].name.c_str(), choiceTextBuffer);
+                LogInfo("Selected connection %d (To node %zu) with choice text: %s",
+                    selectedConnection, nodes[selectedNode].connections[selectedConnection].toNodeIndex, choiceTextBuffer);
             } else
             {
                 selectedConnection = nodes[selectedNode].connections.empty() ? -1 : 0;
@@ -578,7 +582,7 @@ void NodeManager::drawEditUI()
                 } else {
                     choiceTextBuffer[0] = '\0';
                 }
-                TraceLog(LOG_INFO, "No valid connection selected for node %d, resetting to %d", selectedNode, selectedConnection);
+                LogInfo("No valid connection selected for node %d, resetting to %d", selectedNode, selectedConnection);
             }
             prevSelectedConnection = selectedConnection;
         }
@@ -594,7 +598,7 @@ void NodeManager::drawEditUI()
         if (!renderModeDropdownEditMode)
         {
             connectionRenderMode = static_cast<ConnectionRenderMode>(renderModeIndex);
-            TraceLog(LOG_INFO, "Connection render mode set to: %s", renderModeIndex == 0 ? "Single Point" : "Multi Point");
+            LogInfo("Connection render mode set to: %s", renderModeIndex == 0 ? "Single Point" : "Multi Point");
         }
     }
 
@@ -631,7 +635,8 @@ void NodeManager::drawEditUI()
                 case 2: nodes[selectedNode].color = GREEN; break;
                 case 3: nodes[selectedNode].color = RED; break;
             }
-            TraceLog(LOG_INFO, "Color selected: %d", colorIndex);
+            notifyChanged(selectedNode);
+            LogInfo("Color selected: %d", colorIndex);
         }
     }
 
@@ -642,29 +647,37 @@ void NodeManager::drawEditUI()
         if (!dragDropdownEditMode)
         {
             nodes[selectedNode].dragType = static_cast<DragType>(dragTypeIndex);
-            TraceLog(LOG_INFO, "Drag type selected: %d", dragTypeIndex);
+            notifyChanged(selectedNode);
+            LogInfo("Drag type selected: %d", dragTypeIndex);
         }
     }
 
     // Draw Scene dropdown last to ensure it appears on top
     DrawText("Scene:", panelX + 10, 140, 12, BLACK);
-    int selectedScene = nodes[selectedNode].sceneIndex;
+    // The dropdown lists live scenes only; liveScenes maps its positions to slots
+    std::vector<size_t> liveScenes;
+    int selectedScene = -1;
     std::string dropdownText = "None";
     if (!scenes.empty()) {
         dropdownText.clear();
         for (size_t i = 0; i < scenes.size(); ++i) {
+            if (!scenes.isAlive(i)) continue;
+            if (findScene(scenes, nodes[selectedNode]) == &scenes[i]) selectedScene = static_cast<int>(liveScenes.size());
+            if (!liveScenes.empty()) dropdownText += ";";
             dropdownText += scenes[i].name;
-            if (i < scenes.size() - 1) dropdownText += ";";
+            liveScenes.push_back(i);
         }
     }
     if (GuiDropdownBox({panelX + 10, 160, 160, 20}, dropdownText.c_str(), &selectedScene, sceneDropdownEditMode))
     {
         sceneDropdownEditMode = !sceneDropdownEditMode;
-        if (!sceneDropdownEditMode && selectedScene >= -1 && selectedScene < static_cast<int>(scenes.size()))
+        if (!sceneDropdownEditMode && selectedScene >= -1 && selectedScene < static_cast<int>(liveScenes.size()))
         {
-            nodes[selectedNode].sceneIndex = selectedScene;
-            TraceLog(LOG_INFO, "Scene selected: %d (%s)", selectedScene,
-                selectedScene >= 0 ? scenes[selectedScene].name.c_str() : "None");
+            nodes[selectedNode].sceneIndex = selectedScene >= 0 ? static_cast<int>(liveScenes[selectedScene]) : -1;
+            linkSceneOf(scenes, nodes, selectedNode);
+            notifyChanged(selectedNode);
+            LogInfo("Scene selected: %d (%s)", nodes[selectedNode].sceneIndex,
+                selectedScene >= 0 ? scenes[liveScenes[selectedScene]].name.c_str() : "None");
         }
     }
 }
@@ -2,6 +2,8 @@
 #define NODE_MANAGER_HPP
 
 #include "Types.hpp"
+#include "ProjectObserver.hpp"
+#include "BasicUI.hpp"
 #include "raylib.h"
 #include "raygui.h"
 #include <vector>
@@ -58,7 +60,7 @@ public:
 class NodeManager : BasicUI
 {
 public:
-    NodeManager(std::vector<Scene>& scenes);
+    NodeManager(SceneMap& scenes);
 
     void update();
 
@@ -68,7 +70,9 @@ public:
 
     void deleteNode(size_t index);
 
-    std::vector<Node>& getNodes() { return nodes; }
+    NodeMap& getNodes() { return nodes; }
+
+    void setObserver(ProjectObserver* observer) { this->observer = observer; }
 
     enum class ConnectionRenderMode {
             SINGLE_POINT,
@@ -85,11 +89,13 @@ private:
     Vector2 getNodeOutputPos(size_t index, size_t connectionIndex);
 
     void drawEditUI();
+    void notifyChanged(size_t index);
 
-    std::vector<Node> nodes;
-    std::vector<Scene>& scenes;
+    NodeMap nodes;
+    SceneMap& scenes;
     Vector2 offset;
     int draggingNode;
+    Vector2 dragStartPosition;
     bool draggingCanvas;
     bool creatingConnection;
     size_t fromNode;
@@ -106,6 +112,7 @@ private:
     bool editChoiceTextFlag;
     bool isEditingChoiceText;
     ConnectionRenderMode connectionRenderMode;
+    ProjectObserver* observer = nullptr;
 
     size_t getIncomingConnectionCount(size_t nodeIndex);
     size_t getIncomingConnectionIndex(size_t targetNodeIndex, size_t sourceNodeIndex, size_t sourceConnIndex);
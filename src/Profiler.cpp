@@ -0,0 +1,174 @@
+#include "Profiler.hpp"
+#include "JsonWriter.hpp"
+#include "Log.hpp"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+constexpr double AVERAGE_WEIGHT = 0.05; // Of the newest frame in FrameStat::average
+constexpr int OVERLAY_FONT_SIZE = 10;
+constexpr int OVERLAY_LINE_HEIGHT = 12;
+
+} // namespace
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : events(EVENT_CAPACITY), frameStart(now()) {}
+
+int64_t Profiler::now() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint32_t Profiler::threadIndex() {
+    std::thread::id id = std::this_thread::get_id();
+    for (size_t i = 0; i < threads.size(); ++i) {
+        if (threads[i] == id) return (uint32_t)i + 1;
+    }
+    threads.push_back(id);
+    return (uint32_t)threads.size();
+}
+
+void Profiler::push(const Event& event) {
+    events[nextEvent] = event;
+    nextEvent = (nextEvent + 1) % EVENT_CAPACITY;
+    if (eventCount < EVENT_CAPACITY) ++eventCount;
+}
+
+Profiler::FrameStat& Profiler::stat(const char* name, bool counter) {
+    for (auto& existing : stats) {
+        if (existing.counter == counter && (existing.name == name || std::strcmp(existing.name, name) == 0)) return existing;
+    }
+    stats.push_back({name, counter, 0.0, 0.0, 0.0});
+    return stats.back();
+}
+
+void Profiler::recordZone(const char* name, int64_t start, int64_t end) {
+    std::lock_guard<std::mutex> lock(mutex);
+    push({name, start, end - start, 0.0, threadIndex(), false});
+    stat(name, false).current += (end - start) / 1000.0;
+}
+
+void Profiler::recordCounter(const char* name, double value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    push({name, now(), 0, value, threadIndex(), true});
+    stat(name, true).current = value;
+}
+
+void Profiler::endFrame() {
+    int64_t end = now();
+    std::lock_guard<std::mutex> lock(mutex);
+    frameThread = threadIndex();
+    push({"Frame", frameStart, end - frameStart, 0.0, frameThread, false});
+    frameMs = (end - frameStart) / 1000.0;
+    frameStart = end;
+    for (auto& frameStat : stats) {
+        frameStat.last = frameStat.current;
+        frameStat.average += (frameStat.last - frameStat.average) * AVERAGE_WEIGHT;
+        if (!frameStat.counter) frameStat.current = 0.0; // Counters keep their last value
+    }
+}
+
+void Profiler::handleHotkeys() {
+    if (IsKeyPressed(OVERLAY_KEY)) {
+        overlayVisible = !overlayVisible;
+    }
+    if (IsKeyPressed(TRACE_KEY)) {
+        if (dumpTrace(DEFAULT_TRACE_PATH)) {
+            LogInfo("Wrote the last %.0f s of profiling to %s", DEFAULT_TRACE_SECONDS, DEFAULT_TRACE_PATH);
+        }
+    }
+}
+
+void Profiler::drawOverlay() const {
+    if (!overlayVisible) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    int lines = 2 + (int)stats.size();
+    int x = 10;
+    int y = 10;
+    DrawRectangle(x - 5, y - 5, 330, lines * OVERLAY_LINE_HEIGHT + 10, Fade(BLACK, 0.7f));
+    DrawText(TextFormat("%d FPS  frame %.2f ms", GetFPS(), frameMs), x, y, OVERLAY_FONT_SIZE, GREEN);
+    y += OVERLAY_LINE_HEIGHT;
+    DrawText("zone / counter            last      avg", x, y, OVERLAY_FONT_SIZE, LIGHTGRAY);
+    y += OVERLAY_LINE_HEIGHT;
+    for (const auto& frameStat : stats) {
+        const char* line = frameStat.counter
+                               ? TextFormat("%-24s %8.0f %8.1f", frameStat.name, frameStat.last, frameStat.average)
+                               : TextFormat("%-24s %6.2f ms %6.2f ms", frameStat.name, frameStat.last, frameStat.average);
+        DrawText(line, x, y, OVERLAY_FONT_SIZE, frameStat.counter ? SKYBLUE : RAYWHITE);
+        y += OVERLAY_LINE_HEIGHT;
+    }
+}
+
+bool Profiler::dumpTrace(const std::string& path, double seconds) {
+    std::vector<Event> recent;
+    size_t threadCount;
+    uint32_t mainThread;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        int64_t since = now() - (int64_t)(seconds * 1e6);
+        recent.reserve(eventCount);
+        size_t first = (nextEvent + EVENT_CAPACITY - eventCount) % EVENT_CAPACITY;
+        for (size_t i = 0; i < eventCount; ++i) {
+            const Event& event = events[(first + i) % EVENT_CAPACITY];
+            if (event.start + event.duration >= since) recent.push_back(event);
+        }
+        threadCount = threads.size();
+        mainThread = frameThread;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        LogWarning("Failed to open file for writing: %s", path.c_str());
+        return false;
+    }
+    {
+        // Keys in sorted order, as JsonWriter expects
+        JsonWriter writer([&](const char* data, size_t size) { file.write(data, size); }, JsonWriter::Style::COMPACT);
+        writer.beginObject();
+        writer.member("displayTimeUnit", "ms");
+        writer.key("traceEvents");
+        writer.beginArray();
+        for (size_t i = 0; i < threadCount; ++i) {
+            writer.beginObject();
+            writer.key("args");
+            writer.beginObject();
+            writer.member("name", i + 1 == mainThread ? std::string("main") : "worker " + std::to_string(i + 1));
+            writer.endObject();
+            writer.member("name", "thread_name");
+            writer.member("ph", "M");
+            writer.member("pid", 1);
+            writer.member("tid", (int)i + 1);
+            writer.endObject();
+        }
+        for (const auto& event : recent) {
+            writer.beginObject();
+            if (event.counter) {
+                writer.key("args");
+                writer.beginObject();
+                writer.member("value", event.value);
+                writer.endObject();
+            } else {
+                writer.member("dur", event.duration);
+            }
+            writer.member("name", event.name);
+            writer.member("ph", event.counter ? "C" : "X");
+            writer.member("pid", 1);
+            writer.member("tid", (int)event.thread);
+            writer.member("ts", event.start);
+            writer.endObject();
+        }
+        writer.endArray();
+        writer.endObject();
+    }
+    file.close();
+    if (file.fail()) {
+        LogWarning("Failed to write file: %s", path.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,122 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include "raylib.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Zones compile to nothing with -DNOVEL_PROFILE=0
+#ifndef NOVEL_PROFILE
+#define NOVEL_PROFILE 1
+#endif
+
+// Frame profiler: timed zones (PROFILE_ZONE) and per-frame counters from any
+// thread go into a ring holding the last few seconds. The main loop calls
+// endFrame() once per frame, which totals the frame's zones for the overlay
+// (F3) and keeps the ring for dumpTrace() (F4), a Chrome trace_event file to
+// open in chrome://tracing or Perfetto. rlgl keeps its draw-call and batch
+// counts to itself, so the overlay shows what the app reports instead
+// (Render's draw commands, texture uploads).
+class Profiler
+{
+public:
+    static constexpr size_t EVENT_CAPACITY = 1 << 16; // ~10 s of a busy editor frame at 60 FPS
+    static constexpr double DEFAULT_TRACE_SECONDS = 10.0;
+    static constexpr const char* DEFAULT_TRACE_PATH = "profile.trace.json";
+    static constexpr int OVERLAY_KEY = KEY_F3;
+    static constexpr int TRACE_KEY = KEY_F4;
+
+    static Profiler& instance();
+
+    // Microseconds on the clock zones are timed with
+    static int64_t now();
+
+    void recordZone(const char* name, int64_t start, int64_t end);
+    // A value sampled this frame (draw commands, uploads, ...): shown in the
+    // overlay and written as a trace counter
+    void recordCounter(const char* name, double value);
+
+    // Call once per frame, after EndDrawing(): totals the frame just drawn
+    void endFrame();
+    // Overlay and dump hotkeys; call once per frame
+    void handleHotkeys();
+    // Call between BeginDrawing() and EndDrawing(), last
+    void drawOverlay() const;
+    bool isOverlayVisible() const { return overlayVisible; }
+    void setOverlayVisible(bool visible) { overlayVisible = visible; }
+
+    // Write the last `seconds` of zones and counters as Chrome trace JSON
+    bool dumpTrace(const std::string& path, double seconds = DEFAULT_TRACE_SECONDS);
+
+private:
+    struct Event
+    {
+        const char* name; // String literal, compared by content
+        int64_t start;    // us
+        int64_t duration; // us; counters: 0
+        double value;     // Counters only
+        uint32_t thread;
+        bool counter;
+    };
+
+    // One zone's or counter's share of a frame
+    struct FrameStat
+    {
+        const char* name;
+        bool counter;
+        double current;  // This frame so far: ms, or the last value
+        double last;     // Previous frame
+        double average;  // Smoothed over recent frames
+    };
+
+    Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    uint32_t threadIndex();
+    void push(const Event& event);
+    FrameStat& stat(const char* name, bool counter);
+
+    mutable std::mutex mutex;
+    std::vector<Event> events; // Ring of EVENT_CAPACITY
+    size_t nextEvent = 0;
+    size_t eventCount = 0;
+    std::vector<FrameStat> stats; // In first-seen order
+    std::vector<std::thread::id> threads; // Index = trace tid - 1
+    uint32_t frameThread = 0;             // tid of the thread calling endFrame()
+    int64_t frameStart;
+    double frameMs = 0.0;
+    bool overlayVisible = false;
+};
+
+// Times the enclosing scope
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char* name) : name(name), start(Profiler::now()) {}
+    ~ProfileZone() { Profiler::instance().recordZone(name, start, Profiler::now()); }
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name;
+    int64_t start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if NOVEL_PROFILE
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_COUNTER(name, value) Profiler::instance().recordCounter(name, (double)(value))
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_COUNTER(name, value) ((void)0)
+#endif
+
+#endif // PROFILER_HPP
@@ -0,0 +1,285 @@
+#include "ProjectBinary.hpp"
+#include "Log.hpp"
+#include <cstring>
+
+namespace ProjectBinary {
+
+namespace {
+
+const char MAGIC[4] = {'N', 'C', 'P', 'J'};
+
+static_assert(sizeof(Header) == 136 && sizeof(ElementRecord) == 40 && sizeof(ImageRecord) == 40 &&
+              sizeof(VariantRecord) == 24 && sizeof(SceneRecord) == 16 && sizeof(SceneElementRecord) == 28 &&
+              sizeof(NodeRecord) == 40 && sizeof(ConnectionRecord) == 12,
+              "Project records must not be padded");
+
+template <typename T>
+Section append(std::string& out, const std::vector<T>& records) {
+    out.resize((out.size() + 7) & ~size_t(7), '\0');
+    Section section = {out.size(), records.size()};
+    out.append((const char*)records.data(), records.size() * sizeof(T));
+    return section;
+}
+
+// Points table at the section if it lies inside the file and is aligned for T
+template <typename T>
+bool locate(const unsigned char* data, size_t size, const Section& section, const T*& table) {
+    if (section.offset % alignof(T) != 0 || section.offset > size ||
+        section.count > (size - section.offset) / sizeof(T)) {
+        return false;
+    }
+    table = (const T*)(data + section.offset);
+    return true;
+}
+
+bool inRange(uint64_t first, uint64_t count, uint64_t total) {
+    return first <= total && count <= total - first;
+}
+
+} // namespace
+
+Writer::Writer() {
+    intern(""); // Offset 0 is the empty string, so zeroed refs are valid
+}
+
+StringRef Writer::intern(const std::string& text) {
+    auto it = interned.find(text);
+    if (it != interned.end()) return it->second;
+    StringRef ref = {(uint32_t)strings.size(), (uint32_t)text.size()};
+    strings += text;
+    interned.emplace(text, ref);
+    return ref;
+}
+
+void Writer::addElement(const Element& element) {
+    ElementRecord record = {};
+    record.type = (uint32_t)element.type;
+    record.name = intern(element.name);
+    record.firstImage = (uint32_t)images.size();
+    record.firstVariant = (uint32_t)variants.size();
+    switch (element.type) {
+    case ElementType::TEXT:
+        record.text = intern(std::get<TextElement>(element.data).content);
+        break;
+    case ElementType::CHARACTER: {
+        const auto& character = std::get<CharacterElement>(element.data);
+        record.text = intern(character.name);
+        record.positionIndex = character.positionIndex;
+        for (size_t i = 0; i < character.images.size(); ++i) {
+            ImageRecord image = {};
+            image.pose = intern(character.images[i].first);
+            image.path = intern(character.images[i].second);
+            if (i < character.atlasRects.size()) {
+                const Rectangle& rect = character.atlasRects[i];
+                image.rect[0] = rect.x;
+                image.rect[1] = rect.y;
+                image.rect[2] = rect.width;
+                image.rect[3] = rect.height;
+            }
+            if (i < character.sourceSizes.size()) {
+                image.sourceSize[0] = character.sourceSizes[i].x;
+                image.sourceSize[1] = character.sourceSizes[i].y;
+            }
+            images.push_back(image);
+        }
+        record.imageCount = (uint32_t)character.images.size();
+        break;
+    }
+    case ElementType::BACKGROUND:
+        record.text = intern(std::get<BackgroundElement>(element.data).imagePath);
+        break;
+    }
+    elements.push_back(record);
+}
+
+void Writer::addVariant(int targetWidth, int targetHeight, const std::string& path, int width, int height) {
+    if (elements.empty()) return;
+    variants.push_back({targetWidth, targetHeight, width, height, intern(path)});
+    ++elements.back().variantCount;
+}
+
+void Writer::addScene(const Scene& scene, const ElementMap& elementMap, const SavedIndices& indices) {
+    scenes.push_back({intern(scene.name), (uint32_t)sceneElements.size(), 0});
+    for (const auto& sceneElement : scene.elements) {
+        size_t element = savedElement(elementMap, indices, sceneElement);
+        if (element == ElementMap::NONE) continue;
+        sceneElements.push_back({(uint32_t)element, sceneElement.startTime, sceneElement.endTime,
+                                 sceneElement.renderlevel, sceneElement.positionIndex,
+                                 intern(sceneElement.selectedPose)});
+    }
+    scenes.back().elementCount = (uint32_t)(sceneElements.size() - scenes.back().firstElement);
+}
+
+void Writer::addNode(const Node& node, const SceneMap& sceneMap, const NodeMap& nodeMap, const SavedIndices& indices) {
+    NodeRecord record = {};
+    record.name = intern(node.name);
+    record.sceneIndex = savedScene(sceneMap, indices, node);
+    record.firstConnection = (uint32_t)connections.size();
+    record.position[0] = node.position.x;
+    record.position[1] = node.position.y;
+    record.dragType = (uint32_t)node.dragType;
+    record.color[0] = node.color.r;
+    record.color[1] = node.color.g;
+    record.color[2] = node.color.b;
+    record.color[3] = node.color.a;
+    record.isStartNode = node.isStartNode ? 1 : 0;
+    nodes.push_back(record);
+    for (const auto& conn : node.connections) {
+        size_t target = savedTarget(nodeMap, indices.nodes, conn);
+        if (target == NodeMap::NONE) continue;
+        connections.push_back({(uint32_t)target, intern(conn.choiceText)});
+    }
+    nodes.back().connectionCount = (uint32_t)(connections.size() - nodes.back().firstConnection);
+}
+
+std::string Writer::finish() const {
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+
+    std::string out(sizeof(Header), '\0');
+    header.elements = append(out, elements);
+    header.images = append(out, images);
+    header.variants = append(out, variants);
+    header.scenes = append(out, scenes);
+    header.sceneElements = append(out, sceneElements);
+    header.nodes = append(out, nodes);
+    header.connections = append(out, connections);
+    header.strings = {out.size(), strings.size()};
+    out += strings;
+    std::memcpy(&out[0], &header, sizeof(header));
+    return out;
+}
+
+bool View::open(const unsigned char* data, size_t size) {
+    *this = View();
+    Header header;
+    const char* stringTable = nullptr;
+    bool valid = data != nullptr && (uintptr_t)data % 8 == 0 && size >= sizeof(header);
+    if (valid) {
+        std::memcpy(&header, data, sizeof(header));
+        valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION &&
+                locate(data, size, header.elements, elements) && locate(data, size, header.images, images) &&
+                locate(data, size, header.variants, variants) && locate(data, size, header.scenes, scenes) &&
+                locate(data, size, header.sceneElements, sceneElements) &&
+                locate(data, size, header.nodes, nodes) && locate(data, size, header.connections, connections) &&
+                locate(data, size, header.strings, stringTable);
+    }
+    if (!valid) {
+        LogWarning("Not a valid project binary (version %u expected)", VERSION);
+        return false;
+    }
+
+    // Check every range and string once here so the accessors can trust them
+    uint64_t stringsSize = header.strings.count;
+    auto stringOk = [&](StringRef ref) { return inRange(ref.offset, ref.length, stringsSize); };
+    for (uint64_t i = 0; valid && i < header.elements.count; ++i) {
+        const ElementRecord& e = elements[i];
+        valid = e.type <= (uint32_t)ElementType::BACKGROUND && stringOk(e.name) && stringOk(e.text) &&
+                inRange(e.firstImage, e.imageCount, header.images.count) &&
+                inRange(e.firstVariant, e.variantCount, header.variants.count);
+    }
+    for (uint64_t i = 0; valid && i < header.images.count; ++i) {
+        valid = stringOk(images[i].pose) && stringOk(images[i].path);
+    }
+    for (uint64_t i = 0; valid && i < header.variants.count; ++i) {
+        valid = stringOk(variants[i].path);
+    }
+    for (uint64_t i = 0; valid && i < header.scenes.count; ++i) {
+        valid = stringOk(scenes[i].name) &&
+                inRange(scenes[i].firstElement, scenes[i].elementCount, header.sceneElements.count);
+    }
+    for (uint64_t i = 0; valid && i < header.sceneElements.count; ++i) {
+        valid = stringOk(sceneElements[i].selectedPose);
+    }
+    for (uint64_t i = 0; valid && i < header.nodes.count; ++i) {
+        valid = stringOk(nodes[i].name) &&
+                inRange(nodes[i].firstConnection, nodes[i].connectionCount, header.connections.count);
+    }
+    for (uint64_t i = 0; valid && i < header.connections.count; ++i) {
+        valid = stringOk(connections[i].choiceText);
+    }
+    if (!valid) {
+        LogWarning("Project binary is corrupt");
+        *this = View();
+        return false;
+    }
+
+    strings = stringTable;
+    elementCount = (size_t)header.elements.count;
+    sceneCount = (size_t)header.scenes.count;
+    nodeCount = (size_t)header.nodes.count;
+    return true;
+}
+
+Element View::getElement(size_t i) const {
+    const ElementRecord& record = elements[i];
+    Element element;
+    element.type = (ElementType)record.type;
+    element.name = getString(record.name);
+    switch (element.type) {
+    case ElementType::TEXT:
+        element.data = TextElement{std::string(getString(record.text))};
+        break;
+    case ElementType::CHARACTER: {
+        CharacterElement character;
+        character.name = getString(record.text);
+        character.positionIndex = record.positionIndex;
+        character.images.reserve(record.imageCount);
+        character.atlasRects.reserve(record.imageCount);
+        character.sourceSizes.reserve(record.imageCount);
+        for (uint32_t k = 0; k < record.imageCount; ++k) {
+            const ImageRecord& image = images[record.firstImage + k];
+            character.images.emplace_back(getString(image.pose), getString(image.path));
+            character.atlasRects.push_back({image.rect[0], image.rect[1], image.rect[2], image.rect[3]});
+            character.sourceSizes.push_back({image.sourceSize[0], image.sourceSize[1]});
+        }
+        character.internPoses();
+        element.data = std::move(character);
+        break;
+    }
+    case ElementType::BACKGROUND: {
+        BackgroundElement background;
+        background.imagePath = getString(record.text);
+        element.data = std::move(background);
+        break;
+    }
+    }
+    return element;
+}
+
+Scene View::getScene(size_t i) const {
+    const SceneRecord& record = scenes[i];
+    Scene scene;
+    scene.name = getString(record.name);
+    scene.elements.resize(record.elementCount);
+    for (uint32_t k = 0; k < record.elementCount; ++k) {
+        const SceneElementRecord& se = sceneElements[record.firstElement + k];
+        SceneElement& sceneElement = scene.elements[k];
+        sceneElement.elementIndex = se.elementIndex;
+        sceneElement.startTime = se.startTime;
+        sceneElement.endTime = se.endTime;
+        sceneElement.renderlevel = se.renderlevel;
+        sceneElement.positionIndex = se.positionIndex;
+        sceneElement.setPose(std::string(getString(se.selectedPose)));
+    }
+    return scene;
+}
+
+Node View::getNode(size_t i) const {
+    const NodeRecord& record = nodes[i];
+    Node node(std::string(getString(record.name)), record.sceneIndex);
+    node.position = {record.position[0], record.position[1]};
+    node.dragType = (DragType)record.dragType;
+    node.color = {record.color[0], record.color[1], record.color[2], record.color[3]};
+    node.isStartNode = record.isStartNode != 0;
+    node.connections.resize(record.connectionCount);
+    for (uint32_t k = 0; k < record.connectionCount; ++k) {
+        const ConnectionRecord& conn = connections[record.firstConnection + k];
+        node.connections[k].toNodeIndex = conn.toNodeIndex;
+        node.connections[k].choiceText = getString(conn.choiceText);
+    }
+    return node;
+}
+
+} // namespace ProjectBinary
@@ -0,0 +1,186 @@
+#ifndef PROJECT_BINARY_HPP
+#define PROJECT_BINARY_HPP
+
+#include "Types.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Binary twin of an exported project.json that the renderer reads straight
+// from a mapping: no tokenizing, no DOM, one allocation per output string.
+//
+// Layout, all integers little-endian:
+//   Header    magic "NCPJ", version, then one Section (offset, count) per table
+//   Tables    flat arrays of the fixed-size records below, each 8-byte aligned,
+//             in Header order; child records are referenced as (first, count)
+//             ranges into the next table down
+//   Strings   every string once, referenced by StringRef (offset, length)
+//
+// Bump VERSION whenever a record changes; readers reject other versions and
+// the renderer falls back to project.json.
+namespace ProjectBinary
+{
+    constexpr const char* FILE_NAME = "project.bin";
+    constexpr uint32_t VERSION = 1;
+
+    struct StringRef
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct Section
+    {
+        uint64_t offset;
+        uint64_t count; // Records, or bytes for the string table
+    };
+
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        Section elements;
+        Section images;
+        Section variants;
+        Section scenes;
+        Section sceneElements;
+        Section nodes;
+        Section connections;
+        Section strings;
+    };
+
+    struct ElementRecord
+    {
+        uint32_t type;         // ElementType
+        StringRef name;
+        StringRef text;        // Text content, character name or background image path
+        int32_t positionIndex;
+        uint32_t firstImage;   // Character poses
+        uint32_t imageCount;
+        uint32_t firstVariant; // Background variants
+        uint32_t variantCount;
+    };
+
+    struct ImageRecord
+    {
+        StringRef pose;
+        StringRef path;
+        float rect[4];       // Atlas region; zero width = whole texture
+        float sourceSize[2]; // Zero = source rect size
+    };
+
+    struct VariantRecord
+    {
+        int32_t targetWidth;
+        int32_t targetHeight;
+        int32_t width;
+        int32_t height;
+        StringRef path;
+    };
+
+    struct SceneRecord
+    {
+        StringRef name;
+        uint32_t firstElement;
+        uint32_t elementCount;
+    };
+
+    struct SceneElementRecord
+    {
+        uint32_t elementIndex;
+        float startTime;
+        float endTime;
+        int32_t renderlevel;
+        int32_t positionIndex;
+        StringRef selectedPose;
+    };
+
+    struct NodeRecord
+    {
+        StringRef name;
+        int32_t sceneIndex;
+        uint32_t firstConnection;
+        uint32_t connectionCount;
+        float position[2];
+        uint32_t dragType;   // DragType
+        uint8_t color[4];
+        uint32_t isStartNode;
+    };
+
+    struct ConnectionRecord
+    {
+        uint32_t toNodeIndex;
+        StringRef choiceText;
+    };
+
+    // Builds the file in memory. Add elements, scenes and nodes in project order.
+    class Writer
+    {
+    public:
+        Writer();
+
+        void addElement(const Element& element);
+        // Attaches a background variant to the element added last
+        void addVariant(int targetWidth, int targetHeight, const std::string& path, int width, int height);
+        // Scenes and nodes are added in saved order; references are written as
+        // their targets' saved indices (SavedIndices) and those into erased
+        // elements or nodes are left out, as in project.json
+        void addScene(const Scene& scene, const ElementMap& elementMap, const SavedIndices& indices);
+        void addNode(const Node& node, const SceneMap& sceneMap, const NodeMap& nodeMap, const SavedIndices& indices);
+
+        std::string finish() const;
+
+    private:
+        StringRef intern(const std::string& text);
+
+        std::vector<ElementRecord> elements;
+        std::vector<ImageRecord> images;
+        std::vector<VariantRecord> variants;
+        std::vector<SceneRecord> scenes;
+        std::vector<SceneElementRecord> sceneElements;
+        std::vector<NodeRecord> nodes;
+        std::vector<ConnectionRecord> connections;
+        std::string strings;
+        std::unordered_map<std::string, StringRef> interned;
+    };
+
+    // Validated view of a mapped file. Records are used in place; every range
+    // and StringRef is bounds-checked by open(), so the accessors don't check.
+    class View
+    {
+    public:
+        // False (with a warning) if data is not a valid file of this VERSION.
+        // data must be 8-byte aligned and outlive the view.
+        bool open(const unsigned char* data, size_t size);
+
+        size_t getElementCount() const { return elementCount; }
+        size_t getSceneCount() const { return sceneCount; }
+        size_t getNodeCount() const { return nodeCount; }
+
+        const ElementRecord& getElementRecord(size_t i) const { return elements[i]; }
+        const VariantRecord* getVariants(const ElementRecord& element) const { return variants + element.firstVariant; }
+        std::string_view getString(StringRef ref) const { return std::string_view(strings + ref.offset, ref.length); }
+
+        Element getElement(size_t i) const;
+        Scene getScene(size_t i) const;
+        Node getNode(size_t i) const;
+
+    private:
+        const ElementRecord* elements = nullptr;
+        const ImageRecord* images = nullptr;
+        const VariantRecord* variants = nullptr;
+        const SceneRecord* scenes = nullptr;
+        const SceneElementRecord* sceneElements = nullptr;
+        const NodeRecord* nodes = nullptr;
+        const ConnectionRecord* connections = nullptr;
+        const char* strings = nullptr;
+        size_t elementCount = 0;
+        size_t sceneCount = 0;
+        size_t nodeCount = 0;
+    };
+}
+
+#endif // PROJECT_BINARY_HPP
@@ -0,0 +1,721 @@
+#include "ProjectJson.hpp"
+#include "GraphicsBackend.hpp"
+#include "MappedFile.hpp"
+#include <fstream>
+#include <stdexcept>
+
+namespace JsonUtils
+{
+    json colorToJson(const Color& color)
+    {
+        json j;
+        j["r"] = color.r;
+        j["g"] = color.g;
+        j["b"] = color.b;
+        j["a"] = color.a;
+        return j;
+    }
+
+    Color jsonToColor(const json& j)
+    {
+        return CLITERAL(Color){
+            static_cast<unsigned char>(j.value("r", 200)),
+            static_cast<unsigned char>(j.value("g", 200)),
+            static_cast<unsigned char>(j.value("b", 200)),
+            static_cast<unsigned char>(j.value("a", 255))
+        };
+    }
+
+    json rectangleToJson(const Rectangle& rect)
+    {
+        json j;
+        j["x"] = rect.x;
+        j["y"] = rect.y;
+        j["width"] = rect.width;
+        j["height"] = rect.height;
+        return j;
+    }
+
+    Rectangle jsonToRectangle(const json& j)
+    {
+        return Rectangle{
+            j.value("x", 0.0f),
+            j.value("y", 0.0f),
+            j.value("width", 0.0f),
+            j.value("height", 0.0f)
+        };
+    }
+
+    json elementToJson(const Element& element)
+    {
+        json j;
+        j["type"] = static_cast<int>(element.type);
+        j["name"] = element.name;
+
+        switch (element.type)
+        {
+            case ElementType::TEXT:
+            {
+                auto& text = std::get<TextElement>(element.data);
+                j["data"]["content"] = text.content;
+                break;
+            }
+            case ElementType::CHARACTER:
+            {
+                auto& character = std::get<CharacterElement>(element.data);
+                j["data"]["name"] = character.name;
+                j["data"]["positionIndex"] = character.positionIndex;
+                j["data"]["images"] = json::array();
+                for (size_t i = 0; i < character.images.size(); ++i)
+                {
+                    json img;
+                    img["pose"] = character.images[i].first;
+                    img["path"] = character.images[i].second;
+                    if (i < character.atlasRects.size() && character.atlasRects[i].width > 0)
+                    {
+                        img["rect"] = rectangleToJson(character.atlasRects[i]);
+                    }
+                    if (i < character.sourceSizes.size() && character.sourceSizes[i].x > 0)
+                    {
+                        img["sourceSize"] = {{"width", character.sourceSizes[i].x}, {"height", character.sourceSizes[i].y}};
+                    }
+                    j["data"]["images"].push_back(img);
+                }
+                break;
+            }
+            case ElementType::BACKGROUND:
+            {
+                auto& background = std::get<BackgroundElement>(element.data);
+                j["data"]["imagePath"] = background.imagePath;
+                break;
+            }
+        }
+        return j;
+    }
+
+    Element jsonToElement(const json& j)
+    {
+        Element element;
+        element.type = static_cast<ElementType>(j.value("type", 0));
+        element.name = j.value("name", "New Element");
+
+        if (j.contains("data"))
+        {
+            switch (element.type)
+            {
+                case ElementType::TEXT:
+                {
+                    TextElement text;
+                    text.content = j["data"].value("content", "");
+                    element.data = text;
+                    break;
+                }
+                case ElementType::CHARACTER:
+                {
+                    CharacterElement character;
+                    character.name = j["data"].value("name", "");
+                    character.positionIndex = j["data"].value("positionIndex", 0);
+                    if (j["data"].contains("images"))
+                    {
+                        for (const auto& img : j["data"]["images"])
+                        {
+                            character.images.emplace_back(
+                                img.value("pose", ""),
+                                img.value("path", "")
+                            );
+                            character.atlasRects.push_back(img.contains("rect") ? jsonToRectangle(img["rect"]) : Rectangle{0, 0, 0, 0});
+                            character.sourceSizes.push_back(img.contains("sourceSize")
+                                ? Vector2{img["sourceSize"].value("width", 0.0f), img["sourceSize"].value("height", 0.0f)}
+                                : Vector2{0, 0});
+                        }
+                    }
+                    character.internPoses();
+                    element.data = character;
+                    break;
+                }
+                case ElementType::BACKGROUND:
+                {
+                    BackgroundElement background;
+                    background.imagePath = j["data"].value("imagePath", "");
+                    element.data = background;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            element.data = TextElement{""};
+        }
+        return element;
+    }
+
+    json sceneToJson(const Scene& scene)
+    {
+        json j;
+        j["name"] = scene.name;
+        j["elements"] = json::array();
+        for (const auto& sceneElement : scene.elements)
+        {
+            json se;
+            se["elementIndex"] = sceneElement.elementIndex;
+            se["startTime"] = sceneElement.startTime;
+            se["endTime"] = sceneElement.endTime;
+            se["renderlevel"] = sceneElement.renderlevel;
+            se["selectedPose"] = sceneElement.selectedPose;
+            j["elements"].push_back(se);
+        }
+        return j;
+    }
+
+    Scene jsonToScene(const json& j)
+    {
+        Scene scene;
+        scene.name = j.value("name", "");
+        if (j.contains("elements"))
+        {
+            for (const auto& se : j["elements"])
+            {
+                SceneElement sceneElement;
+                sceneElement.elementIndex = se.value("elementIndex", 0);
+                sceneElement.startTime = se.value("startTime", 0.0f);
+                sceneElement.endTime = se.value("endTime", 1.0f);
+                sceneElement.renderlevel = se.value("renderlevel", 0);
+                sceneElement.setPose(se.value("selectedPose", ""));
+                scene.elements.push_back(sceneElement);
+            }
+        }
+        return scene;
+    }
+
+    json nodeToJson(const Node& node)
+    {
+        json j;
+        j["name"] = node.name;
+        j["sceneIndex"] = node.sceneIndex;
+        j["position"]["x"] = node.position.x;
+        j["position"]["y"] = node.position.y;
+        j["dragType"] = static_cast<int>(node.dragType);
+        j["color"] = colorToJson(node.color);
+        j["isStartNode"] = node.isStartNode;
+        j["connections"] = json::array();
+        for (const auto& conn : node.connections)
+        {
+            json c;
+            c["toNodeIndex"] = conn.toNodeIndex;
+            c["choiceText"] = conn.choiceText;
+            j["connections"].push_back(c);
+        }
+        return j;
+    }
+
+    Node jsonToNode(const json& j)
+    {
+        Node node;
+        node.name = j.value("name", "Node");
+        node.sceneIndex = j.value("sceneIndex", -1);
+        node.position.x = j["position"].value("x", 0.0f);
+        node.position.y = j["position"].value("y", 0.0f);
+        node.dragType = static_cast<DragType>(j.value("dragType", 0));
+        node.color = j.contains("color") ? jsonToColor(j["color"]) : CLITERAL(Color){200, 200, 200, 255};
+        node.isStartNode = j.value("isStartNode", false);
+        if (j.contains("connections"))
+        {
+            for (const auto& c : j["connections"])
+            {
+                NodeConnection conn;
+                conn.toNodeIndex = c.value("toNodeIndex", 0);
+                conn.choiceText = c.value("choiceText", "");
+                node.connections.push_back(conn);
+            }
+        }
+        return node;
+    }
+
+    void writeRectangle(JsonWriter& writer, const Rectangle& rect)
+    {
+        writer.beginObject();
+        writer.member("height", rect.height);
+        writer.member("width", rect.width);
+        writer.member("x", rect.x);
+        writer.member("y", rect.y);
+        writer.endObject();
+    }
+
+    void writeElement(JsonWriter& writer, const Element& element, const std::vector<BackgroundVariant>& variants)
+    {
+        writer.beginObject();
+        writer.key("data");
+        writer.beginObject();
+        switch (element.type)
+        {
+            case ElementType::TEXT:
+            {
+                writer.member("content", std::get<TextElement>(element.data).content);
+                break;
+            }
+            case ElementType::CHARACTER:
+            {
+                auto& character = std::get<CharacterElement>(element.data);
+                writer.key("images");
+                writer.beginArray();
+                for (size_t i = 0; i < character.images.size(); ++i)
+                {
+                    writer.beginObject();
+                    writer.member("path", character.images[i].second);
+                    writer.member("pose", character.images[i].first);
+                    if (i < character.atlasRects.size() && character.atlasRects[i].width > 0)
+                    {
+                        writer.key("rect");
+                        writeRectangle(writer, character.atlasRects[i]);
+                    }
+                    if (i < character.sourceSizes.size() && character.sourceSizes[i].x > 0)
+                    {
+                        writer.key("sourceSize");
+                        writer.beginObject();
+                        writer.member("height", character.sourceSizes[i].y);
+                        writer.member("width", character.sourceSizes[i].x);
+                        writer.endObject();
+                    }
+                    writer.endObject();
+                }
+                writer.endArray();
+                writer.member("name", character.name);
+                writer.member("positionIndex", character.positionIndex);
+                break;
+            }
+            case ElementType::BACKGROUND:
+            {
+                writer.member("imagePath", std::get<BackgroundElement>(element.data).imagePath);
+                if (!variants.empty())
+                {
+                    writer.key("variants");
+                    writer.beginArray();
+                    for (const auto& variant : variants)
+                    {
+                        writer.beginObject();
+                        writer.member("height", variant.height);
+                        writer.member("path", variant.fileName);
+                        writer.member("targetHeight", variant.target.height);
+                        writer.member("targetWidth", variant.target.width);
+                        writer.member("width", variant.width);
+                        writer.endObject();
+                    }
+                    writer.endArray();
+                }
+                break;
+            }
+        }
+        writer.endObject();
+        writer.member("name", element.name);
+        writer.member("type", static_cast<int>(element.type));
+        writer.endObject();
+    }
+
+    void writeScene(JsonWriter& writer, const Scene& scene, const ElementMap& elements, const SavedIndices& indices)
+    {
+        writer.beginObject();
+        writer.key("elements");
+        writer.beginArray();
+        for (const auto& sceneElement : scene.elements)
+        {
+            size_t element = savedElement(elements, indices, sceneElement);
+            if (element == ElementMap::NONE) continue;
+            writer.beginObject();
+            writer.member("elementIndex", (uint64_t)element);
+            writer.member("endTime", sceneElement.endTime);
+            writer.member("renderlevel", sceneElement.renderlevel);
+            writer.member("selectedPose", sceneElement.selectedPose);
+            writer.member("startTime", sceneElement.startTime);
+            writer.endObject();
+        }
+        writer.endArray();
+        writer.member("name", scene.name);
+        writer.endObject();
+    }
+
+    void writeNode(JsonWriter& writer, const Node& node, const SceneMap& scenes, const NodeMap& nodes, const SavedIndices& indices)
+    {
+        writer.beginObject();
+        writer.key("color");
+        writer.beginObject();
+        writer.member("a", (uint64_t)node.color.a);
+        writer.member("b", (uint64_t)node.color.b);
+        writer.member("g", (uint64_t)node.color.g);
+        writer.member("r", (uint64_t)node.color.r);
+        writer.endObject();
+        writer.key("connections");
+        writer.beginArray();
+        for (const auto& conn : node.connections)
+        {
+            size_t target = savedTarget(nodes, indices.nodes, conn);
+            if (target == NodeMap::NONE) continue;
+            writer.beginObject();
+            writer.member("choiceText", conn.choiceText);
+            writer.member("toNodeIndex", (uint64_t)target);
+            writer.endObject();
+        }
+        writer.endArray();
+        writer.member("dragType", static_cast<int>(node.dragType));
+        writer.member("isStartNode", node.isStartNode);
+        writer.member("name", node.name);
+        writer.key("position");
+        writer.beginObject();
+        writer.member("x", node.position.x);
+        writer.member("y", node.position.y);
+        writer.endObject();
+        writer.member("sceneIndex", savedScene(scenes, indices, node));
+        writer.endObject();
+    }
+
+    // Write the live slots of items with writeItem; in SLOTS mode erased slots
+    // become placeholders that keep their index, which readProject erases again
+    template <typename T>
+    void writeSlots(JsonWriter& writer, const SlotMap<T>& items, SlotIndexing indexing, const std::function<void(size_t)>& writeItem)
+    {
+        writer.beginArray();
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            if (items.isAlive(i))
+            {
+                writeItem(i);
+            }
+            else if (indexing == SlotIndexing::SLOTS)
+            {
+                writer.beginObject();
+                writer.member("erased", true);
+                writer.endObject();
+            }
+        }
+        writer.endArray();
+    }
+
+    void writeProject(JsonWriter& writer, const ElementMap& elements, const std::function<void(JsonWriter&, size_t)>& writeElement,
+                      const SceneMap& scenes, const NodeMap& nodes, SlotIndexing indexing)
+    {
+        SavedIndices indices(elements, scenes, nodes, indexing);
+        writer.beginObject();
+        writer.key("elements");
+        writeSlots(writer, elements, indexing, [&](size_t i) { writeElement(writer, i); });
+        writer.key("nodes");
+        writeSlots(writer, nodes, indexing, [&](size_t i) { writeNode(writer, nodes[i], scenes, nodes, indices); });
+        writer.key("scenes");
+        writeSlots(writer, scenes, indexing, [&](size_t i) { writeScene(writer, scenes[i], elements, indices); });
+        writer.endObject();
+        writer.flush();
+    }
+
+    void writeProject(JsonWriter& writer, const ElementMap& elements, const SceneMap& scenes, const NodeMap& nodes,
+                      SlotIndexing indexing)
+    {
+        writeProject(writer, elements, [&](JsonWriter& w, size_t i) { writeElement(w, elements[i]); }, scenes, nodes, indexing);
+    }
+
+    void exportToFile(const ElementMap& elements, const SceneMap& scenes, const NodeMap& nodes, const std::string& filename,
+                      JsonWriter::Style style)
+    {
+        std::ofstream file(filename);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open file for writing: " + filename);
+        }
+        JsonWriter writer([&](const char* data, size_t size) { file.write(data, size); }, style);
+        writeProject(writer, elements, scenes, nodes);
+        file.close();
+        if (file.fail())
+        {
+            throw std::runtime_error("Failed to write file: " + filename);
+        }
+    }
+
+    std::string selectBackgroundVariant(const std::vector<BackgroundVariant>& variants, int screenWidth, int screenHeight, const std::string& fallback)
+    {
+        std::string selected = fallback;
+        long long selectedArea = -1;
+        bool selectedCovers = false;
+        for (const auto& variant : variants)
+        {
+            if (variant.fileName.empty()) continue;
+            long long area = (long long)variant.target.width * variant.target.height;
+            bool covers = variant.target.width >= screenWidth && variant.target.height >= screenHeight;
+            bool better = selectedArea < 0 ||
+                          (covers && (!selectedCovers || area < selectedArea)) ||
+                          (!covers && !selectedCovers && area > selectedArea);
+            if (better)
+            {
+                selected = variant.fileName;
+                selectedArea = area;
+                selectedCovers = covers;
+            }
+        }
+        return selected;
+    }
+
+    std::vector<BackgroundVariant> jsonToBackgroundVariants(const json& variants)
+    {
+        std::vector<BackgroundVariant> result;
+        for (const auto& variant : variants)
+        {
+            result.push_back({{variant.value("targetWidth", 0), variant.value("targetHeight", 0)},
+                              variant.value("path", ""), variant.value("width", 0), variant.value("height", 0)});
+        }
+        return result;
+    }
+
+    std::string preferCompressed(const fs::path& path)
+    {
+        fs::path ddsPath = fs::path(path).replace_extension(".dds");
+        std::error_code ec;
+        return fs::exists(ddsPath, ec) ? ddsPath.string() : path.string();
+    }
+
+    void loadTextures(ElementMap& elements)
+    {
+        GraphicsBackend* backend = GraphicsBackend::get();
+        if (backend == nullptr) return;
+        for (auto& element : elements)
+        {
+            if (element.type == ElementType::CHARACTER)
+            {
+                auto& character = std::get<CharacterElement>(element.data);
+                character.textures.clear();
+                for (const auto& img : character.images)
+                {
+                    character.textures.push_back(backend->acquireTexture(img.second));
+                }
+            }
+            else if (element.type == ElementType::BACKGROUND)
+            {
+                auto& background = std::get<BackgroundElement>(element.data);
+                background.texture = backend->acquireTexture(background.imagePath);
+            }
+        }
+    }
+
+    void readProject(const std::function<void(ProjectSaxReader&)>& parse,
+                     ElementMap& elements, SceneMap& scenes, NodeMap& nodes,
+                     const std::function<void(Element&, const json&)>& adjust)
+    {
+        // Erased slots (edit journal snapshots) are kept so later indices stay put
+        auto isErased = [](const json& j) { return j.is_object() && j.value("erased", false); };
+        ProjectSaxReader reader(
+            [&](const json& je)
+            {
+                bool erased = isErased(je);
+                Element element = erased ? Element() : jsonToElement(je);
+                if (adjust && !erased)
+                {
+                    adjust(element, je);
+                }
+                elements.push_back(std::move(element));
+                if (erased) elements.erase(elements.size() - 1);
+            },
+            [&](const json& js)
+            {
+                bool erased = isErased(js);
+                scenes.push_back(erased ? Scene() : jsonToScene(js));
+                if (erased) scenes.erase(scenes.size() - 1);
+            },
+            [&](const json& jn)
+            {
+                bool erased = isErased(jn);
+                nodes.push_back(erased ? Node() : jsonToNode(jn));
+                if (erased) nodes.erase(nodes.size() - 1);
+            });
+        parse(reader);
+    }
+
+    void importFromFile(ElementMap& elements, SceneMap& scenes, NodeMap& nodes, const std::string& filename, bool loadImages)
+    {
+        std::ifstream file(filename);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open file for reading: " + filename);
+        }
+
+        // Nothing is replaced until the whole file has been read
+        ElementMap imported;
+        SceneMap importedScenes;
+        NodeMap importedNodes;
+        readProject([&](ProjectSaxReader& reader) { json::sax_parse(file, &reader, json::input_format_t::json, false); },
+                    imported, importedScenes, importedNodes);
+        file.close();
+
+        // Load textures before replacing the old elements so unchanged images stay cached
+        if (loadImages)
+        {
+            loadTextures(imported);
+        }
+        linkProject(imported, importedScenes, importedNodes);
+        resolvePoses(imported, importedScenes);
+        indexSlides(imported, importedScenes);
+        elements = std::move(imported); // Old handles are released only after the new ones are acquired
+        scenes = std::move(importedScenes);
+        nodes = std::move(importedNodes);
+    }
+
+    void resolveExportedElement(Element& element, const std::vector<BackgroundVariant>& variants,
+                                const std::function<std::string(const std::string&)>& resolve)
+    {
+        if (element.type == ElementType::CHARACTER)
+        {
+            auto& character = std::get<CharacterElement>(element.data);
+            for (auto& img : character.images)
+            {
+                if (!img.second.empty())
+                {
+                    img.second = resolve(img.second);
+                }
+            }
+        }
+        else if (element.type == ElementType::BACKGROUND)
+        {
+            auto& background = std::get<BackgroundElement>(element.data);
+            // Without a window (headless) the path stays the largest variant, as stored
+            GraphicsBackend* backend = GraphicsBackend::get();
+            if (!variants.empty() && backend != nullptr)
+            {
+                background.imagePath = selectBackgroundVariant(variants, backend->getScreenWidth(), backend->getScreenHeight(),
+                                                               background.imagePath);
+            }
+            if (!background.imagePath.empty())
+            {
+                background.imagePath = resolve(background.imagePath);
+            }
+        }
+    }
+
+    void importExported(const std::function<void(ProjectSaxReader&)>& parse, ElementMap& elements, SceneMap& scenes, NodeMap& nodes,
+                        const std::function<std::string(const std::string&)>& resolve, bool loadImages)
+    {
+        ElementMap imported;
+        SceneMap importedScenes;
+        NodeMap importedNodes;
+        readProject(parse, imported, importedScenes, importedNodes,
+                    [&](Element& element, const json& je)
+                    {
+                        std::vector<BackgroundVariant> variants;
+                        if (je.contains("data") && je["data"].contains("variants"))
+                        {
+                            variants = jsonToBackgroundVariants(je["data"]["variants"]);
+                        }
+                        resolveExportedElement(element, variants, resolve);
+                    });
+
+        // Load textures before replacing the old elements so unchanged images stay cached
+        if (loadImages)
+        {
+            loadTextures(imported);
+        }
+        linkProject(imported, importedScenes, importedNodes);
+        resolvePoses(imported, importedScenes);
+        indexSlides(imported, importedScenes);
+        elements = std::move(imported); // Old handles are released only after the new ones are acquired
+        scenes = std::move(importedScenes);
+        nodes = std::move(importedNodes);
+    }
+
+    void importBinary(const ProjectBinary::View& view, ElementMap& elements, SceneMap& scenes, NodeMap& nodes,
+                      const std::function<std::string(const std::string&)>& resolve, bool loadImages)
+    {
+        ElementMap imported;
+        imported.reserve(view.getElementCount());
+        std::vector<BackgroundVariant> variants;
+        for (size_t i = 0; i < view.getElementCount(); ++i)
+        {
+            const ProjectBinary::ElementRecord& record = view.getElementRecord(i);
+            const ProjectBinary::VariantRecord* records = view.getVariants(record);
+            variants.clear();
+            for (uint32_t v = 0; v < record.variantCount; ++v)
+            {
+                variants.push_back({{records[v].targetWidth, records[v].targetHeight},
+                                    std::string(view.getString(records[v].path)), records[v].width, records[v].height});
+            }
+            Element element = view.getElement(i);
+            resolveExportedElement(element, variants, resolve);
+            imported.push_back(std::move(element));
+        }
+
+        if (loadImages)
+        {
+            loadTextures(imported);
+        }
+        elements = std::move(imported);
+
+        scenes.clear();
+        scenes.reserve(view.getSceneCount());
+        for (size_t i = 0; i < view.getSceneCount(); ++i)
+        {
+            scenes.push_back(view.getScene(i));
+        }
+
+        nodes.clear();
+        nodes.reserve(view.getNodeCount());
+        for (size_t i = 0; i < view.getNodeCount(); ++i)
+        {
+            nodes.push_back(view.getNode(i));
+        }
+        linkProject(elements, scenes, nodes);
+        resolvePoses(elements, scenes);
+        indexSlides(elements, scenes);
+    }
+
+    void importFromFolder(ElementMap& elements, SceneMap& scenes, NodeMap& nodes, const std::string& folderPath, bool loadImages)
+    {
+        auto resolve = [&](const std::string& path) { return preferCompressed(fs::path(folderPath) / path); };
+
+        // Prefer the binary twin unless project.json was edited after it was written
+        fs::path binaryFile = fs::path(folderPath) / ProjectBinary::FILE_NAME;
+        fs::path inputFile = fs::path(folderPath) / "project.json";
+        std::error_code ec;
+        auto binaryTime = fs::last_write_time(binaryFile, ec);
+        if (!ec)
+        {
+            auto jsonTime = fs::last_write_time(inputFile, ec);
+            MappedFile mapped;
+            ProjectBinary::View view;
+            if ((ec || jsonTime <= binaryTime) && mapped.open(binaryFile.string()) &&
+                view.open(mapped.getData(), mapped.getSize()))
+            {
+                importBinary(view, elements, scenes, nodes, resolve, loadImages);
+                return;
+            }
+        }
+
+        // Construct path to project.json
+        std::ifstream file(inputFile);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Failed to open file for reading: " + inputFile.string());
+        }
+
+        importExported([&](ProjectSaxReader& reader) { json::sax_parse(file, &reader, json::input_format_t::json, false); },
+                       elements, scenes, nodes, resolve, loadImages);
+    }
+
+    void importFromBundle(ElementMap& elements, SceneMap& scenes, NodeMap& nodes, const AssetBundle& bundle, bool loadImages)
+    {
+        auto resolve = [&](const std::string& path)
+        {
+            std::string ddsPath = fs::path(path).replace_extension(".dds").generic_string();
+            return bundle.contains(ddsPath) ? ddsPath : path;
+        };
+
+        // Bundle payloads are 64-byte aligned, so the records are read straight from the mapping
+        size_t size = 0;
+        const unsigned char* data = bundle.find(ProjectBinary::FILE_NAME, size);
+        ProjectBinary::View view;
+        if (data != nullptr && view.open(data, size))
+        {
+            importBinary(view, elements, scenes, nodes, resolve, loadImages);
+            return;
+        }
+
+        data = bundle.find("project.json", size);
+        if (data == nullptr)
+        {
+            throw std::runtime_error("Asset bundle has no project.json");
+        }
+        importExported([&](ProjectSaxReader& reader) { json::sax_parse(data, data + size, &reader); },
+                       elements, scenes, nodes, resolve, loadImages);
+    }
+}
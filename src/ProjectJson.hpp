@@ -0,0 +1,278 @@
+#ifndef PROJECT_JSON_HPP
+#define PROJECT_JSON_HPP
+
+#include "Types.hpp"
+#include "AssetBundle.hpp"
+#include "ProjectBinary.hpp"
+#include "JsonWriter.hpp"
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Project (de)serialization: the JSON converters, the streaming writer and
+// SAX reader, and importing project.json, project.bin and asset bundles.
+// This is part of the headless core (make core); writing an export folder,
+// which needs raylib to re-encode images, stays in JsonUtils.hpp.
+// Textures are acquired through GraphicsBackend, so without one installed
+// imports leave every handle empty.
+namespace JsonUtils
+{
+    namespace fs = std::filesystem;
+
+    // Helper to convert Color to JSON
+    json colorToJson(const Color& color);
+
+    // Helper to convert JSON to Color
+    Color jsonToColor(const json& j);
+
+    // Helper to convert Rectangle (atlas sub-rectangle) to JSON
+    json rectangleToJson(const Rectangle& rect);
+
+    // Helper to convert JSON to Rectangle
+    Rectangle jsonToRectangle(const json& j);
+
+    // Export Element to JSON
+    json elementToJson(const Element& element);
+
+    // Import Element from JSON
+    Element jsonToElement(const json& j);
+
+    // Export Scene to JSON
+    json sceneToJson(const Scene& scene);
+
+    // Import Scene from JSON
+    Scene jsonToScene(const json& j);
+
+    // Export Node to JSON
+    json nodeToJson(const Node& node);
+
+    // Import Node from JSON
+    Node jsonToNode(const json& j);
+
+    // A window size to bake background variants for
+    struct BakeTarget
+    {
+        int width;
+        int height;
+    };
+
+    // A baked copy of a background for one target window size
+    struct BackgroundVariant
+    {
+        BakeTarget target;
+        std::string fileName;
+        int width;
+        int height;
+    };
+
+    // Streaming counterparts of elementToJson/sceneToJson/nodeToJson. Keys are
+    // written in sorted order so the output is what dump() of the json would be.
+    void writeRectangle(JsonWriter& writer, const Rectangle& rect);
+
+    // variants are an exported background's baked copies (see exportToFolder)
+    void writeElement(JsonWriter& writer, const Element& element, const std::vector<BackgroundVariant>& variants = {});
+
+    // References are written as their targets' saved indices (SavedIndices);
+    // scene elements whose element was erased are left out
+    void writeScene(JsonWriter& writer, const Scene& scene, const ElementMap& elements, const SavedIndices& indices);
+
+    // Connections into erased nodes are left out; an erased scene is written as none
+    void writeNode(JsonWriter& writer, const Node& node, const SceneMap& scenes, const NodeMap& nodes, const SavedIndices& indices);
+
+    // Write a whole project document; writeElement emits the live element at
+    // the slot it is given. Elements, scenes and nodes are renumbered densely
+    // unless indexing is SLOTS, which writes erased slots as {"erased": true}
+    // placeholders that readProject turns back into erased slots.
+    void writeProject(JsonWriter& writer, const ElementMap& elements, const std::function<void(JsonWriter&, size_t)>& writeElement,
+                      const SceneMap& scenes, const NodeMap& nodes, SlotIndexing indexing = SlotIndexing::DENSE);
+
+    void writeProject(JsonWriter& writer, const ElementMap& elements, const SceneMap& scenes, const NodeMap& nodes,
+                      SlotIndexing indexing = SlotIndexing::DENSE);
+
+    // Export all data to file, streamed straight from the vectors. INDENTED keeps
+    // the file diffable; COMPACT is smaller and faster to load.
+    void exportToFile(const ElementMap& elements, const SceneMap& scenes, const NodeMap& nodes, const std::string& filename,
+                      JsonWriter::Style style = JsonWriter::Style::INDENTED);
+
+    // Pick the background file for a window: the smallest baked variant that covers
+    // it, or the largest one when the window is bigger than every target
+    std::string selectBackgroundVariant(const std::vector<BackgroundVariant>& variants, int screenWidth, int screenHeight, const std::string& fallback);
+
+    // Background variants as listed in project.json
+    std::vector<BackgroundVariant> jsonToBackgroundVariants(const json& variants);
+
+    // If an exported image has a compressed .dds twin, load that instead
+    std::string preferCompressed(const fs::path& path);
+
+    // Acquire textures for CharacterElement and BackgroundElement from the
+    // GraphicsBackend (the shared TextureCache in the editor and renderer, where
+    // files referenced by several elements are decoded and uploaded only once).
+    // Does nothing without a backend.
+    void loadTextures(ElementMap& elements);
+
+    // SAX consumer for project files. Each item of the top-level "elements",
+    // "scenes" and "nodes" arrays is assembled on its own and handed to the
+    // matching callback as soon as its closing bracket is read, then dropped, so
+    // the document is never held in memory: peak usage is one record. Records
+    // still go through jsonToElement/jsonToScene/jsonToNode, which keeps their
+    // defaults and the exceptions they throw on malformed values.
+    class ProjectSaxReader
+    {
+    public:
+        using RecordCallback = std::function<void(const json&)>;
+
+        ProjectSaxReader(RecordCallback onElement, RecordCallback onScene, RecordCallback onNode)
+            : callbacks{std::move(onElement), std::move(onScene), std::move(onNode)}
+        {
+        }
+
+        bool null() { return value(json(nullptr)); }
+        bool boolean(bool val) { return value(json(val)); }
+        bool number_integer(json::number_integer_t val) { return value(json(val)); }
+        bool number_unsigned(json::number_unsigned_t val) { return value(json(val)); }
+        bool number_float(json::number_float_t val, const json::string_t&) { return value(json(val)); }
+        bool string(json::string_t& val) { return value(json(std::move(val))); }
+        bool binary(json::binary_t& val) { return value(json::binary(std::move(val))); }
+        bool start_object(std::size_t) { return open(json::object()); }
+        bool start_array(std::size_t) { return open(json::array()); }
+        bool end_object() { return close(); }
+        bool end_array() { return close(); }
+
+        bool key(json::string_t& val)
+        {
+            if (!stack.empty())
+            {
+                recordKey = std::move(val);
+            }
+            else if (depth == 1)
+            {
+                topLevelKey = std::move(val);
+            }
+            return true;
+        }
+
+        // Same exception (type and message) the DOM parser would have thrown
+        template <class Exception>
+        bool parse_error(std::size_t, const std::string&, const Exception& ex)
+        {
+            throw ex;
+        }
+
+    private:
+        enum Section { NONE = -1, ELEMENTS, SCENES, NODES };
+
+        // Adds val to the record being built and returns where it was stored
+        json* add(json&& val)
+        {
+            json& parent = *stack.back();
+            if (parent.is_array())
+            {
+                parent.push_back(std::move(val));
+                return &parent.back();
+            }
+            json& slot = parent[recordKey];
+            slot = std::move(val);
+            return &slot;
+        }
+
+        bool value(json&& val)
+        {
+            if (!stack.empty())
+            {
+                add(std::move(val));
+            }
+            else if (depth == 2 && section != NONE)
+            {
+                callbacks[section](val); // A scalar record; jsonToX reports it
+            }
+            return true;
+        }
+
+        bool open(json&& container)
+        {
+            if (!stack.empty())
+            {
+                stack.push_back(add(std::move(container)));
+            }
+            else if (depth == 2 && section != NONE)
+            {
+                record = std::move(container);
+                stack.push_back(&record);
+            }
+            else if (depth == 1 && container.is_array())
+            {
+                section = topLevelKey == "elements" ? ELEMENTS
+                        : topLevelKey == "scenes"   ? SCENES
+                        : topLevelKey == "nodes"    ? NODES
+                                                    : NONE;
+            }
+            ++depth;
+            return true;
+        }
+
+        bool close()
+        {
+            --depth;
+            if (!stack.empty())
+            {
+                stack.pop_back();
+                if (stack.empty())
+                {
+                    callbacks[section](record);
+                    record = json();
+                }
+            }
+            else if (depth == 1)
+            {
+                section = NONE;
+            }
+            return true;
+        }
+
+        RecordCallback callbacks[3];
+        int depth = 0;                // 1 inside the root object, 2 inside a section array
+        Section section = NONE;
+        std::string topLevelKey;
+        std::string recordKey;
+        json record;                  // Item being assembled
+        std::vector<json*> stack;     // Open containers of record, innermost last
+    };
+
+    // Stream a project file into elements, scenes and nodes. parse runs
+    // json::sax_parse over the input with the reader it is given; adjust, if
+    // set, sees each element with its JSON before it is stored.
+    void readProject(const std::function<void(ProjectSaxReader&)>& parse,
+                     ElementMap& elements, SceneMap& scenes, NodeMap& nodes,
+                     const std::function<void(Element&, const json&)>& adjust = nullptr);
+
+    // Import all data from file and load textures
+    void importFromFile(ElementMap& elements, SceneMap& scenes, NodeMap& nodes, const std::string& filename, bool loadImages = true);
+
+    // Point an exported element's image paths at where they are loaded from;
+    // backgrounds first pick the variant baked for the current window
+    void resolveExportedElement(Element& element, const std::vector<BackgroundVariant>& variants,
+                                const std::function<std::string(const std::string&)>& resolve);
+
+    // Build elements, scenes and nodes from an exported project.json, streamed by
+    // parse (see readProject). resolve maps an image path stored in the file to
+    // the path textures are loaded from.
+    void importExported(const std::function<void(ProjectSaxReader&)>& parse, ElementMap& elements, SceneMap& scenes, NodeMap& nodes,
+                        const std::function<std::string(const std::string&)>& resolve, bool loadImages);
+
+    // Same as importExported, reading the records of a project.bin in place
+    void importBinary(const ProjectBinary::View& view, ElementMap& elements, SceneMap& scenes, NodeMap& nodes,
+                      const std::function<std::string(const std::string&)>& resolve, bool loadImages);
+
+    // Import all data from a folder, loading textures with full paths from project.json
+    // (compressed .dds twins written by export are preferred over the PNGs).
+    // With loadImages == false textures are left to the caller (e.g. Render's prefetcher).
+    void importFromFolder(ElementMap& elements, SceneMap& scenes, NodeMap& nodes, const std::string& folderPath, bool loadImages = true);
+
+    // Import all data from a mapped asset bundle. Image paths stay bundle entry
+    // names; mount the bundle in TextureCache so they are decoded from memory.
+    void importFromBundle(ElementMap& elements, SceneMap& scenes, NodeMap& nodes, const AssetBundle& bundle, bool loadImages = true);
+}
+
+#endif // PROJECT_JSON_HPP
@@ -0,0 +1,22 @@
+#ifndef PROJECT_OBSERVER_HPP
+#define PROJECT_OBSERVER_HPP
+
+#include <cstddef>
+
+// Told about each change the editors make to the project, right after it is
+// made (see EditJournal). An index equal to the old size means an append.
+class ProjectObserver
+{
+public:
+    virtual ~ProjectObserver() = default;
+
+    virtual void elementChanged(size_t index) = 0;
+    virtual void sceneChanged(size_t index) = 0;
+    virtual void nodeChanged(size_t index) = 0;
+    virtual void elementErased(size_t index) = 0; // See eraseElement()
+    virtual void sceneErased(size_t index) = 0;   // See eraseScene()
+    virtual void nodeErased(size_t index) = 0;    // See eraseNode()
+    virtual void projectReplaced() = 0;        // Everything changed at once, e.g. on import
+};
+
+#endif // PROJECT_OBSERVER_HPP
@@ -0,0 +1,149 @@
+#include "ProjectSaver.hpp"
+#include "AtomicFile.hpp"
+#include "AssetBundle.hpp"
+#include "Log.hpp"
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+
+std::shared_ptr<const ProjectSnapshot> ProjectSnapshot::capture(const ElementMap& elements, const SceneMap& scenes,
+                                                                const NodeMap& nodes) {
+    auto snapshot = std::make_shared<ProjectSnapshot>();
+    // Slots and generations are kept so scene elements still resolve
+    snapshot->elements = elements.copyWith([](const Element& element) {
+        Element copy;
+        copy.type = element.type;
+        copy.name = element.name;
+        switch (element.type) {
+        case ElementType::TEXT:
+            copy.data = std::get<TextElement>(element.data);
+            break;
+        case ElementType::CHARACTER: {
+            const auto& character = std::get<CharacterElement>(element.data);
+            CharacterElement saved;
+            saved.name = character.name;
+            saved.images = character.images;
+            saved.atlasRects = character.atlasRects;
+            saved.sourceSizes = character.sourceSizes;
+            saved.poseIds = character.poseIds;
+            saved.positionIndex = character.positionIndex;
+            copy.data = std::move(saved);
+            break;
+        }
+        case ElementType::BACKGROUND:
+            copy.data = BackgroundElement{std::get<BackgroundElement>(element.data).imagePath, TextureHandle()};
+            break;
+        }
+        return copy;
+    });
+    snapshot->scenes = scenes;
+    snapshot->nodes = nodes;
+    return snapshot;
+}
+
+ProjectSaver::ProjectSaver(Serializer serializer, JsonWriter::Style style) : serializer(std::move(serializer)), style(style) {
+    worker = std::thread(&ProjectSaver::workerLoop, this);
+}
+
+ProjectSaver::~ProjectSaver() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true; // Queued saves are still written: they are the user's work
+    }
+    jobAvailable.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+void ProjectSaver::save(std::shared_ptr<const ProjectSnapshot> snapshot, const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        bool replaced = false;
+        for (auto& job : jobs) {
+            if (job.path == path) {
+                job.snapshot = snapshot;
+                replaced = true;
+            }
+        }
+        if (!replaced) jobs.push_back({std::move(snapshot), path});
+    }
+    jobAvailable.notify_one();
+}
+
+bool ProjectSaver::isSaving() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return busy || !jobs.empty();
+}
+
+bool ProjectSaver::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return !busy && jobs.empty(); });
+    return lastError.empty();
+}
+
+std::string ProjectSaver::getLastError() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastError;
+}
+
+void ProjectSaver::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) return; // Stopping with nothing left to write
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            busy = true;
+        }
+
+        std::string error;
+        try {
+            write(job);
+        } catch (const std::exception& e) {
+            error = e.what();
+            LogError("Saving %s failed: %s", job.path.c_str(), e.what());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            lastError = error;
+            busy = false;
+        }
+        idle.notify_all();
+    }
+}
+
+void ProjectSaver::write(const Job& job) {
+    auto start = std::chrono::steady_clock::now();
+    AtomicFile file;
+    if (!file.open(job.path)) {
+        throw std::runtime_error("Failed to open file for writing: " + job.path);
+    }
+    uint64_t hash = AssetBundle::HASH_SEED;
+    uint64_t size = 0;
+    {
+        JsonWriter writer(
+            [&](const char* data, size_t count) {
+                hash = AssetBundle::hash(data, count, hash);
+                size += count;
+                file.write(data, count);
+            },
+            style);
+        serializer(writer, *job.snapshot);
+    }
+
+    std::error_code ec;
+    auto written = writtenHashes.find(job.path);
+    if (written != writtenHashes.end() && written->second == hash && std::filesystem::exists(job.path, ec)) {
+        file.discard(); // Nothing changed since the last save
+        return;
+    }
+    if (!file.commit()) {
+        writtenHashes.erase(job.path);
+        throw std::runtime_error("Failed to write file: " + job.path);
+    }
+    writtenHashes[job.path] = hash;
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    LogInfo("Saved %s (%llu bytes, %.0f ms)", job.path.c_str(), (unsigned long long)size, ms);
+}
@@ -0,0 +1,77 @@
+#ifndef PROJECT_SAVER_HPP
+#define PROJECT_SAVER_HPP
+
+#include "Types.hpp"
+#include "JsonWriter.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// Immutable copy of a project to save from another thread. Texture handles
+// are left out: they belong to the thread that owns the GL context.
+struct ProjectSnapshot
+{
+    ElementMap elements;
+    SceneMap scenes;
+    NodeMap nodes;
+
+    static std::shared_ptr<const ProjectSnapshot> capture(const ElementMap& elements, const SceneMap& scenes,
+                                                          const NodeMap& nodes);
+};
+
+// Writes project snapshots on a worker thread so saving never stalls a frame.
+// Files are replaced atomically (see AtomicFile), and a save whose output is
+// identical to what was last written to that path is dropped before the fsync.
+class ProjectSaver
+{
+public:
+    // Serializes a snapshot; runs on the worker thread
+    using Serializer = std::function<void(JsonWriter& writer, const ProjectSnapshot& snapshot)>;
+
+    explicit ProjectSaver(Serializer serializer, JsonWriter::Style style = JsonWriter::Style::INDENTED);
+    ~ProjectSaver(); // Finishes queued saves
+    ProjectSaver(const ProjectSaver&) = delete;
+    ProjectSaver& operator=(const ProjectSaver&) = delete;
+
+    // Queue a save. A queued save to the same path that hasn't started yet is
+    // replaced, since this one is newer.
+    void save(std::shared_ptr<const ProjectSnapshot> snapshot, const std::string& path);
+
+    bool isSaving() const;
+    // Block until every queued save has been written; false if the last one failed
+    bool wait();
+    // Message of the last failed save, empty once a later save succeeds
+    std::string getLastError() const;
+
+private:
+    struct Job
+    {
+        std::shared_ptr<const ProjectSnapshot> snapshot;
+        std::string path;
+    };
+
+    void workerLoop();
+    void write(const Job& job);
+
+    Serializer serializer;
+    JsonWriter::Style style;
+    std::unordered_map<std::string, uint64_t> writtenHashes; // Worker thread only
+
+    std::thread worker;
+    mutable std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::condition_variable idle;
+    std::deque<Job> jobs;
+    bool busy = false;
+    bool stopping = false;
+    std::string lastError;
+};
+
+#endif // PROJECT_SAVER_HPP
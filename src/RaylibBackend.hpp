@@ -0,0 +1,19 @@
+#ifndef RAYLIB_BACKEND_HPP
+#define RAYLIB_BACKEND_HPP
+
+#include "GraphicsBackend.hpp"
+#include "TextureCache.hpp"
+#include "raylib.h"
+
+// GraphicsBackend of the editor and renderer: textures come from the shared
+// TextureCache and the screen is raylib's window
+class RaylibBackend : public GraphicsBackend
+{
+public:
+    TextureHandle acquireTexture(const std::string& path) override { return TextureCache::instance().acquire(path); }
+    void touchTexture(const std::shared_ptr<TextureEntry>& entry) override { TextureCache::instance().touch(entry); }
+    int getScreenWidth() const override { return GetScreenWidth(); }
+    int getScreenHeight() const override { return GetScreenHeight(); }
+};
+
+#endif // RAYLIB_BACKEND_HPP
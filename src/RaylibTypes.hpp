@@ -0,0 +1,32 @@
+#ifndef RAYLIB_TYPES_HPP
+#define RAYLIB_TYPES_HPP
+
+// The raylib value types and logging the core (data model, serialization,
+// graph queries) is written against. Normally that is raylib.h itself; a
+// NOVEL_HEADLESS build (make core) gets layout-compatible definitions instead,
+// with TraceLog printing to the console (HeadlessLog.cpp), so the core builds
+// and runs without raylib, a window or a GL context.
+#ifndef NOVEL_HEADLESS
+
+#include "raylib.h"
+
+#else
+
+#define CLITERAL(type) type
+
+typedef struct Vector2 { float x; float y; } Vector2;
+typedef struct Rectangle { float x; float y; float width; float height; } Rectangle;
+typedef struct Color { unsigned char r; unsigned char g; unsigned char b; unsigned char a; } Color;
+typedef struct Texture { unsigned int id; int width; int height; int mipmaps; int format; } Texture;
+typedef Texture Texture2D;
+
+#define LIGHTGRAY CLITERAL(Color){ 200, 200, 200, 255 }
+
+typedef enum { LOG_ALL = 0, LOG_TRACE, LOG_DEBUG, LOG_INFO, LOG_WARNING, LOG_ERROR, LOG_FATAL, LOG_NONE } TraceLogLevel;
+
+void TraceLog(int logLevel, const char* text, ...);
+void SetTraceLogLevel(int logLevel);
+
+#endif // NOVEL_HEADLESS
+
+#endif // RAYLIB_TYPES_HPP
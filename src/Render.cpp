@@ -2,51 +2,68 @@
 #include <algorithm>
 #include "raylib.h"
 #include "raygui.h"
+#include "Log.hpp"
+#include "Profiler.hpp"
 
-Render::Render(std::vector<Element>& elements, std::vector<Scene>& scenes, std::vector<Node>& nodes)
+Render::Render(ElementMap& elements, SceneMap& scenes, NodeMap& nodes)
     : elements(elements), scenes(scenes), nodes(nodes), currentNodeIndex(-1), currentSlide(1),
-      scrollOffset({0, 0}), buttonSpacing(40.0f), showButtons(false) {}
+      scrollOffset({0, 0}), buttonSpacing(40.0f), showButtons(false),
+      prefetcher(elements, scenes, nodes), prefetchEnabled(false), inputEnabled(true), placeholderCount(0),
+      activeSceneIndex(-1), activeSlide(0), activeRevision(0), drawListKey{}, drawListValid(false) {}
+
+void Render::setPrefetchDepth(int depth) {
+    prefetchEnabled = depth >= 0;
+    if (prefetchEnabled) {
+        prefetcher.setDepth(depth);
+    }
+}
 
 void Render::update(float currentTime, int currentSlide) {
+    PROFILE_ZONE("Render::update");
     this->currentSlide = currentSlide;
-    if (currentNodeIndex < 0 || currentNodeIndex >= (int)nodes.size()) {
+    if (prefetchEnabled) {
+        prefetcher.update(currentNodeIndex);
+    }
+    if (currentNodeIndex < 0 || !nodes.isAlive(currentNodeIndex)) {
         showButtons = false;
-        TraceLog(LOG_WARNING, "No valid node selected (index: %d)", currentNodeIndex);
+        LogWarning("No valid node selected (index: %d)", currentNodeIndex);
         return;
     }
 
     const Node& currentNode = nodes[currentNodeIndex];
     showButtons = true;
 
-    if (currentNode.sceneIndex >= 0 && currentNode.sceneIndex < (int)scenes.size()) {
+    if (findScene(scenes, currentNode) != nullptr) {
         const Scene& scene = scenes[currentNode.sceneIndex];
-        bool allElementsDone = true;
-        float maxEndTime = 0.0f;
-        for (const auto& sceneElement : scene.elements) {
-            if (sceneElement.elementIndex < elements.size()) {
-                maxEndTime = std::max(maxEndTime, sceneElement.endTime);
-                if (currentSlide >= sceneElement.startTime && currentSlide <= sceneElement.endTime) {
-                    allElementsDone = false;
-                    TraceLog(LOG_INFO, "Element %zu (name: %s) is active: startTime=%.2f, endTime=%.2f",
-                             sceneElement.elementIndex,
-                             elements[sceneElement.elementIndex].name.c_str(),
-                             sceneElement.startTime,
-                             sceneElement.endTime);
-                }
+        bool refreshed = refreshActiveElements(currentNode.sceneIndex);
+        if (refreshed) {
+            for (size_t position : activeElements) {
+                const SceneElement& sceneElement = scene.elements[position];
+                LogInfo("Element %zu (name: %s) is active: startTime=%.2f, endTime=%.2f",
+                         sceneElement.elementIndex,
+                         elements[sceneElement.elementIndex].name.c_str(),
+                         sceneElement.startTime,
+                         sceneElement.endTime);
             }
         }
+        bool allElementsDone = scene.slides.countActive(currentSlide) == 0;
+        float maxEndTime = scene.slides.getMaxEndTime();
         showButtons = allElementsDone || currentSlide >= maxEndTime;
-        TraceLog(LOG_INFO, "Slide %d, Max EndTime: %.2f, All Elements Done: %d, Show Buttons: %d",
-                 currentSlide, maxEndTime, allElementsDone, showButtons);
+        if (refreshed) {
+            LogInfo("Slide %d, Max EndTime: %.2f, All Elements Done: %d, Show Buttons: %d",
+                     currentSlide, maxEndTime, allElementsDone, showButtons);
+        }
     } else {
         showButtons = true;
-        TraceLog(LOG_WARNING, "No valid scene for node %d, showing buttons", currentNodeIndex);
+        LogWarning("No valid scene for node %d, showing buttons", currentNodeIndex);
     }
 
+    if (!inputEnabled) return;
+
     // Handle spacebar for next slide
     if (IsKeyPressed(KEY_SPACE) && canGoNext()) {
         nextSlide();
-        TraceLog(LOG_INFO, "Spacebar pressed, advanced to slide %d", currentSlide);
+        LogInfo("Spacebar pressed, advanced to slide %d", currentSlide);
     }
 
     if (showButtons) {
@@ -56,23 +73,26 @@ void Render::update(float currentTime, int currentSlide) {
             float maxScroll = nodes[currentNodeIndex].connections.size() * buttonSpacing - GetScreenHeight() * 0.7f;
             if (maxScroll < 0) maxScroll = 0;
             scrollOffset.y = std::max(0.0f, std::min(scrollOffset.y, maxScroll));
-            TraceLog(LOG_INFO, "Scroll offset updated to %.2f (maxScroll: %.2f)", scrollOffset.y, maxScroll);
+            LogInfo("Scroll offset updated to %.2f (maxScroll: %.2f)", scrollOffset.y, maxScroll);
         }
     }
 }
 
 void Render::draw(Font customFont) {
-    if (currentNodeIndex < 0 || currentNodeIndex >= (int)nodes.size()) {
+    PROFILE_ZONE("Render::draw");
+    placeholderCount = 0;
+    if (currentNodeIndex < 0 || !nodes.isAlive(currentNodeIndex)) {
         DrawText("No node selected", 10, 10, 20, RED);
-        TraceLog(LOG_ERROR, "Cannot draw: invalid node index %d", currentNodeIndex);
+        LogError("Cannot draw: invalid node index %d", currentNodeIndex);
         return;
     }
+    if (!inputEnabled) GuiLock(); // Buttons are still drawn, just never pressed
 
     const Node& currentNode = nodes[currentNodeIndex];
-    if (currentNode.sceneIndex >= 0 && currentNode.sceneIndex < (int)scenes.size()) {
-        drawScene(scenes[currentNode.sceneIndex], GetTime(), currentSlide, customFont);
+    if (findScene(scenes, currentNode) != nullptr) {
+        drawScene(currentNode.sceneIndex, customFont);
     } else {
-        TraceLog(LOG_WARNING, "Invalid scene index %d for node %d", currentNode.sceneIndex, currentNodeIndex);
+        LogWarning("Invalid scene index %d for node %d", currentNode.sceneIndex, currentNodeIndex);
     }
 
     // Draw navigation and reset buttons
@@ -85,25 +105,25 @@ void Render::draw(Font customFont) {
     if (canGoPrev()) {
         if (GuiButton({navButtonX, navButtonY, buttonWidth, buttonHeight}, "Previous Slide")) {
             prevSlide();
-            TraceLog(LOG_INFO, "Previous slide button clicked, moved to slide %d", currentSlide);
+            LogInfo("Previous slide button clicked, moved to slide %d", currentSlide);
         }
     }
     if (canGoNext()) {
         if (GuiButton({navButtonX + buttonWidth + 20.0f, navButtonY, buttonWidth, buttonHeight}, "Next Slide")) {
             nextSlide();
-            TraceLog(LOG_INFO, "Next slide button clicked, advanced to slide %d", currentSlide);
+            LogInfo("Next slide button clicked, advanced to slide %d", currentSlide);
         }
     }
     if (GuiButton({navButtonX + buttonWidth * 2 + 40.0f, navButtonY, buttonWidth, buttonHeight}, "Reset")) {
         resetSlide();
-        TraceLog(LOG_INFO, "Reset button clicked, reset to node %d and slide 1", currentNodeIndex);
+        LogInfo("Reset button clicked, reset to node %d and slide 1", currentNodeIndex);
     }
 
     if (showButtons) {
         if (nodes[currentNodeIndex].connections.empty()) {
             float textWidth = MeasureText("No choices available", 20);
             DrawText("No choices available", (GetScreenWidth() - textWidth) / 2, GetScreenHeight() / 2 - 100, 20, RED);
-            TraceLog(LOG_WARNING, "Node %d has no connections", currentNodeIndex);
+            LogDebug("Node %d has no connections", currentNodeIndex);
         } else {
             float buttonWidth = 200.0f;
             float buttonHeight = 30.0f;
@@ -115,157 +135,248 @@ void Render::draw(Font customFont) {
             float boxY = (GetScreenHeight() - boxHeight) / 2.0f; // Center vertically
             GuiGroupBox({boxX, boxY, boxWidth, boxHeight}, "Choices");
             BeginScissorMode(boxX, boxY, boxWidth, boxHeight);
-            TraceLog(LOG_INFO, "Rendering %zu choice buttons for node %d (boxHeight: %.2f, totalChoicesHeight: %.2f)",
+            LogDebug("Rendering %zu choice buttons for node %d (boxHeight: %.2f, totalChoicesHeight: %.2f)",
                      connectionsSize, currentNodeIndex, boxHeight, totalChoicesHeight);
             for (size_t i = 0; i < connectionsSize; ++i) {
                 if (i >= nodes[currentNodeIndex].connections.size()) {
-                    TraceLog(LOG_ERROR, "Index %zu exceeds connections size %zu for node %d", i, nodes[currentNodeIndex].connections.size(), currentNodeIndex);
+                    LogError("Index %zu exceeds connections size %zu for node %d", i, nodes[currentNodeIndex].connections.size(), currentNodeIndex);
                     break;
                 }
                 float yPos = boxY + 10.0f + i * buttonSpacing - scrollOffset.y;
                 Rectangle buttonRect = {boxX + 10.0f, yPos, buttonWidth, buttonHeight};
                 if (yPos + buttonHeight > boxY && yPos < boxY + boxHeight) {
                     if (GuiButton(buttonRect, nodes[currentNodeIndex].connections[i].choiceText.c_str())) {
-                        int newNodeIndex = nodes[currentNodeIndex].connections[i].toNodeIndex;
-                        if (newNodeIndex >= 0 && newNodeIndex < (int)nodes.size()) {
-                            TraceLog(LOG_INFO, "Switching to node %d (sceneIndex: %d) via choice %zu (text: %s)",
-                                     newNodeIndex, nodes[newNodeIndex].sceneIndex, i,
-                                     nodes[currentNodeIndex].connections[i].choiceText.c_str());
-                            currentNodeIndex = newNodeIndex;
-                            currentSlide = 1;
-                            scrollOffset.y = 0.0f;
+                        if (chooseConnection(i)) {
                             break; // Exit loop to prevent further accesses after node change
-                        } else {
-                            TraceLog(LOG_ERROR, "Invalid node index %d in connection %zu for node %d", newNodeIndex, i, currentNodeIndex);
                         }
                     }
-                    TraceLog(LOG_INFO, "Rendered choice %zu at yPos: %.2f (text: %s) for node %d", i, yPos,
+                    LogDebug("Rendered choice %zu at yPos: %.2f (text: %s) for node %d", i, yPos,
                              nodes[currentNodeIndex].connections[i].choiceText.c_str(), currentNodeIndex);
                 } else {
-                    TraceLog(LOG_WARNING, "Choice %zu at yPos: %.2f is outside visible area (boxY: %.2f, boxHeight: %.2f) for node %d",
+                    LogDebug("Choice %zu at yPos: %.2f is outside visible area (boxY: %.2f, boxHeight: %.2f) for node %d",
                              i, yPos, boxY, boxHeight, currentNodeIndex);
                 }
             }
             EndScissorMode();
         }
     }
+    if (!inputEnabled) GuiUnlock();
 }
 
-void Render::drawScene(const Scene& scene, float currentTime, int currentSlide,Font customFont) {
-    // Collect all elements to render
-    std::vector<std::pair<const SceneElement*, const Element*>> renderElements;
-    for (const auto& sceneElement : scene.elements) {
-        if (sceneElement.elementIndex < elements.size() &&
-            currentSlide >= sceneElement.startTime && currentSlide <= sceneElement.endTime) {
-            renderElements.emplace_back(&sceneElement, &elements[sceneElement.elementIndex]);
-        }
+size_t Render::getChoiceCount() const {
+    if (currentNodeIndex < 0 || !nodes.isAlive(currentNodeIndex)) return 0;
+    return nodes[currentNodeIndex].connections.size();
+}
+
+bool Render::chooseConnection(size_t choice) {
+    if (choice >= getChoiceCount()) {
+        LogError("Choice %zu does not exist for node %d", choice, currentNodeIndex);
+        return false;
+    }
+    const NodeConnection& connection = nodes[currentNodeIndex].connections[choice];
+    int newNodeIndex = connection.toNodeIndex;
+    if (!isLinked(nodes, connection)) {
+        LogError("Invalid node index %d in connection %zu for node %d", newNodeIndex, choice, currentNodeIndex);
+        return false;
     }
+    LogInfo("Switching to node %d (sceneIndex: %d) via choice %zu (text: %s)",
+             newNodeIndex, nodes[newNodeIndex].sceneIndex, choice, connection.choiceText.c_str());
+    currentNodeIndex = newNodeIndex;
+    currentSlide = 1;
+    scrollOffset.y = 0.0f;
+    return true;
+}
+
+bool Render::refreshActiveElements(int sceneIndex) {
+    const SlideIndex& slides = scenes[sceneIndex].slides;
+    if (sceneIndex == activeSceneIndex && currentSlide == activeSlide && slides.getRevision() == activeRevision) {
+        return false;
+    }
+    if (slides.getRevision() == 0) {
+        // Scene added without going through an import or the scene editor
+        indexSlides(elements, scenes[sceneIndex]);
+    }
+    slides.getActive(currentSlide, activeElements);
+    // In case elements were erased since the index was built
+    activeElements.erase(std::remove_if(activeElements.begin(), activeElements.end(),
+                                        [&](size_t position) {
+                                            return position >= scenes[sceneIndex].elements.size() ||
+                                                   findElement(elements, scenes[sceneIndex].elements[position]) == nullptr;
+                                        }),
+                         activeElements.end());
+    activeSceneIndex = sceneIndex;
+    activeSlide = currentSlide;
+    activeRevision = slides.getRevision();
+    return true;
+}
+
+void Render::buildDrawList(int sceneIndex) {
+    PROFILE_ZONE("Render::buildDrawList");
+    refreshActiveElements(sceneIndex);
+    const Scene& scene = scenes[sceneIndex];
+    drawList.clear();
+    unsizedTextures.clear();
 
-    // Separate characters and sort by positionIndex
-    std::vector<std::pair<const SceneElement*, const Element*>> characterElements;
-    for (const auto& [sceneElement, element] : renderElements) {
-        if (element->type == ElementType::CHARACTER) {
-            characterElements.emplace_back(sceneElement, element);
+    // Backgrounds and text by renderlevel, then characters by positionIndex
+    std::vector<const SceneElement*> others;
+    std::vector<const SceneElement*> characters;
+    for (size_t position : activeElements) {
+        const SceneElement& sceneElement = scene.elements[position];
+        if (elements[sceneElement.elementIndex].type == ElementType::CHARACTER) {
+            characters.push_back(&sceneElement);
+        } else {
+            others.push_back(&sceneElement);
         }
     }
-    std::sort(characterElements.begin(), characterElements.end(),
-              [](const auto& a, const auto& b) {
-                  const auto& charA = std::get<CharacterElement>(a.second->data);
-                  const auto& charB = std::get<CharacterElement>(b.second->data);
-                  return charA.positionIndex < charB.positionIndex;
-              });
-
-    // Calculate spacing for characters
-    int characterCount = characterElements.size();
+    std::stable_sort(others.begin(), others.end(),
+                     [](const SceneElement* a, const SceneElement* b) { return a->renderlevel < b->renderlevel; });
+    std::stable_sort(characters.begin(), characters.end(), [this](const SceneElement* a, const SceneElement* b) {
+        return std::get<CharacterElement>(elements[a->elementIndex].data).positionIndex <
+               std::get<CharacterElement>(elements[b->elementIndex].data).positionIndex;
+    });
+
     float screenWidth = (float)GetScreenWidth();
-    float characterWidth = 0.0f; // Approximate width per character (will be updated)
-    float spacing = 50.0f; // Fixed spacing between characters
-    if (characterCount > 0) {
-        // Estimate character width based on the first character's texture
-        const auto& firstCharacter = std::get<CharacterElement>(characterElements[0].second->data);
-        for (size_t i = 0; i < firstCharacter.textures.size(); ++i) {
-            if (firstCharacter.textures[i].id > 0) {
-                characterWidth = firstCharacter.textures[i].width * 0.5f; // Scale is 0.5f
+    float screenHeight = (float)GetScreenHeight();
+    for (const SceneElement* sceneElement : others) {
+        const Element& element = elements[sceneElement->elementIndex];
+        DrawCommand command{};
+        command.element = {sceneElement->elementIndex, 0};
+        command.layer = (int)drawList.size();
+        if (element.type == ElementType::TEXT) {
+            const auto& text = std::get<TextElement>(element.data);
+            int textWidth = MeasureText(text.content.c_str(), 20);
+            command.kind = DrawCommand::Kind::TEXT;
+            command.dest = {(float)((GetScreenWidth() - textWidth) / 2), screenHeight - 50, 0, 0};
+            command.tint = BLACK;
+        } else {
+            const auto& bg = std::get<BackgroundElement>(element.data);
+            command.kind = DrawCommand::Kind::BACKGROUND;
+            command.tint = WHITE;
+            float width = (float)bg.texture.getWidth();
+            float height = (float)bg.texture.getHeight();
+            if (width > 0 && height > 0) {
+                // Cover the screen
+                float scale = std::max(screenWidth / width, screenHeight / height);
+                command.source = {0, 0, width, height};
+                command.dest = {0, 0, width * scale, height * scale};
+            } else {
+                unsizedTextures.push_back(command.element);
+            }
+        }
+        drawList.push_back(command);
+    }
+
+    // Characters are spaced as if all were as wide as the first one's first known pose
+    float spacing = 50.0f;
+    float characterWidth = 0.0f;
+    if (!characters.empty()) {
+        const auto& firstCharacter = std::get<CharacterElement>(elements[characters[0]->elementIndex].data);
+        for (size_t i = 0; i < firstCharacter.images.size(); ++i) {
+            Vector2 size = firstCharacter.getDisplaySize(i);
+            if (size.x > 0) {
+                characterWidth = size.x * CHARACTER_DRAW_SCALE;
                 break;
             }
         }
+        if (characterWidth == 0.0f) {
+            for (size_t i = 0; i < firstCharacter.textures.size(); ++i) {
+                unsizedTextures.push_back({characters[0]->elementIndex, i});
+            }
+        }
     }
+    float characterCount = (float)characters.size();
     float totalWidth = characterCount * characterWidth + (characterCount > 1 ? (characterCount - 1) * spacing : 0);
     float startX = (screenWidth - totalWidth) / 2.0f; // Center the group
 
-    // Render non-character elements, sorted by renderlevel
-    std::vector<std::pair<const SceneElement*, const Element*>> nonCharacterElements;
-    for (const auto& [sceneElement, element] : renderElements) {
-        if (element->type != ElementType::CHARACTER) {
-            nonCharacterElements.emplace_back(sceneElement, element);
-        }
-    }
-    std::sort(nonCharacterElements.begin(), nonCharacterElements.end(),
-              [](const auto& a, const auto& b) { return a.first->renderlevel < b.first->renderlevel; });
+    for (size_t i = 0; i < characters.size(); ++i) {
+        const auto& character = std::get<CharacterElement>(elements[characters[i]->elementIndex].data);
+        int pose = findPose(character, *characters[i]);
+        if (pose < 0 || pose >= (int)character.textures.size()) continue;
+        float scale = CHARACTER_DRAW_SCALE;
+        // Atlas poses draw a sub-rectangle of a shared page and baked poses are
+        // laid out at their original size. Until decoded the size of a plain
+        // standalone pose is unknown; use a portrait-shaped stand-in
+        Vector2 size = character.getDisplaySize(pose);
+        if (size.x <= 0 || size.y <= 0) unsizedTextures.push_back({characters[i]->elementIndex, (size_t)pose});
+        float width = size.x > 0 ? size.x : 256.0f;
+        float height = size.y > 0 ? size.y : 512.0f;
+        float posX = startX + i * (width * scale + spacing);
+        float posY = screenHeight - height * scale - 60;
 
-    for (const auto& [sceneElement, element] : nonCharacterElements) {
-        drawElement(*sceneElement, *element, currentTime, currentSlide, characterCount, 0, spacing, startX,customFont);
+        DrawCommand command{};
+        command.kind = DrawCommand::Kind::CHARACTER;
+        command.element = {characters[i]->elementIndex, (size_t)pose};
+        command.source = character.getSourceRect(pose);
+        command.dest = {posX, posY, width * scale, height * scale};
+        command.tint = WHITE;
+        command.layer = (int)drawList.size();
+        drawList.push_back(command);
+        LogInfo("Laid out character '%s' at posX=%.2f, posY=%.2f, positionIndex=%d",
+                 character.name.c_str(), posX, posY, character.positionIndex);
     }
+}
 
-    // Render characters in positionIndex order
-    for (size_t i = 0; i < characterElements.size(); ++i) {
-        drawElement(*characterElements[i].first, *characterElements[i].second, currentTime, currentSlide, characterCount, i, spacing, startX,customFont);
+void Render::drawScene(int sceneIndex, Font customFont) {
+    DrawListKey key = {sceneIndex, currentSlide, scenes[sceneIndex].slides.getRevision(), GetScreenWidth(), GetScreenHeight(),
+                       elements.size()};
+    bool stale = !drawListValid || !(key == drawListKey);
+    for (const ElementRef& ref : unsizedTextures) {
+        const TextureHandle* texture = findTexture(ref);
+        if (texture == nullptr || texture->getWidth() > 0) stale = true; // Decoded since; lay out with its real size
     }
-}
+    if (stale) {
+        buildDrawList(sceneIndex);
+        key.revision = scenes[sceneIndex].slides.getRevision(); // In case building indexed the scene
+        drawListKey = key;
+        drawListValid = true;
+    }
+    PROFILE_COUNTER("Draw commands", drawList.size());
 
-void Render::drawElement(const SceneElement& sceneElement, const Element& element, float currentTime, int currentSlide, int characterCount, int currentCharacterIndex, float spacing, float startX, Font customFont) {
-    if (element.type == ElementType::TEXT) {
-        const auto& text = std::get<TextElement>(element.data);
-        int textWidth = MeasureText(text.content.c_str(), 20);
-        DrawTextEx(customFont, text.content.c_str(), (Vector2){int(GetScreenWidth() - textWidth) / 2,  GetScreenHeight() - 50}, 20, 2,  BLACK);
-        // DrawText(text.content.c_str(),
-        //          (GetScreenWidth() - textWidth) / 2,
-        //          GetScreenHeight() - 50,
-        //          20,
-        //          BLACK);
-    } else if (element.type == ElementType::BACKGROUND) {
-        const auto& bg = std::get<BackgroundElement>(element.data);
-        if (bg.texture.id > 0) {
-            float scaleX = (float)GetScreenWidth() / bg.texture.width;
-            float scaleY = (float)GetScreenHeight() / bg.texture.height;
-            float scale = std::max(scaleX, scaleY);
-            DrawTextureEx(bg.texture,
-                          {0, 0},
-                          0.0f,
-                          scale,
-                          WHITE);
+    for (const DrawCommand& command : drawList) {
+        if (command.kind == DrawCommand::Kind::TEXT) {
+            const auto* text = std::get_if<TextElement>(&elements[command.element.elementIndex].data);
+            if (text != nullptr) {
+                DrawTextEx(customFont, text->content.c_str(), {command.dest.x, command.dest.y}, 20, 2, command.tint);
+            }
+            continue;
         }
-    } else if (element.type == ElementType::CHARACTER) {
-        const auto& character = std::get<CharacterElement>(element.data);
-        for (size_t i = 0; i < character.images.size(); ++i) {
-            if (character.images[i].first == sceneElement.selectedPose && i < character.textures.size() &&
-                character.textures[i].id > 0) {
-                float scale = 0.5f;
-                float characterWidth = character.textures[i].width * scale;
-                // Calculate posX: startX + index * (characterWidth + spacing)
-                float posX = startX + currentCharacterIndex * (characterWidth + spacing);
-                float posY = GetScreenHeight() - character.textures[i].height * scale-60;
-                DrawTextureEx(character.textures[i],
-                              {posX, posY},
-                              0.0f,
-                              scale,
-                              WHITE);
-                TraceLog(LOG_INFO, "Rendering character '%s' at posX=%.2f, posY=%.2f, positionIndex=%d",
-                         character.name.c_str(), posX, posY, character.positionIndex);
-                break;
+        const TextureHandle* texture = findTexture(command.element);
+        if (texture == nullptr) continue;
+        texture->touch(); // Keeps it resident under the VRAM budget, reloads it if evicted
+        if (texture->isReady()) {
+            DrawTexturePro(texture->get(), command.source, command.dest, {0, 0}, 0.0f, command.tint);
+        } else if (texture->isPending()) {
+            // Placeholder until the image finishes loading
+            ++placeholderCount;
+            if (command.kind == DrawCommand::Kind::BACKGROUND) {
+                DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), LIGHTGRAY);
+            } else {
+                DrawRectangleRounded(command.dest, 0.1f, 8, Fade(LIGHTGRAY, 0.6f));
             }
         }
     }
 }
 
+const TextureHandle* Render::findTexture(const ElementRef& ref) const {
+    if (!elements.isAlive(ref.elementIndex)) return nullptr;
+    const Element& element = elements[ref.elementIndex];
+    if (const auto* background = std::get_if<BackgroundElement>(&element.data)) {
+        return &background->texture;
+    }
+    if (const auto* character = std::get_if<CharacterElement>(&element.data)) {
+        return ref.pose < character->textures.size() ? &character->textures[ref.pose] : nullptr;
+    }
+    return nullptr;
+}
+
 void Render::setCurrentNodeIndex(int index) {
-    if (index >= 0 && index < (int)nodes.size()) {
+    if (index >= 0 && nodes.isAlive(index)) {
         currentNodeIndex = index;
         currentSlide = 1; // Reset slide when changing nodes
         scrollOffset.y = 0.0f;
-        TraceLog(LOG_INFO, "Set current node to %d (sceneIndex: %d)", currentNodeIndex, nodes[currentNodeIndex].sceneIndex);
+        LogInfo("Set current node to %d (sceneIndex: %d)", currentNodeIndex, nodes[currentNodeIndex].sceneIndex);
     } else {
-        TraceLog(LOG_ERROR, "Attempted to set invalid node index %d", index);
+        LogError("Attempted to set invalid node index %d", index);
     }
 }
 
@@ -275,13 +386,13 @@ int Render::getCurrentNodeIndex() const {
 
 void Render::nextSlide() {
     currentSlide++;
-    TraceLog(LOG_INFO, "Advanced to slide %d", currentSlide);
+    LogInfo("Advanced to slide %d", currentSlide);
 }
 
 void Render::prevSlide() {
     if (currentSlide > 1) {
         currentSlide--;
-        TraceLog(LOG_INFO, "Moved back to slide %d", currentSlide);
+        LogInfo("Moved back to slide %d", currentSlide);
     }
 }
 
@@ -297,18 +408,19 @@ void Render::resetSlide() {
     }
     // Fallback to first node if no start node is found
     if (!foundStartNode && !nodes.empty()) {
-        currentNodeIndex = 0;
-        TraceLog(LOG_WARNING, "No start node found, falling back to node 0 (sceneIndex: %d)", nodes[0].sceneIndex);
+        currentNodeIndex = (int)nodes.firstAlive();
+        LogWarning("No start node found, falling back to node %d (sceneIndex: %d)", currentNodeIndex,
+                 nodes[currentNodeIndex].sceneIndex);
     } else if (!foundStartNode) {
         currentNodeIndex = -1;
-        TraceLog(LOG_ERROR, "No nodes available for reset");
+        LogError("No nodes available for reset");
     }
     currentSlide = 1;
     scrollOffset.y = 0.0f;
-    if (currentNodeIndex >= 0 && nodes[currentNodeIndex].sceneIndex >= 0 && nodes[currentNodeIndex].sceneIndex < (int)scenes.size()) {
-        TraceLog(LOG_INFO, "Reset to node %d (sceneIndex: %d) and slide 1", currentNodeIndex, nodes[currentNodeIndex].sceneIndex);
+    if (currentNodeIndex >= 0 && findScene(scenes, nodes[currentNodeIndex]) != nullptr) {
+        LogInfo("Reset to node %d (sceneIndex: %d) and slide 1", currentNodeIndex, nodes[currentNodeIndex].sceneIndex);
     } else {
-        TraceLog(LOG_WARNING, "Reset failed: invalid node %d or sceneIndex %d", currentNodeIndex, currentNodeIndex >= 0 ? nodes[currentNodeIndex].sceneIndex : -1);
+        LogWarning("Reset failed: invalid node %d or sceneIndex %d", currentNodeIndex, currentNodeIndex >= 0 ? nodes[currentNodeIndex].sceneIndex : -1);
     }
 }
 
@@ -317,15 +429,9 @@ int Render::getCurrentSlide() const {
 }
 
 bool Render::canGoNext() const {
-    if (currentNodeIndex < 0 || currentNodeIndex >= (int)nodes.size()) return false;
-    if (nodes[currentNodeIndex].sceneIndex < 0 || nodes[currentNodeIndex].sceneIndex >= (int)scenes.size()) return false;
-    const Scene& scene = scenes[nodes[currentNodeIndex].sceneIndex];
-    for (const auto& sceneElement : scene.elements) {
-        if (sceneElement.elementIndex < elements.size() && sceneElement.endTime > currentSlide) {
-            return true;
-        }
-    }
-    return false;
+    if (currentNodeIndex < 0 || !nodes.isAlive(currentNodeIndex)) return false;
+    const Scene* scene = findScene(scenes, nodes[currentNodeIndex]);
+    return scene != nullptr && scene->slides.hasSlideAfter(currentSlide);
 }
 
 bool Render::canGoPrev() const {
@@ -4,6 +4,7 @@
 // #define RAYGUI_IMPLEMENTATION
 // #include "raygui.h"
 #include "Types.hpp"
+#include "AssetPrefetcher.hpp"
 // #include "raylib.h"
 // #include "raygui.h"
 #include <raylib.h>
@@ -13,7 +14,7 @@
 
 class Render {
 public:
-    Render(std::vector<Element>& elements, std::vector<Scene>& scenes, std::vector<Node>& nodes);
+    Render(ElementMap& elements, SceneMap& scenes, NodeMap& nodes);
     void update(float currentTime, int currentSlide);
     void draw(Font customFont);
     void setCurrentNodeIndex(int index);
@@ -24,19 +25,88 @@ public:
     int getCurrentSlide() const; // New: Get current slide
     bool canGoNext() const; // New: Check if next slide is available
     bool canGoPrev() const; // New: Check if previous slide is available
+    size_t getChoiceCount() const; // Choices offered by the current node
+    bool isShowingChoices() const { return showButtons; }
+    bool chooseConnection(size_t choice); // Follow a choice as its button would; false if it leads nowhere
+    // False ignores the keyboard, mouse wheel and buttons, for driving the renderer from code
+    void setInputEnabled(bool enabled) { inputEnabled = enabled; }
+    // Textures drawn as loading placeholders last frame
+    size_t getPlaceholderCount() const { return placeholderCount; }
+    void setPrefetchDepth(int depth); // Negative disables prefetch (textures stay as imported)
+    // After elements or scenes were edited: refetches assets and rebuilds the draw list
+    void invalidate()
+    {
+        prefetcher.invalidate();
+        drawListValid = false;
+    }
 
 private:
-    std::vector<Element>& elements;
-    std::vector<Scene>& scenes;
-    std::vector<Node>& nodes;
+    ElementMap& elements;
+    SceneMap& scenes;
+    NodeMap& nodes;
     int currentNodeIndex;
     int currentSlide; // New: Track slide internally
     Vector2 scrollOffset;
     float buttonSpacing;
     bool showButtons;
+    AssetPrefetcher prefetcher;
+    bool prefetchEnabled;
+    bool inputEnabled;
+    size_t placeholderCount;
+    // Positions in the scene's element list of what is on screen, as of the
+    // scene, slide and index revision below
+    std::vector<size_t> activeElements;
+    int activeSceneIndex;
+    int activeSlide;
+    uint64_t activeRevision;
 
-    void drawScene(const Scene& scene, float currentTime, int currentSlide, Font customFont);
-    void drawElement(const SceneElement& sceneElement, const Element& element, float currentTime, int currentSlide, int characterCount, int currentCharacterIndex, float spacing, float margin, Font customFont);
+
+    // An element's texture or text by position rather than by pointer: the
+    // prefetcher may resize a character's textures while the draw list is
+    // cached, so handles are looked up again every frame
+    struct ElementRef
+    {
+        size_t elementIndex;
+        size_t pose; // CHARACTER only
+    };
+    // One textured quad or line of text of the scene, laid out and in draw order
+    struct DrawCommand
+    {
+        enum class Kind { TEXT, BACKGROUND, CHARACTER };
+        Kind kind;
+        ElementRef element;
+        Rectangle source;
+        Rectangle dest;               // TEXT uses the position only
+        Color tint;
+        int layer;                    // Position in the draw order
+    };
+    // What the draw list was built for; any change rebuilds it
+    struct DrawListKey
+    {
+        int sceneIndex;
+        int slide;
+        uint64_t revision; // Of the scene's SlideIndex
+        int screenWidth;
+        int screenHeight;
+        size_t elementCount; // Slots of the element list commands refer to
+
+        bool operator==(const DrawListKey& other) const
+        {
+            return sceneIndex == other.sceneIndex && slide == other.slide && revision == other.revision &&
+                   screenWidth == other.screenWidth && screenHeight == other.screenHeight &&
+                   elementCount == other.elementCount;
+        }
+    };
+    // Retained so a steady frame neither allocates nor sorts
+    std::vector<DrawCommand> drawList;
+    std::vector<ElementRef> unsizedTextures; // Laid out with a stand-in size until decoded
+    DrawListKey drawListKey;
+    bool drawListValid;
+
+    bool refreshActiveElements(int sceneIndex); // False if the cached set was still current
+    void buildDrawList(int sceneIndex);
+    void drawScene(int sceneIndex, Font customFont);
+    const TextureHandle* findTexture(const ElementRef& ref) const; // Null if the element no longer has it
 };
 
 #endif // RENDER_HPP
@@ -1,9 +1,11 @@
 #include "SceneEditor.hpp"
 #include "FileUtils.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
 #include <algorithm>
 #include <fstream>
 
-SceneEditor::SceneEditor(std::vector<Element>& elements, std::vector<Scene>& scenes)
+SceneEditor::SceneEditor(ElementMap& elements, SceneMap& scenes)
     : elements(elements), scenes(scenes) {
     currentSceneIndex = -1;
     currentSceneElementIndex = -1;
@@ -21,10 +23,11 @@ SceneEditor::SceneEditor(std::vector<Element>& elements, std::vector<Scene>& sce
 }
 
 void SceneEditor::update() {
+    PROFILE_ZONE("SceneEditor::update");
     updateSceneMode();
 }
 
-std::vector<Scene>& SceneEditor::getScenes() {
+SceneMap& SceneEditor::getScenes() {
     return scenes;
 }
 
@@ -45,7 +48,7 @@ void SceneEditor::updateSceneMode() {
     if (mouseWheelMove != 0) {
         if (CheckCollisionPointRec(GetMousePosition(), (Rectangle){10.0f, 50.0f, 200.0f, 500.0f})) {
             sceneScrollOffset -= mouseWheelMove * 20.0f;
-            float maxScroll = scenes.size() * 40.0f - 500.0f;
+            float maxScroll = scenes.liveCount() * 40.0f - 500.0f;
             if (maxScroll < 0) maxScroll = 0;
             sceneScrollOffset = sceneScrollOffset < 0 ? 0 : sceneScrollOffset > maxScroll ? maxScroll : sceneScrollOffset;
         } else if (currentSceneIndex >= 0 && CheckCollisionPointRec(GetMousePosition(), (Rectangle){280.0f, 220.0f, 640.0f, 370.0f})) {
@@ -74,11 +77,11 @@ void SceneEditor::updateSceneMode() {
 
         if (newFocusedTextBox != -1) {
             focusedTextBox = newFocusedTextBox;
-            TraceLog(LOG_INFO, "Focused TextBox set to %d", focusedTextBox);
+            LogInfo("Focused TextBox set to %d", focusedTextBox);
         } else if (!CheckCollisionPointRec(mousePos, (Rectangle){220.0f, 10.0f, 770.0f, 580.0f}) &&
                    !CheckCollisionPointRec(mousePos, (Rectangle){280.0f, 220.0f, 640.0f, 370.0f})) {
             focusedTextBox = -1;
-            TraceLog(LOG_INFO, "Focused TextBox cleared");
+            LogInfo("Focused TextBox cleared");
         }
     }
 }
@@ -93,6 +96,7 @@ void SceneEditor::clearBuffers() {
 }
 
 void SceneEditor::draw() {
+    PROFILE_ZONE("SceneEditor::draw");
     // DrawText("Mode: Scene", 10, 10, 10, DARKGRAY);
     // DrawText(TextFormat("Focused TextBox: %d", focusedTextBox), 10, 20, 10, DARKGRAY);
     // DrawText(TextFormat("Is Editing: %d", isEditing), 10, 30, 10, DARKGRAY);
@@ -105,8 +109,10 @@ void SceneEditor::draw() {
 void SceneEditor::drawSceneMode() {
     GuiGroupBox((Rectangle){10.0f, 10.0f, 200.0f, 580.0f}, "Scenes");
     BeginScissorMode(10, 50, 200, 500);
+    size_t row = 0;
     for (size_t i = 0; i < scenes.size(); ++i) {
-        float yPos = 50.0f + static_cast<float>(i) * 40.0f - sceneScrollOffset;
+        if (!scenes.isAlive(i)) continue;
+        float yPos = 50.0f + static_cast<float>(row++) * 40.0f - sceneScrollOffset;
         if (yPos > -40.0f && yPos < 550.0f) {
             if (GuiButton((Rectangle){20.0f, yPos, 180.0f, 30.0f}, scenes[i].name.c_str())) {
                 currentSceneIndex = i;
@@ -115,15 +121,15 @@ void SceneEditor::drawSceneMode() {
                 isEditing = true;
                 focusedTextBox = -1;
                 loadSceneToUI();
-                TraceLog(LOG_INFO, "Selected Scene %d", currentSceneIndex);
+                LogInfo("Selected Scene %d", currentSceneIndex);
             }
         }
     }
     EndScissorMode();
 
-    float maxScroll = scenes.size() * 40.0f - 500.0f;
+    float maxScroll = scenes.liveCount() * 40.0f - 500.0f;
     if (maxScroll > 0) {
-        float scrollBarHeight = 500.0f * (500.0f / (scenes.size() * 40.0f));
+        float scrollBarHeight = 500.0f * (500.0f / (scenes.liveCount() * 40.0f));
         float scrollBarY = 50.0f + (sceneScrollOffset / maxScroll) * (500.0f - scrollBarHeight);
         DrawRectangle(190, scrollBarY, 10, scrollBarHeight, DARKGRAY);
     }
@@ -140,7 +146,7 @@ void SceneEditor::drawSceneMode() {
         renderLevelBuffer[0] = '\0';
         positionIndexBuffer[0] = '\0'; // Added for positionIndex
         poseBuffer[0] = '\0';
-        TraceLog(LOG_INFO, "Creating new Scene");
+        LogInfo("Creating new Scene");
     }
 
     if (GuiButton((Rectangle){20.0f, 510.0f, 180.0f, 30.0f}, "Export to JSON")) {
@@ -149,7 +155,7 @@ void SceneEditor::drawSceneMode() {
 
     GuiGroupBox((Rectangle){220.0f, 10.0f, 770.0f, 580.0f}, "Scene Editor");
 
-    if (currentSceneIndex == -1 || currentSceneIndex < (int)scenes.size()) {
+    if (currentSceneIndex == -1 || scenes.isAlive(currentSceneIndex)) {
         GuiLabel((Rectangle){230.0f, 30.0f, 100.0f, 20.0f}, "Scene Name:");
         GuiTextBox((Rectangle){340.0f, 30.0f, 200.0f, 20.0f}, sceneNameBuffer, 256, focusedTextBox == 6);
 
@@ -160,13 +166,13 @@ void SceneEditor::drawSceneMode() {
                 float yPos = 250.0f + static_cast<float>(i) * 40.0f - sceneElementScrollOffset;
                 if (yPos > -40.0f && yPos < 590.0f) {
                     size_t elemIndex = scenes[currentSceneIndex].elements[i].elementIndex;
-                    if (elemIndex < elements.size()) {
-                        std::string elementInfo = elements[elemIndex].name +
+                    if (const Element* element = findElement(elements, scenes[currentSceneIndex].elements[i])) {
+                        std::string elementInfo = element->name +
                             TextFormat(" [%.1f - %.1f, Lvl %d",
                                      scenes[currentSceneIndex].elements[i].startTime,
                                      scenes[currentSceneIndex].elements[i].endTime,
                                      scenes[currentSceneIndex].elements[i].renderlevel);
-                        if (elements[elemIndex].type == ElementType::CHARACTER) {
+                        if (element->type == ElementType::CHARACTER) {
                             elementInfo += TextFormat(", Pos %d", scenes[currentSceneIndex].elements[i].positionIndex);
                             if (!scenes[currentSceneIndex].elements[i].selectedPose.empty()) {
                                 elementInfo += ", " + scenes[currentSceneIndex].elements[i].selectedPose;
@@ -176,7 +182,7 @@ void SceneEditor::drawSceneMode() {
                         Color buttonColor = (static_cast<int>(i) == currentSceneElementIndex) ? SKYBLUE : LIGHTGRAY;
                         GuiSetStyle(BUTTON, BASE_COLOR_NORMAL, ColorToInt(buttonColor));
                         if (GuiButton((Rectangle){280.0f, yPos, 300.0f, 30.0f}, elementInfo.c_str())) {
-                            TraceLog(LOG_INFO, "Clicked SceneElement %d (ElementIndex=%zu)", i, elemIndex);
+                            LogInfo("Clicked SceneElement %zu (ElementIndex=%zu)", i, elemIndex);
                             currentSceneElementIndex = i;
                             isEditing = true;
                             focusedTextBox = -1;
@@ -207,7 +213,7 @@ void SceneEditor::drawSceneMode() {
             poseBuffer[0] = '\0';
             isEditing = true;
             focusedTextBox = -1;
-            TraceLog(LOG_INFO, "Adding new SceneElement");
+            LogInfo("Adding new SceneElement");
         }
 
         if (currentSceneIndex >= 0 && GuiButton((Rectangle){850.0f, 60.0f, 120.0f, 20.0f}, "Sort Elements")) {
@@ -223,51 +229,62 @@ void SceneEditor::drawSceneMode() {
                 positionIndexBuffer[0] = '\0'; // Added for positionIndex
                 poseBuffer[0] = '\0';
             }
-            TraceLog(LOG_INFO, "Sorted SceneElements");
+            LogInfo("Sorted SceneElements");
+        }
+
+        if (currentSceneIndex >= 0 && nodes != nullptr && GuiButton((Rectangle){850.0f, 120.0f, 120.0f, 20.0f}, "Delete Scene")) {
+            deleteScene();
+            return;
         }
 
         if (currentSceneElementIndex >= -1 && (currentSceneIndex >= 0 || currentSceneIndex == -1)) {
+            // The dropdown lists live elements only; liveElements maps its positions to slots
+            std::vector<size_t> liveElements;
             std::string elementNames = elements.empty() ? "No Elements" : "";
             for (size_t i = 0; i < elements.size(); ++i) {
+                if (!elements.isAlive(i)) continue;
+                if (!liveElements.empty()) elementNames += ";";
                 elementNames += elements[i].name;
-                if (i < elements.size() - 1) elementNames += ";";
+                liveElements.push_back(i);
             }
             static int selectedElement = 0;
             if (currentSceneElementIndex != prevSceneElementIndex) {
                 if (currentSceneIndex >= 0 && currentSceneElementIndex >= 0 &&
                     currentSceneElementIndex < (int)scenes[currentSceneIndex].elements.size()) {
-                    selectedElement = scenes[currentSceneIndex].elements[currentSceneElementIndex].elementIndex;
-                    TraceLog(LOG_INFO, "Set selectedElement to %d for SceneElement %d", selectedElement, currentSceneElementIndex);
+                    size_t slot = scenes[currentSceneIndex].elements[currentSceneElementIndex].elementIndex;
+                    selectedElement = (int)(std::find(liveElements.begin(), liveElements.end(), slot) - liveElements.begin());
+                    LogInfo("Set selectedElement to %d for SceneElement %d", selectedElement, currentSceneElementIndex);
                 } else if (currentSceneElementIndex == -1 && !elements.empty()) {
                     selectedElement = 0;
-                    TraceLog(LOG_INFO, "Reset selectedElement to 0 for new SceneElement");
+                    LogInfo("Reset selectedElement to 0 for new SceneElement");
                 }
                 prevSceneElementIndex = currentSceneElementIndex;
             }
             int prevSelectedElement = selectedElement;
             GuiComboBox((Rectangle){340.0f, 70.0f, 200.0f, 20.0f}, elementNames.c_str(), &selectedElement);
             if (prevSelectedElement != selectedElement) {
-                TraceLog(LOG_INFO, "Element dropdown changed to %d (prev=%d)", selectedElement, prevSelectedElement);
+                LogInfo("Element dropdown changed to %d (prev=%d)", selectedElement, prevSelectedElement);
                 // Reset pose and positionIndex when element changes
                 poseBuffer[0] = '\0';
                 positionIndexBuffer[0] = '\0'; // Added for positionIndex
             }
 
+            size_t selectedSlot = selectedElement >= 0 && selectedElement < (int)liveElements.size() ? liveElements[selectedElement] : ElementMap::NONE;
+
             // Pose selection for CharacterElement
             std::string poseNames = "None";
             static int selectedPoseIndex = 0;
-            if (selectedElement < elements.size() && elements[selectedElement].type == ElementType::CHARACTER) {
+            if (elements.isAlive(selectedSlot) && elements[selectedSlot].type == ElementType::CHARACTER) {
                 poseNames = "";
-                const auto& character = std::get<CharacterElement>(elements[selectedElement].data);
+                const auto& character = std::get<CharacterElement>(elements[selectedSlot].data);
                 for (size_t i = 0; i < character.images.size(); ++i) {
                     poseNames += character.images[i].first;
                     if (i < character.images.size() - 1) poseNames += ";";
                 }
                 if (currentSceneElementIndex != prevSceneElementIndex && currentSceneIndex >= 0 && currentSceneElementIndex >= 0) {
                     const auto& sceneElement = scenes[currentSceneIndex].elements[currentSceneElementIndex];
-                    auto it = std::find_if(character.images.begin(), character.images.end(),
-                        [&](const auto& img) { return img.first == sceneElement.selectedPose; });
-                    selectedPoseIndex = (it != character.images.end()) ? std::distance(character.images.begin(), it) : 0;
+                    int pose = findPose(character, sceneElement);
+                    selectedPoseIndex = pose >= 0 ? pose : 0;
                     strncpy(poseBuffer, sceneElement.selectedPose.c_str(), sizeof(poseBuffer));
                 }
             } else {
@@ -283,13 +300,13 @@ void SceneEditor::drawSceneMode() {
             GuiTextBox((Rectangle){340.0f, 130.0f, 100.0f, 20.0f}, endTimeBuffer, 32, focusedTextBox == 8);
             GuiLabel((Rectangle){230.0f, 160.0f, 100.0f, 20.0f}, "Render Level:");
             GuiTextBox((Rectangle){340.0f, 160.0f, 100.0f, 20.0f}, renderLevelBuffer, 32, focusedTextBox == 9);
-            if (selectedElement < elements.size() && elements[selectedElement].type == ElementType::CHARACTER) {
+            if (elements.isAlive(selectedSlot) && elements[selectedSlot].type == ElementType::CHARACTER) {
                 GuiLabel((Rectangle){230.0f, 190.0f, 100.0f, 20.0f}, "Position Index:");
                 GuiTextBox((Rectangle){340.0f, 190.0f, 100.0f, 20.0f}, positionIndexBuffer, 32, focusedTextBox == 10);
             }
 
             if (!elements.empty() && GuiButton((Rectangle){850.0f, 90.0f, 100.0f, 20.0f}, currentSceneElementIndex == -1 ? "Add" : "Save")) {
-                saveSceneElement(selectedElement, selectedPoseIndex);
+                saveSceneElement(selectedSlot, selectedPoseIndex);
                 isEditing = false;
                 focusedTextBox = -1;
                 if (currentSceneElementIndex == -1) {
@@ -297,15 +314,15 @@ void SceneEditor::drawSceneMode() {
                     prevSceneElementIndex = currentSceneElementIndex;
                 }
                 loadSceneElementToUI();
-                TraceLog(LOG_INFO, "Saved SceneElement, set currentSceneElementIndex to %d", currentSceneElementIndex);
+                LogInfo("Saved SceneElement, set currentSceneElementIndex to %d", currentSceneElementIndex);
             }
         }
     }
 }
 
 void SceneEditor::loadSceneToUI() {
-    TraceLog(LOG_INFO, "Loading Scene %d", currentSceneIndex);
-    if (currentSceneIndex < 0 || currentSceneIndex >= (int)scenes.size()) {
+    LogInfo("Loading Scene %d", currentSceneIndex);
+    if (currentSceneIndex < 0 || !scenes.isAlive(currentSceneIndex)) {
         strncpy(sceneNameBuffer, "New Scene", sizeof(sceneNameBuffer));
         startTimeBuffer[0] = '\0';
         endTimeBuffer[0] = '\0';
@@ -335,7 +352,7 @@ void SceneEditor::loadSceneToUI() {
 void SceneEditor::loadSceneElementToUI() {
     if (currentSceneIndex < 0 || currentSceneElementIndex < 0 ||
         currentSceneElementIndex >= (int)scenes[currentSceneIndex].elements.size()) {
-        TraceLog(LOG_INFO, "Clearing SceneElement UI (invalid selection: Scene=%d, SceneElement=%d)",
+        LogInfo("Clearing SceneElement UI (invalid selection: Scene=%d, SceneElement=%d)",
                  currentSceneIndex, currentSceneElementIndex);
         startTimeBuffer[0] = '\0';
         endTimeBuffer[0] = '\0';
@@ -351,14 +368,14 @@ void SceneEditor::loadSceneElementToUI() {
     snprintf(renderLevelBuffer, sizeof(renderLevelBuffer), "%d", sceneElement.renderlevel);
     snprintf(positionIndexBuffer, sizeof(positionIndexBuffer), "%d", sceneElement.positionIndex); // Added for positionIndex
     strncpy(poseBuffer, sceneElement.selectedPose.c_str(), sizeof(poseBuffer));
-    TraceLog(LOG_INFO, "Loaded SceneElement %d: ElementIndex=%zu, Start=%.1f, End=%.1f, RenderLevel=%d, PositionIndex=%d, Pose=%s",
+    LogInfo("Loaded SceneElement %d: ElementIndex=%zu, Start=%.1f, End=%.1f, RenderLevel=%d, PositionIndex=%d, Pose=%s",
              currentSceneElementIndex, sceneElement.elementIndex, sceneElement.startTime, sceneElement.endTime,
              sceneElement.renderlevel, sceneElement.positionIndex, sceneElement.selectedPose.c_str());
 }
 
 void SceneEditor::saveSceneElement(size_t selectedElementIndex, int selectedPoseIndex) {
-    if (selectedElementIndex >= elements.size()) {
-        TraceLog(LOG_WARNING, "Invalid selectedElementIndex %zu", selectedElementIndex);
+    if (!elements.isAlive(selectedElementIndex)) {
+        LogWarning("Invalid selectedElementIndex %zu", selectedElementIndex);
         return;
     }
 
@@ -387,13 +404,13 @@ void SceneEditor::saveSceneElement(size_t selectedElementIndex, int selectedPose
 
     if (elements[selectedElementIndex].type == ElementType::CHARACTER) {
         const auto& character = std::get<CharacterElement>(elements[selectedElementIndex].data);
-        if (selectedPoseIndex >= 0 && selectedPoseIndex < (int)character.images.size()) {
-            sceneElement.selectedPose = character.images[selectedPoseIndex].first;
-        } else {
-            sceneElement.selectedPose = character.images.empty() ? "" : character.images[0].first;
+        if (selectedPoseIndex < 0 || selectedPoseIndex >= (int)character.images.size()) selectedPoseIndex = 0;
+        if (selectedPoseIndex < (int)character.images.size()) {
+            sceneElement.setPose(character.images[selectedPoseIndex].first);
+            sceneElement.poseIndex = selectedPoseIndex;
         }
     } else {
-        sceneElement.selectedPose = "";
+        sceneElement.setPose("");
         sceneElement.positionIndex = 0; // Ensure non-character elements have positionIndex 0
     }
 
@@ -401,8 +418,7 @@ void SceneEditor::saveSceneElement(size_t selectedElementIndex, int selectedPose
         Scene newScene;
         newScene.name = sceneNameBuffer;
         newScene.elements.push_back(sceneElement);
-        scenes.push_back(newScene);
-        currentSceneIndex = scenes.size() - 1;
+        currentSceneIndex = (int)scenes.insert(newScene);
         currentSceneElementIndex = 0;
         prevSceneElementIndex = 0;
     } else {
@@ -415,22 +431,25 @@ void SceneEditor::saveSceneElement(size_t selectedElementIndex, int selectedPose
         }
         scenes[currentSceneIndex].name = sceneNameBuffer;
     }
-    TraceLog(LOG_INFO, "Saved SceneElement: Index=%d, ElementIndex=%zu, Start=%.1f, End=%.1f, RenderLevel=%d, PositionIndex=%d, Pose=%s",
+    linkScene(elements, scenes, currentSceneIndex);
+    indexSlides(elements, scenes[currentSceneIndex]);
+    LogInfo("Saved SceneElement: Index=%d, ElementIndex=%zu, Start=%.1f, End=%.1f, RenderLevel=%d, PositionIndex=%d, Pose=%s",
              currentSceneElementIndex, sceneElement.elementIndex, sceneElement.startTime, sceneElement.endTime,
              sceneElement.renderlevel, sceneElement.positionIndex, sceneElement.selectedPose.c_str());
+    if (observer) observer->sceneChanged(currentSceneIndex);
     loadSceneElementToUI();
 }
 
 void SceneEditor::sortSceneElements() {
-    if (currentSceneIndex < 0 || currentSceneIndex >= (int)scenes.size()) return;
+    if (currentSceneIndex < 0 || !scenes.isAlive(currentSceneIndex)) return;
 
     std::sort(scenes[currentSceneIndex].elements.begin(),
               scenes[currentSceneIndex].elements.end(),
               [this](const SceneElement& a, const SceneElement& b) {
-                  size_t aIndex = a.elementIndex < elements.size() ? a.elementIndex : 0;
-                  size_t bIndex = b.elementIndex < elements.size() ? b.elementIndex : 0;
-                  bool aIsCharacter = aIndex < elements.size() && elements[aIndex].type == ElementType::CHARACTER;
-                  bool bIsCharacter = bIndex < elements.size() && elements[bIndex].type == ElementType::CHARACTER;
+                  const Element* aElement = findElement(elements, a);
+                  const Element* bElement = findElement(elements, b);
+                  bool aIsCharacter = aElement != nullptr && aElement->type == ElementType::CHARACTER;
+                  bool bIsCharacter = bElement != nullptr && bElement->type == ElementType::CHARACTER;
 
                   if (a.startTime != b.startTime) return a.startTime < b.startTime;
                   if (aIsCharacter && bIsCharacter) {
@@ -440,7 +459,21 @@ void SceneEditor::sortSceneElements() {
                   }
                   return a.endTime < b.endTime;
               });
-    TraceLog(LOG_INFO, "Sorted SceneElements for Scene %d", currentSceneIndex);
+    indexSlides(elements, scenes[currentSceneIndex]);
+    if (observer) observer->sceneChanged(currentSceneIndex);
+    LogInfo("Sorted SceneElements for Scene %d", currentSceneIndex);
+}
+
+// Nodes that showed the scene show none; its slot is only reused by a later scene
+void SceneEditor::deleteScene() {
+    if (currentSceneIndex < 0 || nodes == nullptr) return;
+    LogInfo("Deleted Scene %d", currentSceneIndex);
+    eraseScene(scenes, *nodes, currentSceneIndex);
+    if (observer) observer->sceneErased(currentSceneIndex);
+    currentSceneIndex = -1;
+    currentSceneElementIndex = -1;
+    prevSceneElementIndex = -1;
+    isEditing = false;
 }
 
 void SceneEditor::exportToJson() {
@@ -476,9 +509,9 @@ void SceneEditor::exportToJson() {
         j_scene["name"] = scene.name;
         json j_scene_elements = json::array();
         for (const auto& sceneElement : scene.elements) {
-            if (sceneElement.elementIndex < elements.size()) {
+            if (const Element* element = findElement(elements, sceneElement)) {
                 json j_scene_element;
-                j_scene_element["element_name"] = elements[sceneElement.elementIndex].name;
+                j_scene_element["element_name"] = element->name;
                 j_scene_element["start_time"] = sceneElement.startTime;
                 j_scene_element["end_time"] = sceneElement.endTime;
                 j_scene_element["render_level"] = sceneElement.renderlevel;
@@ -497,5 +530,5 @@ void SceneEditor::exportToJson() {
     std::ofstream file("elements_and_scenes.json");
     file << j_export.dump(4);
     file.close();
-    TraceLog(LOG_INFO, "Exported to elements_and_scenes.json");
+    LogInfo("Exported to elements_and_scenes.json");
 }
@@ -5,6 +5,7 @@
 #include "raygui.h"
 
 #include "Types.hpp"
+#include "ProjectObserver.hpp"
 #include "BasicUI.hpp"
 
 #include <vector>
@@ -14,14 +15,18 @@
 class SceneEditor : BasicUI
 {
 public:
-    SceneEditor(std::vector<Element>& elements, std::vector<Scene>& scenes);
+    SceneEditor(ElementMap& elements, SceneMap& scenes);
     void update();
     void draw();
-    std::vector<Scene>& getScenes();
+    SceneMap& getScenes();
+    void setObserver(ProjectObserver* observer) { this->observer = observer; }
+    // Nodes showing a deleted scene are told it is gone (see eraseScene)
+    void setNodes(NodeMap* nodes) { this->nodes = nodes; }
 
 private:
-    std::vector<Element>& elements; // Reference to shared elements
-    std::vector<Scene>& scenes;     // Reference to shared scenes
+    ElementMap& elements; // Reference to shared elements
+    SceneMap& scenes;     // Reference to shared scenes
+    NodeMap* nodes = nullptr;
     int currentSceneIndex;
     int currentSceneElementIndex;
     int prevSceneElementIndex;
@@ -35,6 +40,7 @@ private:
     char renderLevelBuffer[32];
     char positionIndexBuffer[32];
     char poseBuffer[32];
+    ProjectObserver* observer = nullptr;
 
     void updateSceneMode();
 
@@ -45,6 +51,7 @@ private:
     // void saveSceneElement1(size_t selectedElementIndex);
     void saveSceneElement(size_t selectedElementIndex, int selectedPoseIndex);
     void sortSceneElements();
+    void deleteScene();
     void exportToJson();
 };
 
@@ -0,0 +1,97 @@
+#ifndef SLIDE_INDEX_HPP
+#define SLIDE_INDEX_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// When each of a scene's elements is on screen, sorted so the renderer never
+// scans the scene per frame: how many elements slide k shows and whether a
+// later slide exists are answered in O(log n) / O(1), and the elements of
+// slide k are listed from a binary-searched prefix. Built from the scene's
+// elements on load and whenever the scene is edited; an element is shown on
+// slide k when startTime <= k <= endTime.
+class SlideIndex
+{
+public:
+    // Scene elements isShown rejects (their element is gone) are left out, as
+    // the renderer skips them
+    template <typename SceneElementList, typename Predicate>
+    void build(const SceneElementList& sceneElements, Predicate isShown)
+    {
+        intervals.clear();
+        ends.clear();
+        hasElements = false;
+        maxEndTime = 0.0f;
+        for (size_t i = 0; i < sceneElements.size(); ++i)
+        {
+            const auto& sceneElement = sceneElements[i];
+            if (!isShown(sceneElement)) continue;
+            hasElements = true;
+            maxEndTime = std::max(maxEndTime, sceneElement.endTime);
+            // An element ending before it starts is never on screen but still
+            // counts towards the last slide
+            if (sceneElement.endTime < sceneElement.startTime) continue;
+            intervals.push_back({sceneElement.startTime, sceneElement.endTime, i});
+            ends.push_back(sceneElement.endTime);
+        }
+        std::sort(intervals.begin(), intervals.end(),
+                  [](const Interval& a, const Interval& b) { return a.start < b.start; });
+        std::sort(ends.begin(), ends.end());
+        revision = nextRevision()++;
+    }
+
+    // Number of elements on screen at slide
+    size_t countActive(float slide) const
+    {
+        size_t started = std::upper_bound(intervals.begin(), intervals.end(), slide,
+                                          [](float value, const Interval& interval) { return value < interval.start; }) -
+                         intervals.begin();
+        size_t ended = std::lower_bound(ends.begin(), ends.end(), slide) - ends.begin();
+        return started - ended;
+    }
+
+    // Positions in the scene's element list of the elements on screen at
+    // slide, in list order; out is reused to avoid reallocating
+    void getActive(float slide, std::vector<size_t>& out) const
+    {
+        out.clear();
+        for (const auto& interval : intervals)
+        {
+            if (interval.start > slide) break;
+            if (interval.end >= slide) out.push_back(interval.position);
+        }
+        std::sort(out.begin(), out.end());
+    }
+
+    bool empty() const { return !hasElements; }
+    float getMaxEndTime() const { return maxEndTime; }
+    // Whether an element is still on screen after slide
+    bool hasSlideAfter(float slide) const { return hasElements && maxEndTime > slide; }
+    // Changes on every build, so a cache of what was read from the index can tell it is stale
+    uint64_t getRevision() const { return revision; }
+
+private:
+    struct Interval
+    {
+        float start;
+        float end;
+        size_t position;
+    };
+
+    static std::atomic<uint64_t>& nextRevision()
+    {
+        static std::atomic<uint64_t> counter{1};
+        return counter;
+    }
+
+    std::vector<Interval> intervals; // By start time
+    std::vector<float> ends;         // Sorted end times of intervals
+    float maxEndTime = 0.0f;
+    bool hasElements = false;
+    uint64_t revision = 0; // 0 = never built
+};
+
+#endif // SLIDE_INDEX_HPP
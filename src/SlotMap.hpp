@@ -0,0 +1,198 @@
+#ifndef SLOT_MAP_HPP
+#define SLOT_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+// Stable reference to a SlotMap item: its slot and the slot's generation when
+// the handle was taken. Once the item is erased the generation moves on, so
+// the handle no longer resolves even after the slot is reused.
+struct SlotHandle
+{
+    uint32_t index;
+    uint32_t generation;
+};
+
+// Vector-like container whose items keep their index for life. erase() is
+// O(1): the slot is emptied and its generation bumped instead of shifting
+// everything after it, and insert() reuses freed slots. Indices are therefore
+// sparse; size() counts slots (erased ones included) and range-for visits
+// live items only. Files store items densely (see denseIndices).
+template <typename T>
+class SlotMap
+{
+    struct Slot
+    {
+        T value;
+        uint32_t generation;
+        bool alive;
+    };
+
+public:
+    static constexpr size_t NONE = SIZE_MAX;
+
+    template <typename SlotType, typename Value>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        Iterator(SlotType* slot, SlotType* end) : slot(slot), end(end) { skipErased(); }
+
+        reference operator*() const { return slot->value; }
+        pointer operator->() const { return &slot->value; }
+        Iterator& operator++()
+        {
+            ++slot;
+            skipErased();
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return slot == other.slot; }
+        bool operator!=(const Iterator& other) const { return slot != other.slot; }
+
+    private:
+        void skipErased()
+        {
+            while (slot != end && !slot->alive) ++slot;
+        }
+
+        SlotType* slot;
+        SlotType* end;
+    };
+
+    using iterator = Iterator<Slot, T>;
+    using const_iterator = Iterator<const Slot, const T>;
+
+    iterator begin() { return iterator(slots.data(), slots.data() + slots.size()); }
+    iterator end() { return iterator(slots.data() + slots.size(), slots.data() + slots.size()); }
+    const_iterator begin() const { return const_iterator(slots.data(), slots.data() + slots.size()); }
+    const_iterator end() const { return const_iterator(slots.data() + slots.size(), slots.data() + slots.size()); }
+
+    size_t size() const { return slots.size(); }
+    size_t liveCount() const { return slots.size() - freeSlots.size(); }
+    bool empty() const { return freeSlots.size() == slots.size(); }
+
+    bool isAlive(size_t index) const { return index < slots.size() && slots[index].alive; }
+    uint32_t getGeneration(size_t index) const { return index < slots.size() ? slots[index].generation : 0; }
+    SlotHandle getHandle(size_t index) const { return {(uint32_t)index, getGeneration(index)}; }
+    bool contains(const SlotHandle& handle) const
+    {
+        return isAlive(handle.index) && slots[handle.index].generation == handle.generation;
+    }
+
+    T& operator[](size_t index) { return slots[index].value; }
+    const T& operator[](size_t index) const { return slots[index].value; }
+
+    // Store value in the most recently freed slot, or a new one; returns its index
+    size_t insert(T value)
+    {
+        if (freeSlots.empty())
+        {
+            push_back(std::move(value));
+            return slots.size() - 1;
+        }
+        size_t index = freeSlots.back();
+        freeSlots.pop_back();
+        slots[index].value = std::move(value);
+        slots[index].alive = true;
+        return index;
+    }
+
+    // Append a new slot, never reusing one (loading, where indices come from the file)
+    void push_back(T value) { slots.push_back({std::move(value), 0, true}); }
+
+    // Put value at exactly index: replaces a live item, revives an erased
+    // slot (its generation stays, handles to the erased item stay invalid) or
+    // appends when index == size(). Returns false for indices past that.
+    bool assign(size_t index, T value)
+    {
+        if (index == slots.size())
+        {
+            push_back(std::move(value));
+            return true;
+        }
+        if (index > slots.size()) return false;
+        if (!slots[index].alive)
+        {
+            for (size_t i = 0; i < freeSlots.size(); ++i)
+            {
+                if (freeSlots[i] == index)
+                {
+                    freeSlots.erase(freeSlots.begin() + i);
+                    break;
+                }
+            }
+            slots[index].alive = true;
+        }
+        slots[index].value = std::move(value);
+        return true;
+    }
+
+    void erase(size_t index)
+    {
+        if (!isAlive(index)) return;
+        Slot& slot = slots[index];
+        slot.value = T(); // Release what the item owns now, not when the slot is reused
+        slot.alive = false;
+        ++slot.generation;
+        freeSlots.push_back(index);
+    }
+
+    void clear()
+    {
+        slots.clear();
+        freeSlots.clear();
+    }
+
+    void reserve(size_t count) { slots.reserve(count); }
+
+    // Index of the first live item, NONE if there is none
+    size_t firstAlive() const
+    {
+        for (size_t i = 0; i < slots.size(); ++i)
+        {
+            if (slots[i].alive) return i;
+        }
+        return NONE;
+    }
+
+    // Position of every slot among the live items, NONE for erased slots:
+    // the index an item has once the erased slots are squeezed out
+    std::vector<size_t> denseIndices() const
+    {
+        std::vector<size_t> indices(slots.size(), NONE);
+        size_t next = 0;
+        for (size_t i = 0; i < slots.size(); ++i)
+        {
+            if (slots[i].alive) indices[i] = next++;
+        }
+        return indices;
+    }
+
+    // Copy in which every live item is replaced by makeCopy(item); erased slots,
+    // generations and free slots are kept, so handles resolve in both alike
+    template <typename Copy>
+    SlotMap copyWith(Copy makeCopy) const
+    {
+        SlotMap copy;
+        copy.slots.reserve(slots.size());
+        for (const Slot& slot : slots)
+        {
+            copy.slots.push_back({slot.alive ? makeCopy(slot.value) : T(), slot.generation, slot.alive});
+        }
+        copy.freeSlots = freeSlots;
+        return copy;
+    }
+
+private:
+    std::vector<Slot> slots;
+    std::vector<size_t> freeSlots;
+};
+
+#endif // SLOT_MAP_HPP
@@ -0,0 +1,250 @@
+#include "TextureCache.hpp"
+#include "AssetBundle.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
+#include <filesystem>
+#include <chrono>
+#include <algorithm>
+
+namespace fs = std::filesystem;
+
+TextureEntry::~TextureEntry() {
+    if (texture.id > 0 && IsWindowReady()) {
+        UnloadTexture(texture);
+    }
+}
+
+TextureCache& TextureCache::instance() {
+    static TextureCache cache;
+    return cache;
+}
+
+std::string TextureCache::makeKey(const std::string& path, std::string& canonicalPath, long& modTime) const {
+    std::error_code ec;
+    fs::path canonical = fs::weakly_canonical(path, ec);
+    canonicalPath = ec ? path : canonical.string();
+
+    modTime = 0;
+    auto writeTime = fs::last_write_time(canonicalPath, ec);
+    if (!ec) {
+        modTime = (long)std::chrono::duration_cast<std::chrono::seconds>(writeTime.time_since_epoch()).count();
+    }
+    return canonicalPath + "|" + std::to_string(modTime);
+}
+
+TextureHandle TextureCache::acquire(const std::string& path) {
+    if (path.empty()) {
+        return TextureHandle();
+    }
+
+    std::string canonicalPath;
+    long modTime = 0;
+    std::string key;
+    if (bundle && bundle->contains(path)) {
+        // Bundle assets can't change while mapped; the name is the identity
+        canonicalPath = path;
+        key = "bundle|" + path;
+    } else {
+        key = makeKey(path, canonicalPath, modTime);
+    }
+
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        if (auto shared = it->second.lock()) {
+            return TextureHandle(shared);
+        }
+    }
+
+    if (watcher && key.compare(0, 7, "bundle|") != 0) {
+        watcher->watch(fs::path(canonicalPath).parent_path().string());
+    }
+
+    auto entry = std::make_shared<TextureEntry>();
+    entry->path = canonicalPath;
+    entry->modTime = modTime;
+    entry->pending = true;
+    submit(entry);
+
+    entries[key] = entry;
+    if (entries.size() > pruneThreshold) {
+        prune();
+        pruneThreshold = std::max<size_t>(256, entries.size() * 2);
+    }
+    return TextureHandle(entry);
+}
+
+void TextureCache::enableHotReload(bool enabled) {
+    if (!enabled) {
+        watcher.reset();
+        return;
+    }
+    if (watcher) return;
+    watcher = std::make_unique<FileWatcher>();
+    // Pick up the directories of everything acquired before this call
+    for (const auto& [key, weak] : entries) {
+        auto entry = weak.lock();
+        if (entry && key.compare(0, 7, "bundle|") != 0) {
+            watcher->watch(fs::path(entry->path).parent_path().string());
+        }
+    }
+}
+
+void TextureCache::reloadChanged() {
+    std::vector<std::string> changed;
+    if (!watcher || !watcher->poll(changed)) return;
+    std::sort(changed.begin(), changed.end());
+
+    std::vector<std::pair<std::string, std::shared_ptr<TextureEntry>>> rekeyed;
+    for (auto it = entries.begin(); it != entries.end();) {
+        auto entry = it->second.lock();
+        if (!entry || it->first.compare(0, 7, "bundle|") == 0 ||
+            !std::binary_search(changed.begin(), changed.end(), entry->path)) {
+            ++it;
+            continue;
+        }
+
+        std::string canonicalPath;
+        long modTime = 0;
+        std::string key = makeKey(entry->path, canonicalPath, modTime);
+        entry->modTime = modTime;
+        // Evicted textures read the new file on their next touch() anyway. A
+        // decode already in flight may predate the write, so queue another;
+        // processUploads replaces whatever texture is current.
+        if (!entry->evicted) {
+            entry->pending = true;
+            submit(entry);
+        }
+        LogInfo("Reloading changed image: %s", entry->path.c_str());
+        if (key != it->first) {
+            rekeyed.emplace_back(key, entry);
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (const auto& [key, entry] : rekeyed) entries[key] = entry;
+}
+
+int TextureCache::processUploads(int maxTextures, size_t maxBytes) {
+    PROFILE_ZONE("TextureCache::processUploads");
+    reloadChanged();
+    if ((int)stagedUploads.size() < maxTextures) {
+        loader.poll(stagedUploads, maxTextures - stagedUploads.size());
+    }
+
+    int uploaded = 0;
+    size_t bytes = 0;
+    size_t consumed = 0;
+    for (; consumed < stagedUploads.size() && uploaded < maxTextures; ++consumed) {
+        ImageLoader::Result& result = stagedUploads[consumed];
+        auto entry = result.entry.lock();
+        if (!entry) {
+            if (result.image.data != nullptr) UnloadImage(result.image);
+            continue;
+        }
+        if (result.image.data == nullptr) {
+            entry->pending = false;
+            LogWarning("Failed to load image: %s", entry->path.c_str());
+            continue;
+        }
+
+        size_t imageBytes = GetPixelDataSize(result.image.width, result.image.height, result.image.format);
+        if (uploaded > 0 && bytes + imageBytes > maxBytes) {
+            // Keep width/height visible for layout while the upload waits a frame
+            entry->width = result.image.width;
+            entry->height = result.image.height;
+            break;
+        }
+
+        bool wasResident = entry->texture.id > 0;
+        if (wasResident) UnloadTexture(entry->texture); // Hot reload replaces the drawn texture
+        entry->texture = LoadTextureFromImage(result.image);
+        entry->width = entry->texture.width;
+        entry->height = entry->texture.height;
+        entry->pending = false;
+        entry->evicted = false;
+        entry->gpuBytes = GetPixelDataSize(entry->texture.width, entry->texture.height, entry->texture.format);
+        entry->lastUsedFrame = frame; // Counts as a use so fresh uploads are not evicted first
+        if (!wasResident) residentEntries.push_back(entry);
+        UnloadImage(result.image);
+        bytes += imageBytes;
+        ++uploaded;
+        LogInfo("Loaded texture ID %u for path %s", entry->texture.id, entry->path.c_str());
+    }
+    stagedUploads.erase(stagedUploads.begin(), stagedUploads.begin() + consumed);
+
+    enforceBudget();
+    ++frame;
+    PROFILE_COUNTER("Texture uploads", uploaded);
+    PROFILE_COUNTER("Pending textures", getPendingCount());
+    PROFILE_COUNTER("Texture VRAM (MB)", residentBytes / (1024.0 * 1024.0));
+    return uploaded;
+}
+
+void TextureCache::touch(const std::shared_ptr<TextureEntry>& entry) {
+    entry->lastUsedFrame = frame;
+    if (entry->evicted && !entry->pending) {
+        entry->pending = true;
+        submit(entry);
+    }
+}
+
+void TextureCache::submit(const std::shared_ptr<TextureEntry>& entry) {
+    bool inBundle = bundle && bundle->contains(entry->path);
+    loader.submit(entry->path, entry, inBundle ? bundle : nullptr);
+}
+
+void TextureCache::enforceBudget() {
+    // Recount from live entries; textures freed by their last handle simply drop out
+    residentBytes = 0;
+    size_t live = 0;
+    for (size_t i = 0; i < residentEntries.size(); ++i) {
+        auto entry = residentEntries[i].lock();
+        if (!entry || entry->texture.id == 0) continue;
+        residentBytes += entry->gpuBytes;
+        residentEntries[live++] = residentEntries[i];
+    }
+    residentEntries.resize(live);
+
+    if (budgetBytes == 0 || residentBytes <= budgetBytes) return;
+
+    std::vector<std::shared_ptr<TextureEntry>> candidates;
+    for (const auto& weak : residentEntries) {
+        auto entry = weak.lock();
+        // Anything drawn in the last frame stays, even if that means going over budget
+        if (entry && entry->lastUsedFrame + 1 < frame) candidates.push_back(entry);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto& a, const auto& b) { return a->lastUsedFrame < b->lastUsedFrame; });
+
+    for (const auto& entry : candidates) {
+        if (residentBytes <= budgetBytes) break;
+        UnloadTexture(entry->texture);
+        entry->texture = {0};
+        entry->evicted = true;
+        residentBytes -= entry->gpuBytes;
+        LogInfo("Evicted texture %s (%zu bytes, last used frame %llu)",
+                 entry->path.c_str(), entry->gpuBytes, entry->lastUsedFrame);
+    }
+    residentEntries.erase(std::remove_if(residentEntries.begin(), residentEntries.end(),
+                                         [](const auto& weak) {
+                                             auto entry = weak.lock();
+                                             return !entry || entry->evicted;
+                                         }),
+                          residentEntries.end());
+}
+
+size_t TextureCache::getLiveCount() {
+    prune();
+    return entries.size();
+}
+
+void TextureCache::prune() {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.expired()) {
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef TEXTURE_CACHE_HPP
+#define TEXTURE_CACHE_HPP
+
+#include "raylib.h"
+#include "TextureHandle.hpp"
+#include "ImageLoader.hpp"
+#include "FileWatcher.hpp"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Project-wide texture cache keyed by canonical path + mtime, so the same file
+// referenced from several elements (or reopened in the editor) is decoded and
+// uploaded once. acquire() never blocks: files are decoded on ImageLoader
+// workers and uploaded by processUploads(), which the main loop calls once per
+// frame with a budget so loading a large project does not stall rendering.
+// Resident textures are kept under a VRAM byte budget by evicting the least
+// recently drawn ones; textures drawn in the last frame are never evicted.
+class TextureCache
+{
+public:
+    static constexpr int DEFAULT_UPLOADS_PER_FRAME = 4;
+    static constexpr size_t DEFAULT_UPLOAD_BYTES_PER_FRAME = 16 * 1024 * 1024;
+    static constexpr size_t DEFAULT_BUDGET_BYTES = 512 * 1024 * 1024;
+
+    static TextureCache& instance();
+
+    TextureHandle acquire(const std::string& path);
+
+    // Paths naming an asset in the bundle are decoded from its mapping
+    // instead of being opened from disk (see AssetBundle)
+    void mountBundle(std::shared_ptr<const AssetBundle> bundle) { this->bundle = std::move(bundle); }
+
+    // Watches the directories of acquired files and re-decodes a texture when
+    // its file is rewritten; the old texture keeps drawing until the new one
+    // is uploaded. Handles stay valid across reloads.
+    void enableHotReload(bool enabled);
+
+    // Uploads at most maxTextures decoded images (and roughly maxBytes of pixel
+    // data, always at least one) to the GPU, then evicts down to the budget.
+    // Call once per frame; it also advances the LRU frame counter.
+    // Returns the number uploaded.
+    int processUploads(int maxTextures = DEFAULT_UPLOADS_PER_FRAME,
+                       size_t maxBytes = DEFAULT_UPLOAD_BYTES_PER_FRAME);
+
+    void touch(const std::shared_ptr<TextureEntry>& entry);
+
+    // 0 disables the budget
+    void setBudget(size_t bytes) { budgetBytes = bytes; }
+    size_t getBudget() const { return budgetBytes; }
+    size_t getResidentBytes() const { return residentBytes; }
+
+    size_t getLiveCount();
+    size_t getPendingCount() { return loader.getPendingCount() + stagedUploads.size(); }
+
+private:
+    TextureCache() = default;
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    std::string makeKey(const std::string& path, std::string& canonicalPath, long& modTime) const;
+    void submit(const std::shared_ptr<TextureEntry>& entry);
+    void reloadChanged();
+    void prune();
+    void enforceBudget();
+
+    std::unordered_map<std::string, std::weak_ptr<TextureEntry>> entries;
+    size_t pruneThreshold = 256;
+    ImageLoader loader;
+    std::shared_ptr<const AssetBundle> bundle;
+    std::unique_ptr<FileWatcher> watcher;
+    std::vector<ImageLoader::Result> stagedUploads; // decoded, waiting for upload budget
+    std::vector<std::weak_ptr<TextureEntry>> residentEntries; // uploaded, not evicted
+    size_t budgetBytes = DEFAULT_BUDGET_BYTES;
+    size_t residentBytes = 0;
+    unsigned long long frame = 1;
+};
+
+#endif // TEXTURE_CACHE_HPP
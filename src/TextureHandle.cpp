@@ -0,0 +1,17 @@
+#include "TextureHandle.hpp"
+#include "GraphicsBackend.hpp"
+
+const Texture2D& TextureHandle::get() const {
+    static const Texture2D empty = {0};
+    return entry ? entry->texture : empty;
+}
+
+const std::string& TextureHandle::getPath() const {
+    static const std::string empty;
+    return entry ? entry->path : empty;
+}
+
+void TextureHandle::touch() const {
+    GraphicsBackend* backend = GraphicsBackend::get();
+    if (entry && backend != nullptr) backend->touchTexture(entry);
+}
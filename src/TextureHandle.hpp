@@ -0,0 +1,57 @@
+#ifndef TEXTURE_HANDLE_HPP
+#define TEXTURE_HANDLE_HPP
+
+#include "RaylibTypes.hpp"
+
+#include <memory>
+#include <string>
+
+// One decoded, uploaded image shared by every handle that refers to it.
+// The GPU texture is released when the last handle goes away, or earlier by
+// the cache's memory budget (evicted), in which case it is reloaded from
+// path the next time a handle is touched. Entries are only ever created by
+// TextureCache, which also releases the GPU texture (~TextureEntry).
+struct TextureEntry
+{
+    std::string path; // canonical path of the source image
+    long modTime;     // source mtime the texture was decoded from
+    Texture2D texture;
+    bool pending;     // queued for decode/upload
+    bool evicted;     // unloaded by the budget, reload on next touch()
+    int width;        // known once decoded, before the upload happens
+    int height;
+    size_t gpuBytes;  // width * height * format size of the uploaded texture
+    unsigned long long lastUsedFrame;
+
+    TextureEntry() : modTime(0), texture{0}, pending(false), evicted(false), width(0), height(0), gpuBytes(0), lastUsedFrame(0) {}
+    ~TextureEntry();
+};
+
+// Reference-counted handle to a cached texture. An empty handle (or one whose
+// image failed to load) draws nothing and reports isReady() == false; while the
+// image is still being decoded or waiting for upload isPending() is true and
+// callers should draw a placeholder. Draw sites call touch() every frame they
+// draw the texture; that feeds the LRU and reloads evicted textures.
+// Headless builds have no TextureCache, so every handle there stays empty.
+class TextureHandle
+{
+public:
+    TextureHandle() = default;
+
+    bool isEmpty() const { return !entry; }
+    bool isReady() const { return entry && entry->texture.id > 0; }
+    bool isPending() const { return entry && entry->pending; }
+    const Texture2D& get() const;
+    const std::string& getPath() const;
+    void touch() const;
+    int getWidth() const { return entry ? entry->width : 0; }
+    int getHeight() const { return entry ? entry->height : 0; }
+
+private:
+    friend class TextureCache;
+    explicit TextureHandle(std::shared_ptr<TextureEntry> entry) : entry(std::move(entry)) {}
+
+    std::shared_ptr<TextureEntry> entry;
+};
+
+#endif // TEXTURE_HANDLE_HPP
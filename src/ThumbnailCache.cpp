@@ -0,0 +1,192 @@
+#include "ThumbnailCache.hpp"
+#include "AssetBundle.hpp"
+#include "ExportManifest.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+ThumbnailCache& ThumbnailCache::instance() {
+    static ThumbnailCache cache;
+    return cache;
+}
+
+ThumbnailCache::ThumbnailCache() {
+    worker = std::thread(&ThumbnailCache::workerLoop, this);
+}
+
+ThumbnailCache::~ThumbnailCache() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    jobAvailable.notify_all();
+    if (worker.joinable()) worker.join();
+    for (auto& result : results) {
+        if (result.image.data != nullptr) UnloadImage(result.image);
+    }
+    if (IsWindowReady()) {
+        for (auto& [key, entry] : entries) {
+            if (entry.thumbnail.texture.id > 0) UnloadTexture(entry.thumbnail.texture);
+        }
+    }
+}
+
+const Thumbnail& ThumbnailCache::get(const std::string& path, Rectangle region, int size) {
+    static const Thumbnail empty;
+    if (path.empty()) return empty;
+
+    std::string key = path + "|" + std::to_string((int)region.x) + "," + std::to_string((int)region.y) + "," +
+                      std::to_string((int)region.width) + "," + std::to_string((int)region.height) + "|" +
+                      std::to_string(size);
+    auto it = entries.find(key);
+    if (it != entries.end()) return it->second.thumbnail;
+
+    Entry& entry = entries[key];
+    entry.job = {key, path, region, size};
+    entry.thumbnail.pending = true;
+    submit(entry.job);
+    return entry.thumbnail;
+}
+
+void ThumbnailCache::enableHotReload(bool enabled) {
+    if (!enabled) {
+        watcher.reset();
+        return;
+    }
+    if (watcher) return;
+    watcher = std::make_unique<FileWatcher>();
+    for (const auto& [key, entry] : entries) {
+        if (!entry.canonicalPath.empty()) watcher->watch(fs::path(entry.canonicalPath).parent_path().string());
+    }
+}
+
+int ThumbnailCache::processUploads(int maxCount) {
+    PROFILE_ZONE("ThumbnailCache::processUploads");
+    reloadChanged();
+
+    std::vector<Result> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!results.empty() && (int)ready.size() < maxCount) {
+            ready.push_back(std::move(results.front()));
+            results.pop_front();
+        }
+    }
+
+    int uploaded = 0;
+    for (auto& result : ready) {
+        auto it = entries.find(result.key);
+        if (it == entries.end()) {
+            if (result.image.data != nullptr) UnloadImage(result.image);
+            continue;
+        }
+        Entry& entry = it->second;
+        if (!result.canonicalPath.empty() && entry.canonicalPath.empty()) {
+            entry.canonicalPath = result.canonicalPath;
+            if (watcher) watcher->watch(fs::path(entry.canonicalPath).parent_path().string());
+        }
+        entry.thumbnail.pending = false;
+        if (result.image.data == nullptr) {
+            entry.thumbnail.failed = true;
+            continue;
+        }
+        // A regenerated thumbnail replaces the one being drawn
+        if (entry.thumbnail.texture.id > 0) UnloadTexture(entry.thumbnail.texture);
+        entry.thumbnail.texture = LoadTextureFromImage(result.image);
+        entry.thumbnail.failed = false;
+        UnloadImage(result.image);
+        ++uploaded;
+    }
+    return uploaded;
+}
+
+void ThumbnailCache::reloadChanged() {
+    std::vector<std::string> changed;
+    if (!watcher || !watcher->poll(changed)) return;
+    std::sort(changed.begin(), changed.end());
+    for (auto& [key, entry] : entries) {
+        if (entry.canonicalPath.empty() ||
+            !std::binary_search(changed.begin(), changed.end(), entry.canonicalPath)) {
+            continue;
+        }
+        // The new mtime gives a new cache file name, so the worker regenerates it
+        entry.thumbnail.pending = true;
+        submit(entry.job);
+    }
+}
+
+void ThumbnailCache::submit(const Job& job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(job);
+    }
+    jobAvailable.notify_one();
+}
+
+void ThumbnailCache::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        std::string canonicalPath;
+        Image image = generate(job, canonicalPath);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            if (image.data != nullptr) UnloadImage(image);
+            return;
+        }
+        results.push_back({std::move(job.key), std::move(canonicalPath), image});
+    }
+}
+
+Image ThumbnailCache::generate(const Job& job, std::string& canonicalPath) {
+    std::string source = ExportManifest::describeSource(job.path);
+    if (source.empty()) {
+        LogWarning("Thumbnail source not found: %s", job.path.c_str());
+        return Image{0};
+    }
+    canonicalPath = source.substr(0, source.find('|'));
+
+    std::string identity = source + "|" + job.key.substr(job.path.size());
+    std::string name = ExportManifest::toHex(AssetBundle::hash(identity.data(), identity.size())) + ".png";
+    std::string cached = (fs::path(directory) / name).string();
+
+    std::error_code ec;
+    if (fs::exists(cached, ec)) {
+        Image image = LoadImage(cached.c_str());
+        if (image.data != nullptr) return image;
+    }
+
+    Image image = LoadImage(job.path.c_str());
+    if (image.data == nullptr) {
+        LogWarning("Failed to load image for thumbnail: %s", job.path.c_str());
+        return image;
+    }
+    if (job.region.width > 0 && job.region.height > 0) ImageCrop(&image, job.region);
+    float scale = (float)job.size / std::max(image.width, image.height);
+    if (scale < 1.0f) {
+        ImageResize(&image, std::max(1, (int)(image.width * scale + 0.5f)), std::max(1, (int)(image.height * scale + 0.5f)));
+    }
+
+    // Written under a temporary name so a crash never leaves a truncated thumbnail
+    fs::create_directories(directory, ec);
+    std::string temp = (fs::path(directory) / (name + ".tmp.png")).string();
+    if (ExportImage(image, temp.c_str())) {
+        fs::rename(temp, cached, ec);
+        if (ec) fs::remove(temp, ec);
+    } else {
+        LogWarning("Failed to write thumbnail: %s", cached.c_str());
+    }
+    return image;
+}
@@ -0,0 +1,99 @@
+#ifndef THUMBNAIL_CACHE_HPP
+#define THUMBNAIL_CACHE_HPP
+
+#include "raylib.h"
+#include "FileWatcher.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Small preview of an image (or a region of one) for editor lists. Drawing
+// code checks texture.id; pending means it is still being generated.
+struct Thumbnail
+{
+    Texture2D texture;
+    bool pending;
+    bool failed;
+
+    Thumbnail() : texture{0}, pending(false), failed(false) {}
+};
+
+// Pre-scaled previews stored on disk so the editor never decodes full-size art
+// just to list it. A thumbnail file is named by a hash of the source's
+// canonical path, size and mtime plus the region and thumbnail size, so an
+// edited source simply misses and gets a new file. A worker thread loads
+// cached thumbnails, or decodes the source once, scales it down and writes
+// the thumbnail for next time; processUploads() puts the results on the GPU.
+class ThumbnailCache
+{
+public:
+    static constexpr int DEFAULT_SIZE = 64; // Longest side, in pixels
+    static constexpr const char* DEFAULT_DIRECTORY = ".thumbnails";
+    static constexpr int DEFAULT_UPLOADS_PER_FRAME = 16;
+
+    static ThumbnailCache& instance();
+    ~ThumbnailCache();
+
+    void setDirectory(const std::string& directory) { this->directory = directory; }
+
+    // A zero region means the whole image. Never blocks; the first call for a
+    // thumbnail queues it and returns a pending one.
+    const Thumbnail& get(const std::string& path, Rectangle region = {0, 0, 0, 0}, int size = DEFAULT_SIZE);
+
+    // Regenerates thumbnails whose source file is rewritten (see FileWatcher)
+    void enableHotReload(bool enabled);
+
+    // Call once per frame from the thread that owns the GL context
+    int processUploads(int maxCount = DEFAULT_UPLOADS_PER_FRAME);
+
+private:
+    struct Job
+    {
+        std::string key;
+        std::string path;
+        Rectangle region;
+        int size;
+    };
+
+    struct Result
+    {
+        std::string key;
+        std::string canonicalPath;
+        Image image;
+    };
+
+    ThumbnailCache();
+    ThumbnailCache(const ThumbnailCache&) = delete;
+    ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+
+    void submit(const Job& job);
+    void workerLoop();
+    Image generate(const Job& job, std::string& canonicalPath);
+    void reloadChanged();
+
+    struct Entry
+    {
+        Thumbnail thumbnail;
+        Job job;
+        std::string canonicalPath; // Known once the worker has seen the source
+    };
+
+    std::string directory = DEFAULT_DIRECTORY;
+    std::unordered_map<std::string, Entry> entries;
+    std::unique_ptr<FileWatcher> watcher;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::deque<Job> jobs;
+    std::deque<Result> results;
+    bool stopping = false;
+};
+
+#endif // THUMBNAIL_CACHE_HPP
@@ -1,17 +1,24 @@
 #ifndef TYPES_HPP
 #define TYPES_HPP
 
-#include "raylib.h"
+#include "RaylibTypes.hpp"
 #include "json.hpp"
 
-#include "BasicUI.hpp"
+#include "TextureHandle.hpp"
+#include "NameTable.hpp"
+#include "SlotMap.hpp"
+#include "SlideIndex.hpp"
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <variant>
 
 using json = nlohmann::json;
 
+// Characters are drawn at this fraction of their (pre-bake) source size
+constexpr float CHARACTER_DRAW_SCALE = 0.5f;
+
 struct TextElement
 {
     std::string content;
@@ -21,29 +28,46 @@ struct CharacterElement
 {
     std::string name;
     std::vector<std::pair<std::string, std::string>> images;
-    std::vector<Texture2D> textures;
+    std::vector<TextureHandle> textures; // Parallel to images, shared via TextureCache
+    std::vector<Rectangle> atlasRects;   // Parallel to images; zero width = whole texture
+    std::vector<Vector2> sourceSizes;    // Parallel to images; size before export baking, zero = source rect size
+    std::vector<NameId> poseIds;         // Parallel to images; interned pose names, see internPoses()
     int positionIndex; // positionIndex
 
     CharacterElement() : positionIndex(0) {} // Initialize positionIndex to 0
-    ~CharacterElement()
+
+    // Refresh poseIds from the pose names; call whenever images changes
+    void internPoses()
     {
-        for (auto& texture : textures)
+        poseIds.resize(images.size());
+        for (size_t i = 0; i < images.size(); ++i)
         {
-            if (texture.id > 0)
-                UnloadTexture(texture);
+            poseIds[i] = NameTable::instance().intern(images[i].first);
         }
     }
+
+    // Region of pose i inside its texture (exported poses share atlas pages)
+    Rectangle getSourceRect(size_t i) const
+    {
+        if (i < atlasRects.size() && atlasRects[i].width > 0) return atlasRects[i];
+        if (i < textures.size()) return {0, 0, (float)textures[i].getWidth(), (float)textures[i].getHeight()};
+        return {0, 0, 0, 0};
+    }
+
+    // Layout size of pose i. Baked poses are stored smaller than they are laid
+    // out, so this is the original image size rather than the texture size.
+    Vector2 getDisplaySize(size_t i) const
+    {
+        if (i < sourceSizes.size() && sourceSizes[i].x > 0) return sourceSizes[i];
+        Rectangle source = getSourceRect(i);
+        return {source.width, source.height};
+    }
 };
 
 struct BackgroundElement
 {
     std::string imagePath;
-    Texture2D texture = {0};
-
-    ~BackgroundElement()
-    {
-        if (texture.id > 0) UnloadTexture(texture);
-    }
+    TextureHandle texture;
 };
 
 enum class ElementType { TEXT, CHARACTER, BACKGROUND };
@@ -53,6 +77,7 @@ struct Element
     ElementType type;
     std::string name;
     std::variant<TextElement, CharacterElement, BackgroundElement> data;
+    std::vector<size_t> usedBy; // Scenes that may show it (see linkScene), not saved
 
     Element() :
         type(ElementType::TEXT),
@@ -65,25 +90,57 @@ struct Element
 struct SceneElement
 {
     size_t elementIndex;
+    uint32_t elementGeneration = 0; // Of the element's slot, see findElement()
     float startTime;
     float endTime;
     int renderlevel;
     int positionIndex; // Added for CharacterElement position2
-    std::string selectedPose;
+    std::string selectedPose; // Serialized form of poseId
+    NameId poseId;            // Interned selectedPose
+    int poseIndex;            // Resolved index into the character's images, -1 = not resolved
 
-    SceneElement() : elementIndex(0), startTime(0.0f), endTime(1.0f), renderlevel(0), positionIndex(0), selectedPose("") {}
+    SceneElement() : elementIndex(0), startTime(0.0f), endTime(1.0f), renderlevel(0), positionIndex(0), selectedPose(""),
+                     poseId(NameTable::EMPTY), poseIndex(-1) {}
+
+    void setPose(const std::string& pose)
+    {
+        selectedPose = pose;
+        poseId = NameTable::instance().intern(pose);
+        poseIndex = -1;
+    }
 };
 
+// Index into character.images of the pose sceneElement shows, or -1. The index
+// resolved at load time (resolvePoses) is used while it still names the pose;
+// after the character's poses were edited the interned IDs are searched, so
+// drawing never compares strings.
+inline int findPose(const CharacterElement& character, const SceneElement& sceneElement)
+{
+    int index = sceneElement.poseIndex;
+    if (index >= 0 && index < (int)character.poseIds.size() && character.poseIds[index] == sceneElement.poseId)
+    {
+        return index;
+    }
+    for (size_t i = 0; i < character.poseIds.size(); ++i)
+    {
+        if (character.poseIds[i] == sceneElement.poseId) return (int)i;
+    }
+    return -1;
+}
+
 struct Scene
 {
     std::string name;
     std::vector<SceneElement> elements;
+    SlideIndex slides; // Of elements; rebuild (indexSlides) after changing them
+    std::vector<size_t> shownBy; // Nodes that may show it (see linkSceneOf), not saved
 };
 
 struct NodeConnection
 {
     size_t toNodeIndex;
     std::string choiceText;
+    uint32_t toGeneration = 0; // Generation of the target's slot, see isLinked()
 };
 
 enum class DragType { SIMPLE, SNAPPING };
@@ -97,6 +154,9 @@ struct Node
     DragType dragType;
     Color color;
     bool isStartNode;
+    std::vector<size_t> incoming; // Nodes that may connect here, each once (see connect), not saved
+
+    uint32_t sceneGeneration = 0; // Of the scene's slot, see findScene()
 
     Node(
         const std::string& n = "Node",
@@ -117,4 +177,275 @@ struct Node
     {}
 };
 
+// Elements and scenes keep their index when others are deleted, like nodes
+// below: scene elements and nodes refer to them by slot and generation, so
+// a reference to an erased one never resolves to whatever reuses its slot
+using ElementMap = SlotMap<Element>;
+using SceneMap = SlotMap<Scene>;
+
+// The element sceneElement shows, or nullptr if it was erased
+inline const Element* findElement(const ElementMap& elements, const SceneElement& sceneElement)
+{
+    if (sceneElement.elementIndex >= elements.size() ||
+        !elements.contains({(uint32_t)sceneElement.elementIndex, sceneElement.elementGeneration}))
+    {
+        return nullptr;
+    }
+    return &elements[sceneElement.elementIndex];
+}
+
+inline Element* findElement(ElementMap& elements, const SceneElement& sceneElement)
+{
+    return const_cast<Element*>(findElement(static_cast<const ElementMap&>(elements), sceneElement));
+}
+
+// The scene node shows, or nullptr if it shows none or the scene was erased
+inline const Scene* findScene(const SceneMap& scenes, const Node& node)
+{
+    if (node.sceneIndex < 0 || (size_t)node.sceneIndex >= scenes.size() ||
+        !scenes.contains({(uint32_t)node.sceneIndex, node.sceneGeneration}))
+    {
+        return nullptr;
+    }
+    return &scenes[node.sceneIndex];
+}
+
+// Intern every pose name and resolve each scene element's pose to an index.
+// Imports call this once the whole project is read.
+inline void resolvePoses(ElementMap& elements, SceneMap& scenes)
+{
+    for (auto& element : elements)
+    {
+        if (element.type == ElementType::CHARACTER)
+        {
+            std::get<CharacterElement>(element.data).internPoses();
+        }
+    }
+    for (auto& scene : scenes)
+    {
+        for (auto& sceneElement : scene.elements)
+        {
+            sceneElement.poseId = NameTable::instance().intern(sceneElement.selectedPose);
+            sceneElement.poseIndex = -1;
+            const Element* element = findElement(elements, sceneElement);
+            if (element != nullptr && element->type == ElementType::CHARACTER)
+            {
+                sceneElement.poseIndex = findPose(std::get<CharacterElement>(element->data), sceneElement);
+            }
+        }
+    }
+}
+
+// Build the scene's slide index; scene elements whose element is gone are left out
+inline void indexSlides(const ElementMap& elements, Scene& scene)
+{
+    scene.slides.build(scene.elements, [&](const SceneElement& sceneElement) { return findElement(elements, sceneElement) != nullptr; });
+}
+
+// Build every scene's slide index. Imports call this once the whole project is read.
+inline void indexSlides(const ElementMap& elements, SceneMap& scenes)
+{
+    for (auto& scene : scenes)
+    {
+        indexSlides(elements, scene);
+    }
+}
+
+template <typename T>
+void addOnce(std::vector<T>& items, const T& item)
+{
+    if (std::find(items.begin(), items.end(), item) == items.end()) items.push_back(item);
+}
+
+// Point the scene elements of scene index (which may only store the element's
+// index) at their elements' current slots and let the elements know about
+// them. Call after loading or editing the scene.
+inline void linkScene(ElementMap& elements, SceneMap& scenes, size_t index)
+{
+    for (auto& sceneElement : scenes[index].elements)
+    {
+        sceneElement.elementGeneration = elements.getGeneration(sceneElement.elementIndex);
+        if (elements.isAlive(sceneElement.elementIndex)) addOnce(elements[sceneElement.elementIndex].usedBy, index);
+    }
+}
+
+// Remove element index and the scene elements showing it, costing only the
+// scenes that use it (Element::usedBy), whose slide indices are rebuilt
+inline void eraseElement(ElementMap& elements, SceneMap& scenes, size_t index)
+{
+    if (!elements.isAlive(index)) return;
+    uint32_t generation = elements.getGeneration(index);
+    std::vector<size_t> users = std::move(elements[index].usedBy);
+    elements.erase(index);
+    // An entry may be stale (the scene was edited or its slot reused since),
+    // so match each scene element against the erased element itself
+    for (size_t s : users)
+    {
+        if (!scenes.isAlive(s)) continue;
+        auto& sceneElements = scenes[s].elements;
+        sceneElements.erase(std::remove_if(sceneElements.begin(), sceneElements.end(),
+                                           [&](const SceneElement& sceneElement)
+                                           { return sceneElement.elementIndex == index && sceneElement.elementGeneration == generation; }),
+                            sceneElements.end());
+        indexSlides(elements, scenes[s]);
+    }
+}
+
+// Nodes keep their index when others are deleted, so connections, the
+// editor's selection and the renderer's position stay valid
+using NodeMap = SlotMap<Node>;
+
+// Whether conn still leads to the node it was made to. Erasing a node removes
+// the connections into it, so this only fails for connections loaded from a
+// file that point nowhere, or copies taken before the erase.
+inline bool isLinked(const NodeMap& nodes, const NodeConnection& conn)
+{
+    return nodes.contains({(uint32_t)conn.toNodeIndex, conn.toGeneration});
+}
+
+// A connection from anywhere to node index as it is now
+inline NodeConnection connectTo(const NodeMap& nodes, size_t index, const std::string& choiceText)
+{
+    return {index, choiceText, nodes.getGeneration(index)};
+}
+
+// How slots are numbered when saved: DENSE squeezes the erased ones out
+// (project files); SLOTS keeps every slot so indices recorded against the
+// live maps stay valid (the edit journal's snapshots)
+enum class SlotIndexing { DENSE, SLOTS };
+
+// Index every slot of items is saved at; erased slots map to NONE
+template <typename T>
+std::vector<size_t> savedIndices(const SlotMap<T>& items, SlotIndexing indexing)
+{
+    if (indexing == SlotIndexing::DENSE) return items.denseIndices();
+    std::vector<size_t> indices(items.size(), SlotMap<T>::NONE);
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        if (items.isAlive(i)) indices[i] = i;
+    }
+    return indices;
+}
+
+// Saved index of every element, scene and node slot of a project
+struct SavedIndices
+{
+    std::vector<size_t> elements;
+    std::vector<size_t> scenes;
+    std::vector<size_t> nodes;
+
+    SavedIndices(const ElementMap& elementMap, const SceneMap& sceneMap, const NodeMap& nodeMap, SlotIndexing indexing)
+        : elements(savedIndices(elementMap, indexing)), scenes(savedIndices(sceneMap, indexing)), nodes(savedIndices(nodeMap, indexing))
+    {}
+};
+
+// Saved index of conn's target, NodeMap::NONE if it is to be dropped
+inline size_t savedTarget(const NodeMap& nodes, const std::vector<size_t>& indices, const NodeConnection& conn)
+{
+    return isLinked(nodes, conn) ? indices[conn.toNodeIndex] : NodeMap::NONE;
+}
+
+// Saved index of the element sceneElement shows, NONE if it is to be dropped
+inline size_t savedElement(const ElementMap& elements, const SavedIndices& indices, const SceneElement& sceneElement)
+{
+    return findElement(elements, sceneElement) != nullptr ? indices.elements[sceneElement.elementIndex] : ElementMap::NONE;
+}
+
+// Saved scene index of node, -1 if it shows none
+inline int savedScene(const SceneMap& scenes, const SavedIndices& indices, const Node& node)
+{
+    return findScene(scenes, node) != nullptr ? (int)indices.scenes[node.sceneIndex] : -1;
+}
+
+// Add a choice from node `from` to node `to` as it is now
+inline void connect(NodeMap& nodes, size_t from, size_t to, const std::string& choiceText)
+{
+    nodes[from].connections.push_back(connectTo(nodes, to, choiceText));
+    addOnce(nodes[to].incoming, from);
+}
+
+// Point the loaded connections of node index (which only store the target's
+// index) at their targets' current slots and let the targets know about them
+inline void linkConnections(NodeMap& nodes, size_t index)
+{
+    for (auto& conn : nodes[index].connections)
+    {
+        conn.toGeneration = nodes.getGeneration(conn.toNodeIndex);
+        if (nodes.isAlive(conn.toNodeIndex)) addOnce(nodes[conn.toNodeIndex].incoming, index);
+    }
+}
+
+// Point node index at its scene's current slot and let the scene know
+inline void linkSceneOf(SceneMap& scenes, NodeMap& nodes, size_t index)
+{
+    Node& node = nodes[index];
+    if (node.sceneIndex < 0) return;
+    node.sceneGeneration = scenes.getGeneration(node.sceneIndex);
+    if (scenes.isAlive(node.sceneIndex)) addOnce(scenes[node.sceneIndex].shownBy, index);
+}
+
+// Remove scene index; the nodes showing it (Scene::shownBy) then show none
+inline void eraseScene(SceneMap& scenes, NodeMap& nodes, size_t index)
+{
+    if (!scenes.isAlive(index)) return;
+    uint32_t generation = scenes.getGeneration(index);
+    std::vector<size_t> viewers = std::move(scenes[index].shownBy);
+    scenes.erase(index);
+    for (size_t n : viewers)
+    {
+        if (nodes.isAlive(n) && nodes[n].sceneIndex == (int)index && nodes[n].sceneGeneration == generation)
+        {
+            nodes[n].sceneIndex = -1;
+        }
+    }
+}
+
+// Link every reference in a freshly loaded project and drop connections that
+// lead nowhere. Imports call this once the whole project is read, before
+// resolvePoses and indexSlides.
+inline void linkProject(ElementMap& elements, SceneMap& scenes, NodeMap& nodes)
+{
+    for (size_t i = 0; i < scenes.size(); ++i)
+    {
+        if (scenes.isAlive(i)) linkScene(elements, scenes, i);
+    }
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        if (!nodes.isAlive(i)) continue;
+        auto& connections = nodes[i].connections;
+        connections.erase(std::remove_if(connections.begin(), connections.end(),
+                                         [&](const NodeConnection& conn) { return !isLinked(nodes, conn); }),
+                          connections.end());
+        linkConnections(nodes, i);
+        linkSceneOf(scenes, nodes, i);
+    }
+}
+
+// Remove node index and the connections into and out of it, costing only
+// those: the nodes connecting here are known from Node::incoming. If it was
+// the start node, the first remaining node takes over.
+inline void eraseNode(NodeMap& nodes, size_t index)
+{
+    if (!nodes.isAlive(index)) return;
+    bool wasStartNode = nodes[index].isStartNode;
+    uint32_t generation = nodes.getGeneration(index);
+    std::vector<size_t> sources = std::move(nodes[index].incoming);
+    nodes.erase(index);
+    // An entry may be stale (the connection was deleted since, or the source
+    // slot reused), so match each connection against the erased node itself
+    for (size_t from : sources)
+    {
+        if (!nodes.isAlive(from)) continue;
+        auto& connections = nodes[from].connections;
+        connections.erase(std::remove_if(connections.begin(), connections.end(),
+                                         [&](const NodeConnection& conn)
+                                         { return conn.toNodeIndex == index && conn.toGeneration == generation; }),
+                          connections.end());
+    }
+    if (wasStartNode && !nodes.empty())
+    {
+        nodes[nodes.firstAlive()].isStartNode = true;
+    }
+}
+
 #endif // TYPES_HPP
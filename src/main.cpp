@@ -3,78 +3,109 @@
 #include "NodeManager.hpp"
 #include "Render.hpp"
 #include "JsonUtils.hpp"
+#include "RaylibBackend.hpp"
+#include "ThumbnailCache.hpp"
+#include "ProjectSaver.hpp"
+#include "EditJournal.hpp"
+#include "Profiler.hpp"
 #include "raylib.h"
 
 // #define RAYGUI_IMPLEMENTATION
 #include "raygui.h"
+#include "Log.hpp"
 
 enum class Mode { ELEMENT, SCENE, NODE, RENDER, IMPORT_EXPORT };
 
 class ImportExportManager {
 private:
-    std::vector<Element>& elements;
-    std::vector<Scene>& scenes;
-    std::vector<Node>& nodes;
+    ElementMap& elements;
+    SceneMap& scenes;
+    NodeMap& nodes;
     Render& renderer;
+    bool compressTextures = false;
+    bool writeBundle = false;
+    // Saves are written from a snapshot on a worker thread, so the UI never waits on the disk
+    ProjectSaver saver{[](JsonWriter& writer, const ProjectSnapshot& snapshot) {
+        JsonUtils::writeProject(writer, snapshot.elements, snapshot.scenes, snapshot.nodes);
+    }};
+    ProjectObserver* observer = nullptr;
 
 public:
-    ImportExportManager(std::vector<Element>& elements, std::vector<Scene>& scenes, std::vector<Node>& nodes, Render& renderer)
+    ImportExportManager(ElementMap& elements, SceneMap& scenes, NodeMap& nodes, Render& renderer)
         : elements(elements), scenes(scenes), nodes(nodes), renderer(renderer) {}
 
     void update() {
+        PROFILE_ZONE("ImportExportManager::update");
         // No update logic needed for now
     }
 
+    void setObserver(ProjectObserver* observer) { this->observer = observer; }
+
     void draw(Font customFont) {
+        PROFILE_ZONE("ImportExportManager::draw");
         // Draw import/export buttons
         if (GuiButton({400, 250, 100, 30}, "Export Project")) {
-            try {
-                JsonUtils::exportToFile(elements, scenes, nodes, "project.json");
-                TraceLog(LOG_INFO, "Exported project to project.json");
-            } catch (const std::exception& e) {
-                TraceLog(LOG_ERROR, "Export failed: %s", e.what());
-            }
+            PROFILE_ZONE("Export project");
+            saver.save(ProjectSnapshot::capture(elements, scenes, nodes), "project.json");
+        }
+        if (saver.isSaving()) {
+            DrawText("Saving...", 510, 260, 10, DARKGRAY);
+        } else if (!saver.getLastError().empty()) {
+            DrawText(("Save failed: " + saver.getLastError()).c_str(), 510, 260, 10, RED);
         }
         if (GuiButton({400, 290, 100, 30}, "Import Project")) {
+            PROFILE_ZONE("Import project");
             try {
-                JsonUtils::importFromFile(elements, scenes, nodes, "project.json");
+                // The editor lists thumbnails; Render mode loads full images on demand
+                JsonUtils::importFromFile(elements, scenes, nodes, "project.json", false);
+                if (observer) observer->projectReplaced();
                 // Reset renderer to start node after import
                 for (size_t i = 0; i < nodes.size(); ++i) {
                     if (nodes[i].isStartNode) {
                         renderer.setCurrentNodeIndex(i);
-                        TraceLog(LOG_INFO, "Set render node to start node %d after import", i);
+                        LogInfo("Set render node to start node %zu after import", i);
                         break;
                     }
                 }
-                TraceLog(LOG_INFO, "Imported project from project.json");
+                LogInfo("Imported project from project.json");
             } catch (const std::exception& e) {
-                TraceLog(LOG_ERROR, "Import failed: %s", e.what());
+                LogError("Import failed: %s", e.what());
             }
         }
 
         if (GuiButton({400, 330, 100, 30}, "export To Folder")) {
+            PROFILE_ZONE("Export to folder");
             try {
-                JsonUtils::exportToFolder(elements, scenes, nodes, "path");
-                TraceLog(LOG_INFO, "Exported project to path");
+                JsonUtils::ExportOptions options;
+                options.compressTextures = compressTextures;
+                options.writeBundle = writeBundle;
+                ExportStats stats = JsonUtils::exportToFolder(elements, scenes, nodes, "path", options);
+                LogInfo("Exported project to path: %zu file(s) updated, %llu bytes skipped as unchanged",
+                         stats.filesWritten, (unsigned long long)stats.bytesSkipped);
             } catch (const std::exception& e) {
-                TraceLog(LOG_ERROR, "Export failed: %s", e.what());
+                LogError("Export failed: %s", e.what());
             }
         }
 
+        GuiCheckBox({510, 335, 20, 20}, "Compress textures", &compressTextures);
+        GuiCheckBox({690, 335, 20, 20}, "Asset bundle", &writeBundle);
+
         if (GuiButton({400, 370, 100, 30}, "Import To Folder")) {
+            PROFILE_ZONE("Import from folder");
             try {
-                JsonUtils::importFromFolder(elements, scenes, nodes, "path");
+                JsonUtils::importFromFolder(elements, scenes, nodes, "path", false);
+                if (observer) observer->projectReplaced();
                 // Reset renderer to start node after import
                 for (size_t i = 0; i < nodes.size(); ++i) {
                     if (nodes[i].isStartNode) {
                         renderer.setCurrentNodeIndex(i);
-                        TraceLog(LOG_INFO, "Set render node to start node %d after import", i);
+                        LogInfo("Set render node to start node %zu after import", i);
                         break;
                     }
                 }
-                TraceLog(LOG_INFO, "Imported project from path");
+                LogInfo("Imported project from path");
             } catch (const std::exception& e) {
-                TraceLog(LOG_ERROR, "Import failed: %s", e.what());
+                LogError("Import failed: %s", e.what());
             }
         }
 
@@ -86,6 +117,11 @@ public:
 int main() {
     InitWindow(1000, 600, "Novel Scene Creator");
     SetTargetFPS(60);
+    RaylibBackend backend; // Textures for the core's imports and prefetching
+    GraphicsBackend::set(&backend);
+    // Re-saved images show up without reselecting
+    TextureCache::instance().enableHotReload(true);
+    ThumbnailCache::instance().enableHotReload(true);
 
     // Define Cyrillic Unicode range (U+0400 to U+04FF)
     int codepoints[512]; // Increased size to include basic Latin + Cyrillic
@@ -104,11 +140,11 @@ int main() {
     // Alternative: If using variable font, comment the above and uncomment below
     // Font customFont = LoadFontEx("font/NotoSans-VariableFont_wdth,wght.ttf", 16, codepoints, count);
     if (customFont.baseSize == 0 || customFont.glyphCount == 0) {
-        TraceLog(LOG_ERROR, "Failed to load font: font/NotoSans-Regular.ttf");
+        LogError("Failed to load font: font/NotoSans-Regular.ttf");
         customFont = GetFontDefault(); // Fallback to default font
-        TraceLog(LOG_WARNING, "Using default font as fallback");
+        LogWarning("Using default font as fallback");
     } else {
-        TraceLog(LOG_INFO, "Loaded font with %d glyphs", customFont.glyphCount);
+        LogInfo("Loaded font with %d glyphs", customFont.glyphCount);
     }
 
     // Set the custom font globally for raygui
@@ -121,7 +157,9 @@ int main() {
     ElementEditor elementEditor;
     SceneEditor sceneEditor(elementEditor.getElements(), elementEditor.getScenes());
     NodeManager nodeManager(sceneEditor.getScenes());
+    sceneEditor.setNodes(&nodeManager.getNodes());
     Render renderer(elementEditor.getElements(), elementEditor.getScenes(), nodeManager.getNodes());
+    renderer.setPrefetchDepth(1); // Full-size images are only loaded for what Render mode can reach
     ImportExportManager importExportManager(
         elementEditor.getElements(),
         elementEditor.getScenes(),
@@ -129,38 +167,50 @@ int main() {
         renderer
     );
     nodeManager.customFont=customFont;
+
+    // Bring back the last session (including one that crashed) and journal every edit from here on
+    EditJournal journal(elementEditor.getElements(), elementEditor.getScenes(), nodeManager.getNodes());
+    journal.open(GetTime());
+    elementEditor.setObserver(&journal);
+    sceneEditor.setObserver(&journal);
+    nodeManager.setObserver(&journal);
+    importExportManager.setObserver(&journal);
+
     // Set initial node to the start node
     for (size_t i = 0; i < nodeManager.getNodes().size(); ++i) {
         if (nodeManager.getNodes()[i].isStartNode) {
             renderer.setCurrentNodeIndex(i);
-            TraceLog(LOG_INFO, "Set initial render node to start node %d", i);
+            LogInfo("Set initial render node to start node %zu", i);
             break;
         }
     }
 
     while (!WindowShouldClose()) {
+        // F3: frame overlay, F4: dump the last seconds as a Chrome trace
+        Profiler::instance().handleHotkeys();
         if (IsKeyPressed(KEY_TAB)) {
             switch (currentMode) {
             case Mode::ELEMENT:
                 currentMode = Mode::SCENE;
-                TraceLog(LOG_INFO, "Switched to Scene mode");
+                LogInfo("Switched to Scene mode");
                 break;
             case Mode::SCENE:
                 currentMode = Mode::NODE;
-                TraceLog(LOG_INFO, "Switched to Node mode");
+                LogInfo("Switched to Node mode");
                 break;
             case Mode::NODE:
                 currentMode = Mode::RENDER;
                 renderer.resetSlide();
-                TraceLog(LOG_INFO, "Switched to Render mode");
+                renderer.invalidate(); // Pick up images and scenes changed in the other modes
+                LogInfo("Switched to Render mode");
                 break;
             case Mode::RENDER:
                 currentMode = Mode::IMPORT_EXPORT;
-                TraceLog(LOG_INFO, "Switched to Import/Export mode");
+                LogInfo("Switched to Import/Export mode");
                 break;
             case Mode::IMPORT_EXPORT:
                 currentMode = Mode::ELEMENT;
-                TraceLog(LOG_INFO, "Switched to Element mode");
+                LogInfo("Switched to Element mode");
                 break;
             }
         }
@@ -183,6 +233,15 @@ int main() {
             break;
         }
 
+        {
+            PROFILE_ZONE("EditJournal::update");
+            journal.update(GetTime());
+        }
+
+        // Upload images decoded in the background, a few per frame
+        TextureCache::instance().processUploads();
+        ThumbnailCache::instance().processUploads();
+
         BeginDrawing();
         ClearBackground(RAYWHITE);
         switch (currentMode) {
@@ -202,7 +261,9 @@ int main() {
             importExportManager.draw(customFont);
             break;
         }
+        Profiler::instance().drawOverlay();
         EndDrawing();
+        Profiler::instance().endFrame();
     }
 
     UnloadFont(customFont);
@@ -3,13 +3,18 @@
 #include "NodeManager.hpp"
 #include "Render.hpp"
 #include "JsonUtils.hpp"
+#include "RaylibBackend.hpp"
+#include "Profiler.hpp"
 #include "raylib.h"
 
 #include "raygui.h"
+#include "Log.hpp"
 
 int main() {
     InitWindow(1000, 600, "Novel Renderer");
     SetTargetFPS(60);
+    RaylibBackend backend; // Textures for the core's imports and prefetching
+    GraphicsBackend::set(&backend);
 
 
     // Define Cyrillic Unicode range (U+0400 to U+04FF)
@@ -24,16 +29,30 @@ int main() {
         codepoints[count++] = i;
     }
 
+    // An exported asset bundle replaces the loose files: everything below is read
+    // from one mapping instead of a file per asset
+    auto bundle = std::make_shared<AssetBundle>();
+    if (!bundle->open(AssetBundle::DEFAULT_NAME)) {
+        bundle.reset();
+    }
+
     // Load Noto Sans font
-    Font customFont = LoadFontEx("font/noto-sans.regular.ttf", 16, codepoints, count);
+    Font customFont;
+    size_t fontSize = 0;
+    const unsigned char* fontData = bundle ? bundle->find("font/noto-sans.regular.ttf", fontSize) : nullptr;
+    if (fontData != nullptr) {
+        customFont = LoadFontFromMemory(".ttf", fontData, (int)fontSize, 16, codepoints, count);
+    } else {
+        customFont = LoadFontEx("font/noto-sans.regular.ttf", 16, codepoints, count);
+    }
     // Alternative: If using variable font, comment the above and uncomment below
     // Font customFont = LoadFontEx("font/NotoSans-VariableFont_wdth,wght.ttf", 16, codepoints, count);
     if (customFont.baseSize == 0 || customFont.glyphCount == 0) {
-        TraceLog(LOG_ERROR, "Failed to load font: font/NotoSans-Regular.ttf");
+        LogError("Failed to load font: font/NotoSans-Regular.ttf");
         customFont = GetFontDefault(); // Fallback to default font
-        TraceLog(LOG_WARNING, "Using default font as fallback");
+        LogWarning("Using default font as fallback");
     } else {
-        TraceLog(LOG_INFO, "Loaded font with %d glyphs", customFont.glyphCount);
+        LogInfo("Loaded font with %d glyphs", customFont.glyphCount);
     }
 
     // Set the custom font globally for raygui
@@ -43,42 +62,59 @@ int main() {
     GuiSetStyle(DEFAULT, TEXT_SIZE, 16);
 
     // Initialize data containers
-    std::vector<Element> elements;
-    std::vector<Scene> scenes;
-    std::vector<Node> nodes;
+    ElementMap elements;
+    SceneMap scenes;
+    NodeMap nodes;
 
-    // Initialize renderer
+    // Initialize renderer; textures are streamed in for scenes up to two choices ahead
     Render renderer(elements, scenes, nodes);
+    renderer.setPrefetchDepth(2);
 
-    // Load project data
+    // Load project data, from project.bin when the export wrote one (textures are
+    // left to the renderer's prefetcher)
     try {
-        JsonUtils::importFromFolder(elements, scenes, nodes, ".");
-        TraceLog(LOG_INFO, "Imported project from project.json");
+        PROFILE_ZONE("Import project");
+        if (bundle) {
+            TextureCache::instance().mountBundle(bundle);
+            JsonUtils::importFromBundle(elements, scenes, nodes, *bundle, false);
+            LogInfo("Imported project from %s", AssetBundle::DEFAULT_NAME);
+        } else {
+            JsonUtils::importFromFolder(elements, scenes, nodes, ".", false);
+            LogInfo("Imported project from the working directory");
+        }
 
         // Set renderer to the start node
         for (size_t i = 0; i < nodes.size(); ++i) {
             if (nodes[i].isStartNode) {
                 renderer.setCurrentNodeIndex(i);
-                TraceLog(LOG_INFO, "Set render node to start node %d", i);
+                LogInfo("Set render node to start node %zu", i);
                 break;
             }
         }
     } catch (const std::exception& e) {
-        TraceLog(LOG_ERROR, "Import failed: %s", e.what());
+        LogError("Import failed: %s", e.what());
         // Optionally, close the window if import fails
         CloseWindow();
         return 1;
     }
 
     while (!WindowShouldClose()) {
+        // F3: frame overlay, F4: dump the last seconds as a Chrome trace
+        Profiler::instance().handleHotkeys();
+
         // Update renderer
         renderer.update(GetTime(), renderer.getCurrentSlide());
 
+        // Upload images decoded in the background, a few per frame
+        TextureCache::instance().processUploads();
+
         // Draw
         BeginDrawing();
         ClearBackground(RAYWHITE);
         renderer.draw(customFont);
+        Profiler::instance().drawOverlay();
         EndDrawing();
+        Profiler::instance().endFrame();
     }
 
     UnloadFont(customFont);
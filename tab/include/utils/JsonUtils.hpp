@@ -2,6 +2,7 @@
 #define JSON_UTILS_HPP
 
 #include "Types.hpp"
+#include "utils/Log.hpp"
 #include <fstream>
 #include <stdexcept>
 
@@ -278,7 +279,7 @@ namespace JsonUtils
                         }
                         else
                         {
-                            TraceLog(LOG_WARNING, "Failed to load image: %s", img.second.c_str());
+                            LogWarning("Failed to load image: %s", img.second.c_str());
                             character.textures.push_back({0}); // Push empty texture
                         }
                     }
@@ -301,7 +302,7 @@ namespace JsonUtils
                     }
                     else
                     {
-                        TraceLog(LOG_WARNING, "Failed to load image: %s", background.imagePath.c_str());
+                        LogWarning("Failed to load image: %s", background.imagePath.c_str());
                         background.texture = {0}; // Set empty texture
                     }
                 }
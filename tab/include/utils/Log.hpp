@@ -0,0 +1,108 @@
+#ifndef LOG_HPP
+#define LOG_HPP
+
+#include "raylib.h"
+
+#include <atomic>
+#include <cstdint>
+
+// Leveled logging that is cheap enough for per-frame code and safe from any
+// thread. Use the macros below instead of calling TraceLog directly:
+//   - levels under NOVEL_LOG_LEVEL are compiled out, arguments and all;
+//   - levels under Log::setLevel() cost one atomic load;
+//   - each call site may log SITE_BURST messages per second, the rest are
+//     counted and reported with the site's next message;
+//   - messages are formatted into a lock-free ring buffer and handed to
+//     raylib's TraceLog by a background thread, so
+//     the caller never waits on the console. When the ring is full messages
+//     are dropped and counted rather than blocking.
+// Levels are raylib's TraceLogLevel values.
+
+// Lowest level compiled in: 1 = TRACE, 2 = DEBUG, 3 = INFO, 4 = WARNING, 5 = ERROR
+#ifndef NOVEL_LOG_LEVEL
+#define NOVEL_LOG_LEVEL 3
+#endif
+
+#if defined(__GNUC__)
+#define NOVEL_LOG_PRINTF(formatIndex, firstArg) __attribute__((format(printf, formatIndex, firstArg)))
+#else
+#define NOVEL_LOG_PRINTF(formatIndex, firstArg)
+#endif
+
+namespace Log {
+
+constexpr uint32_t SITE_BURST = 10; // Messages per call site per second
+
+// Throttle state of one call site; the macros keep one per call
+class Site
+{
+public:
+    constexpr explicit Site(int level) : level(level) {}
+
+    bool allow();
+    uint32_t takeSuppressed() { return suppressed.exchange(0, std::memory_order_relaxed); }
+
+    const int level;
+
+private:
+    std::atomic<int64_t> windowStart{0}; // ms
+    std::atomic<uint32_t> windowCount{0};
+    std::atomic<uint32_t> suppressed{0};
+};
+
+inline std::atomic<int> minimumLevel{LOG_INFO};
+
+inline void setLevel(int level) { minimumLevel.store(level, std::memory_order_relaxed); }
+inline int getLevel() { return minimumLevel.load(std::memory_order_relaxed); }
+inline bool isEnabled(int level) { return level >= minimumLevel.load(std::memory_order_relaxed); }
+
+// Format and queue a message. FATAL flushes, logs on the calling thread and exits.
+void write(Site& site, const char* format, ...) NOVEL_LOG_PRINTF(2, 3);
+// Never called: compiled-out levels pass their arguments to it inside sizeof,
+// so they are still type-checked and count as used
+int discard(const char*, ...) NOVEL_LOG_PRINTF(1, 2);
+// Wait until everything queued so far has reached TraceLog
+void flush();
+
+} // namespace Log
+
+#define NOVEL_LOG_AT(logLevel, ...)                                          \
+    do                                                                       \
+    {                                                                        \
+        static Log::Site novelLogSite(logLevel);                             \
+        if (Log::isEnabled(logLevel) && novelLogSite.allow())                \
+        {                                                                    \
+            Log::write(novelLogSite, __VA_ARGS__);                           \
+        }                                                                    \
+    } while (0)
+
+#define NOVEL_LOG_STRIPPED(...) ((void)sizeof(Log::discard(__VA_ARGS__)))
+
+#if NOVEL_LOG_LEVEL <= 1
+#define LogTrace(...) NOVEL_LOG_AT(LOG_TRACE, __VA_ARGS__)
+#else
+#define LogTrace(...) NOVEL_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if NOVEL_LOG_LEVEL <= 2
+#define LogDebug(...) NOVEL_LOG_AT(LOG_DEBUG, __VA_ARGS__)
+#else
+#define LogDebug(...) NOVEL_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if NOVEL_LOG_LEVEL <= 3
+#define LogInfo(...) NOVEL_LOG_AT(LOG_INFO, __VA_ARGS__)
+#else
+#define LogInfo(...) NOVEL_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#if NOVEL_LOG_LEVEL <= 4
+#define LogWarning(...) NOVEL_LOG_AT(LOG_WARNING, __VA_ARGS__)
+#else
+#define LogWarning(...) NOVEL_LOG_STRIPPED(__VA_ARGS__)
+#endif
+
+#define LogError(...) NOVEL_LOG_AT(LOG_ERROR, __VA_ARGS__)
+#define LogFatal(...) NOVEL_LOG_AT(LOG_FATAL, __VA_ARGS__)
+
+#endif // LOG_HPP
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include "raylib.h"
 #include "raygui.h"
+#include "utils/Log.hpp"
 
 Render::Render(std::vector<Element>& elements, std::vector<Scene>& scenes, std::vector<Node>& nodes)
     : elements(elements), scenes(scenes), nodes(nodes), currentNodeIndex(-1), currentSlide(1),
@@ -11,7 +12,7 @@ void Render::update(float currentTime, int currentSlide) {
     this->currentSlide = currentSlide;
     if (currentNodeIndex < 0 || currentNodeIndex >= (int)nodes.size()) {
         showButtons = false;
-        TraceLog(LOG_WARNING, "No valid node selected (index: %d)", currentNodeIndex);
+        LogWarning("No valid node selected (index: %d)", currentNodeIndex);
         return;
     }
 
@@ -27,7 +28,7 @@ void Render::update(float currentTime, int currentSlide) {
                 maxEndTime = std::max(maxEndTime, sceneElement.endTime);
                 if (currentSlide >= sceneElement.startTime && currentSlide <= sceneElement.endTime) {
                     allElementsDone = false;
-                    TraceLog(LOG_INFO, "Element %zu (name: %s) is active: startTime=%.2f, endTime=%.2f",
+                    LogDebug("Element %zu (name: %s) is active: startTime=%.2f, endTime=%.2f",
                              sceneElement.elementIndex,
                              elements[sceneElement.elementIndex].name.c_str(),
                              sceneElement.startTime,
@@ -36,17 +37,17 @@ void Render::update(float currentTime, int currentSlide) {
             }
         }
         showButtons = allElementsDone || currentSlide >= maxEndTime;
-        TraceLog(LOG_INFO, "Slide %d, Max EndTime: %.2f, All Elements Done: %d, Show Buttons: %d",
+        LogDebug("Slide %d, Max EndTime: %.2f, All Elements Done: %d, Show Buttons: %d",
                  currentSlide, maxEndTime, allElementsDone, showButtons);
     } else {
         showButtons = true;
-        TraceLog(LOG_WARNING, "No valid scene for node %d, showing buttons", currentNodeIndex);
+        LogWarning("No valid scene for node %d, showing buttons", currentNodeIndex);
     }
 
     // Handle spacebar for next slide
     if (IsKeyPressed(KEY_SPACE) && canGoNext()) {
         nextSlide();
-        TraceLog(LOG_INFO, "Spacebar pressed, advanced to slide %d", currentSlide);
+        LogInfo("Spacebar pressed, advanced to slide %d", currentSlide);
     }
 
     if (showButtons) {
@@ -56,7 +57,7 @@ void Render::update(float currentTime, int currentSlide) {
             float maxScroll = nodes[currentNodeIndex].connections.size() * buttonSpacing - GetScreenHeight() * 0.7f;
             if (maxScroll < 0) maxScroll = 0;
             scrollOffset.y = std::max(0.0f, std::min(scrollOffset.y, maxScroll));
-            TraceLog(LOG_INFO, "Scroll offset updated to %.2f (maxScroll: %.2f)", scrollOffset.y, maxScroll);
+            LogInfo("Scroll offset updated to %.2f (maxScroll: %.2f)", scrollOffset.y, maxScroll);
         }
     }
 }
@@ -64,7 +65,7 @@ void Render::update(float currentTime, int currentSlide) {
 void Render::draw() {
     if (currentNodeIndex < 0 || currentNodeIndex >= (int)nodes.size()) {
         DrawText("No node selected", 10, 10, 20, RED);
-        TraceLog(LOG_ERROR, "Cannot draw: invalid node index %d", currentNodeIndex);
+        LogError("Cannot draw: invalid node index %d", currentNodeIndex);
         return;
     }
 
@@ -72,7 +73,7 @@ void Render::draw() {
     if (currentNode.sceneIndex >= 0 && currentNode.sceneIndex < (int)scenes.size()) {
         drawScene(scenes[currentNode.sceneIndex], GetTime(), currentSlide);
     } else {
-        TraceLog(LOG_WARNING, "Invalid scene index %d for node %d", currentNode.sceneIndex, currentNodeIndex);
+        LogWarning("Invalid scene index %d for node %d", currentNode.sceneIndex, currentNodeIndex);
     }
 
     // Draw navigation and reset buttons
@@ -85,25 +86,25 @@ void Render::draw() {
     if (canGoPrev()) {
         if (GuiButton({navButtonX, navButtonY, buttonWidth, buttonHeight}, "Previous Slide")) {
             prevSlide();
-            TraceLog(LOG_INFO, "Previous slide button clicked, moved to slide %d", currentSlide);
+            LogInfo("Previous slide button clicked, moved to slide %d", currentSlide);
         }
     }
     if (canGoNext()) {
         if (GuiButton({navButtonX + buttonWidth + 20.0f, navButtonY, buttonWidth, buttonHeight}, "Next Slide")) {
             nextSlide();
-            TraceLog(LOG_INFO, "Next slide button clicked, advanced to slide %d", currentSlide);
+            LogInfo("Next slide button clicked, advanced to slide %d", currentSlide);
         }
     }
     if (GuiButton({navButtonX + buttonWidth * 2 + 40.0f, navButtonY, buttonWidth, buttonHeight}, "Reset")) {
         resetSlide();
-        TraceLog(LOG_INFO, "Reset button clicked, reset to node %d and slide 1", currentNodeIndex);
+        LogInfo("Reset button clicked, reset to node %d and slide 1", currentNodeIndex);
     }
 
     if (showButtons) {
         if (nodes[currentNodeIndex].connections.empty()) {
             float textWidth = MeasureText("No choices available", 20);
             DrawText("No choices available", (GetScreenWidth() - textWidth) / 2, GetScreenHeight() / 2 - 100, 20, RED);
-            TraceLog(LOG_WARNING, "Node %d has no connections", currentNodeIndex);
+            LogDebug("Node %d has no connections", currentNodeIndex);
         } else {
             float buttonWidth = 200.0f;
             float buttonHeight = 30.0f;
@@ -115,11 +116,11 @@ void Render::draw() {
             float boxY = (GetScreenHeight() - boxHeight) / 2.0f; // Center vertically
             GuiGroupBox({boxX, boxY, boxWidth, boxHeight}, "Choices");
             BeginScissorMode(boxX, boxY, boxWidth, boxHeight);
-            TraceLog(LOG_INFO, "Rendering %zu choice buttons for node %d (boxHeight: %.2f, totalChoicesHeight: %.2f)",
+            LogDebug("Rendering %zu choice buttons for node %d (boxHeight: %.2f, totalChoicesHeight: %.2f)",
                      connectionsSize, currentNodeIndex, boxHeight, totalChoicesHeight);
             for (size_t i = 0; i < connectionsSize; ++i) {
                 if (i >= nodes[currentNodeIndex].connections.size()) {
-                    TraceLog(LOG_ERROR, "Index %zu exceeds connections size %zu for node %d", i, nodes[currentNodeIndex].connections.size(), currentNodeIndex);
+                    LogError("Index %zu exceeds connections size %zu for node %d", i, nodes[currentNodeIndex].connections.size(), currentNodeIndex);
                     break;
                 }
                 float yPos = boxY + 10.0f + i * buttonSpacing - scrollOffset.y;
@@ -128,7 +129,7 @@ void Render::draw() {
                     if (GuiButton(buttonRect, nodes[currentNodeIndex].connections[i].choiceText.c_str())) {
                         int newNodeIndex = nodes[currentNodeIndex].connections[i].toNodeIndex;
                         if (newNodeIndex >= 0 && newNodeIndex < (int)nodes.size()) {
-                            TraceLog(LOG_INFO, "Switching to node %d (sceneIndex: %d) via choice %zu (text: %s)",
+                            LogInfo("Switching to node %d (sceneIndex: %d) via choice %zu (text: %s)",
                                      newNodeIndex, nodes[newNodeIndex].sceneIndex, i,
                                      nodes[currentNodeIndex].connections[i].choiceText.c_str());
                             currentNodeIndex = newNodeIndex;
@@ -136,13 +137,13 @@ void Render::draw() {
                             scrollOffset.y = 0.0f;
                             break; // Exit loop to prevent further accesses after node change
                         } else {
-                            TraceLog(LOG_ERROR, "Invalid node index %d in connection %zu for node %d", newNodeIndex, i, currentNodeIndex);
+                            LogError("Invalid node index %d in connection %zu for node %d", newNodeIndex, i, currentNodeIndex);
                         }
                     }
-                    TraceLog(LOG_INFO, "Rendered choice %zu at yPos: %.2f (text: %s) for node %d", i, yPos,
+                    LogDebug("Rendered choice %zu at yPos: %.2f (text: %s) for node %d", i, yPos,
                              nodes[currentNodeIndex].connections[i].choiceText.c_str(), currentNodeIndex);
                 } else {
-                    TraceLog(LOG_WARNING, "Choice %zu at yPos: %.2f is outside visible area (boxY: %.2f, boxHeight: %.2f) for node %d",
+                    LogDebug("Choice %zu at yPos: %.2f is outside visible area (boxY: %.2f, boxHeight: %.2f) for node %d",
                              i, yPos, boxY, boxHeight, currentNodeIndex);
                 }
             }
@@ -249,7 +250,7 @@ void Render::drawElement(const SceneElement& sceneElement, const Element& elemen
                               0.0f,
                               scale,
                               WHITE);
-                TraceLog(LOG_INFO, "Rendering character '%s' at posX=%.2f, posY=%.2f, positionIndex=%d",
+                LogDebug("Rendering character '%s' at posX=%.2f, posY=%.2f, positionIndex=%d",
                          character.name.c_str(), posX, posY, character.positionIndex);
                 break;
             }
@@ -262,9 +263,9 @@ void Render::setCurrentNodeIndex(int index) {
         currentNodeIndex = index;
         currentSlide = 1; // Reset slide when changing nodes
         scrollOffset.y = 0.0f;
-        TraceLog(LOG_INFO, "Set current node to %d (sceneIndex: %d)", currentNodeIndex, nodes[currentNodeIndex].sceneIndex);
+        LogInfo("Set current node to %d (sceneIndex: %d)", currentNodeIndex, nodes[currentNodeIndex].sceneIndex);
     } else {
-        TraceLog(LOG_ERROR, "Attempted to set invalid node index %d", index);
+        LogError("Attempted to set invalid node index %d", index);
     }
 }
 
@@ -274,13 +275,13 @@ int Render::getCurrentNodeIndex() const {
 
 void Render::nextSlide() {
     currentSlide++;
-    TraceLog(LOG_INFO, "Advanced to slide %d", currentSlide);
+    LogInfo("Advanced to slide %d", currentSlide);
 }
 
 void Render::prevSlide() {
     if (currentSlide > 1) {
         currentSlide--;
-        TraceLog(LOG_INFO, "Moved back to slide %d", currentSlide);
+        LogInfo("Moved back to slide %d", currentSlide);
     }
 }
 
@@ -297,17 +298,17 @@ void Render::resetSlide() {
     // Fallback to first node if no start node is found
     if (!foundStartNode && !nodes.empty()) {
         currentNodeIndex = 0;
-        TraceLog(LOG_WARNING, "No start node found, falling back to node 0 (sceneIndex: %d)", nodes[0].sceneIndex);
+        LogWarning("No start node found, falling back to node 0 (sceneIndex: %d)", nodes[0].sceneIndex);
     } else if (!foundStartNode) {
         currentNodeIndex = -1;
-        TraceLog(LOG_ERROR, "No nodes available for reset");
+        LogError("No nodes available for reset");
     }
     currentSlide = 1;
     scrollOffset.y = 0.0f;
     if (currentNodeIndex >= 0 && nodes[currentNodeIndex].sceneIndex >= 0 && nodes[currentNodeIndex].sceneIndex < (int)scenes.size()) {
-        TraceLog(LOG_INFO, "Reset to node %d (sceneIndex: %d) and slide 1", currentNodeIndex, nodes[currentNodeIndex].sceneIndex);
+        LogInfo("Reset to node %d (sceneIndex: %d) and slide 1", currentNodeIndex, nodes[currentNodeIndex].sceneIndex);
     } else {
-        TraceLog(LOG_WARNING, "Reset failed: invalid node %d or sceneIndex %d", currentNodeIndex, currentNodeIndex >= 0 ? nodes[currentNodeIndex].sceneIndex : -1);
+        LogWarning("Reset failed: invalid node %d or sceneIndex %d", currentNodeIndex, currentNodeIndex >= 0 ? nodes[currentNodeIndex].sceneIndex : -1);
     }
 }
 
@@ -3,6 +3,7 @@
 
 #include "editors/ElementEditor.hpp"
 #include "utils/FileUtils.hpp"
+#include "utils/Log.hpp"
 
 #include <fstream>
 
@@ -165,12 +166,12 @@ void ElementEditor::updateElementMode()
         if (newFocusedTextBox != -1) 
         {
             focusedTextBox = newFocusedTextBox;
-            TraceLog(LOG_INFO, "Focused TextBox set to %d", focusedTextBox);
+            LogInfo("Focused TextBox set to %d", focusedTextBox);
         } 
         else if (!CheckCollisionPointRec(mousePos, Rectangle{220.0f, 10.0f, 770.0f, 580.0f})) 
         {
             focusedTextBox = -1;
-            TraceLog(LOG_INFO, "Focused TextBox cleared");
+            LogInfo("Focused TextBox cleared");
         }
     }
 }
@@ -228,11 +229,11 @@ void ElementEditor::loadElementToUI()
             UnloadImage(image);
             if (texture.id > 0) 
             {
-                TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", texture.id, img.second.c_str());
+                LogInfo("Loaded texture ID %u for path %s", texture.id, img.second.c_str());
             } 
             else 
             {
-                TraceLog(LOG_WARNING, "Failed to load texture for path %s", img.second.c_str());
+                LogWarning("Failed to load texture for path %s", img.second.c_str());
             }
             character.textures.push_back(texture);
         }
@@ -249,10 +250,10 @@ void ElementEditor::loadElementToUI()
         UnloadImage(img);
         if (bg.texture.id > 0) 
         {
-            TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", bg.texture.id, bg.imagePath.c_str());
+            LogInfo("Loaded texture ID %u for path %s", bg.texture.id, bg.imagePath.c_str());
         } else 
         {
-            TraceLog(LOG_WARNING, "Failed to load texture for path %s", bg.imagePath.c_str());
+            LogWarning("Failed to load texture for path %s", bg.imagePath.c_str());
         }
     }
     imageNameBuffer[0] = '\0';
@@ -300,11 +301,11 @@ void ElementEditor::saveElement()
             UnloadImage(img);
             if (bg.texture.id > 0) 
             {
-                TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", bg.texture.id, bg.imagePath.c_str());
+                LogInfo("Loaded texture ID %u for path %s", bg.texture.id, bg.imagePath.c_str());
             } 
             else 
             {
-                TraceLog(LOG_WARNING, "Failed to load texture for path %s", bg.imagePath.c_str());
+                LogWarning("Failed to load texture for path %s", bg.imagePath.c_str());
             }
         }
         element.data = bg;
@@ -353,7 +354,7 @@ void ElementEditor::drawClippedElementMode()
                 currentElementIndex = i;
                 isEditing = true;
                 loadElementToUI();
-                TraceLog(LOG_INFO, "Selected Element %d", i);
+                LogInfo("Selected Element %zu", i);
             }
         }
     }
@@ -373,7 +374,7 @@ void ElementEditor::drawClippedElementMode()
         isEditing = true;
         focusedTextBox = -1;
         clearBuffers();
-        TraceLog(LOG_INFO, "Creating new Element");
+        LogInfo("Creating new Element");
     }
 
     if (GuiButton(this->_resolver.resolve({20.0f, 510.0f, 180.0f, 30.0f}), "Export to JSON")) 
@@ -404,7 +405,7 @@ void ElementEditor::drawClippedElementMode()
             if (focusedTextBox == 1 && elementTypeIndex != 0) focusedTextBox = -1;
             if (focusedTextBox == 2 && elementTypeIndex != 1) focusedTextBox = -1;
             if (focusedTextBox == 3 && elementTypeIndex != 2) focusedTextBox = -1;
-            TraceLog(LOG_INFO, "Element type changed to %d", elementTypeIndex);
+            LogInfo("Element type changed to %d", elementTypeIndex);
         }
 
         if (elementTypeIndex == 0) 
@@ -445,7 +446,7 @@ void ElementEditor::drawClippedElementMode()
                         editImageIndex = i;
                         strncpy(imageNameBuffer, character.images[i].first.c_str(), sizeof(imageNameBuffer));
                         strncpy(imagePathBuffer, character.images[i].second.c_str(), sizeof(imagePathBuffer));
-                        TraceLog(LOG_INFO, "Editing image %d for Character", i);
+                        LogInfo("Editing image %zu for Character", i);
                     }
                 }
             }
@@ -458,7 +459,7 @@ void ElementEditor::drawClippedElementMode()
                 showAddImage = true;
                 imageNameBuffer[0] = '\0';
                 imagePathBuffer[0] = '\0';
-                TraceLog(LOG_INFO, "Adding new image for Character");
+                LogInfo("Adding new image for Character");
             }
 
             if (showAddImage || showEditImage) 
@@ -475,7 +476,7 @@ void ElementEditor::drawClippedElementMode()
                     if (!file.empty()) 
                     {
                         strncpy(imagePathBuffer, file.c_str(), sizeof(imagePathBuffer));
-                        TraceLog(LOG_INFO, "Selected image file: %s", imagePathBuffer);
+                        LogInfo("Selected image file: %s", imagePathBuffer);
                         if (currentElementIndex >= 0 && elements[currentElementIndex].type == ElementType::CHARACTER) 
                         {
                             auto& character = std::get<CharacterElement>(elements[currentElementIndex].data);
@@ -492,11 +493,11 @@ void ElementEditor::drawClippedElementMode()
                                 UnloadImage(img);
                                 if (character.textures[editImageIndex].id > 0) 
                                 {
-                                    TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", character.textures[editImageIndex].id, file.c_str());
+                                    LogInfo("Loaded texture ID %u for path %s", character.textures[editImageIndex].id, file.c_str());
                                 } 
                                 else
                                 {
-                                    TraceLog(LOG_WARNING, "Failed to load texture for path %s", file.c_str());
+                                    LogWarning("Failed to load texture for path %s", file.c_str());
                                 }
                                 strncpy(imagePathBuffer, file.c_str(), sizeof(imagePathBuffer));
                             }
@@ -516,11 +517,11 @@ void ElementEditor::drawClippedElementMode()
                             UnloadImage(img);
                             if (texture.id > 0) 
                             {
-                                TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", texture.id, imagePathBuffer);
+                                LogInfo("Loaded texture ID %u for path %s", texture.id, imagePathBuffer);
                             } 
                             else 
                             {
-                                TraceLog(LOG_WARNING, "Failed to load texture for path %s", imagePathBuffer);
+                                LogWarning("Failed to load texture for path %s", imagePathBuffer);
                             }
                             character.textures.push_back(texture);
                         } 
@@ -540,11 +541,11 @@ void ElementEditor::drawClippedElementMode()
                             UnloadImage(img);
                             if (character.textures[editImageIndex].id > 0) 
                             {
-                                TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", character.textures[editImageIndex].id, imagePathBuffer);
+                                LogInfo("Loaded texture ID %u for path %s", character.textures[editImageIndex].id, imagePathBuffer);
                             } 
                             else
                             {
-                                TraceLog(LOG_WARNING, "Failed to load texture for path %s", imagePathBuffer);
+                                LogWarning("Failed to load texture for path %s", imagePathBuffer);
                             }
                         }
                     }
@@ -572,7 +573,7 @@ void ElementEditor::drawClippedElementMode()
                 if (!file.empty()) 
                 {
                     strncpy(bgPathBuffer, file.c_str(), sizeof(bgPathBuffer));
-                    TraceLog(LOG_INFO, "Selected background file: %s", bgPathBuffer);
+                    LogInfo("Selected background file: %s", bgPathBuffer);
                     if (
                         currentElementIndex >= 0 && 
                         elements[currentElementIndex].type == ElementType::BACKGROUND)
@@ -588,10 +589,10 @@ void ElementEditor::drawClippedElementMode()
                         UnloadImage(img);
                         if (bg.texture.id > 0) 
                         {
-                            TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", bg.texture.id, file.c_str());
+                            LogInfo("Loaded texture ID %u for path %s", bg.texture.id, file.c_str());
                         } else 
                         {
-                            TraceLog(LOG_WARNING, "Failed to load texture for path %s", file.c_str());
+                            LogWarning("Failed to load texture for path %s", file.c_str());
                         }
                     }
                 }
@@ -615,7 +616,7 @@ void ElementEditor::drawClippedElementMode()
             saveElement();
             isEditing = false;
             loadElementToUI();
-            TraceLog(LOG_INFO, "Saved Element %d", currentElementIndex);
+            LogInfo("Saved Element %d", currentElementIndex);
         }
     }
 }
@@ -634,7 +635,7 @@ void ElementEditor::drawElementMode()
                 currentElementIndex = i;
                 isEditing = true;
                 loadElementToUI();
-                TraceLog(LOG_INFO, "Selected Element %d", i);
+                LogInfo("Selected Element %zu", i);
             }
         }
     }
@@ -654,7 +655,7 @@ void ElementEditor::drawElementMode()
         isEditing = true;
         focusedTextBox = -1;
         clearBuffers();
-        TraceLog(LOG_INFO, "Creating new Element");
+        LogInfo("Creating new Element");
     }
 
     if (GuiButton(Rectangle{20.0f, 510.0f, 180.0f, 30.0f}, "Export to JSON")) 
@@ -685,7 +686,7 @@ void ElementEditor::drawElementMode()
             if (focusedTextBox == 1 && elementTypeIndex != 0) focusedTextBox = -1;
             if (focusedTextBox == 2 && elementTypeIndex != 1) focusedTextBox = -1;
             if (focusedTextBox == 3 && elementTypeIndex != 2) focusedTextBox = -1;
-            TraceLog(LOG_INFO, "Element type changed to %d", elementTypeIndex);
+            LogInfo("Element type changed to %d", elementTypeIndex);
         }
 
         if (elementTypeIndex == 0) 
@@ -726,7 +727,7 @@ void ElementEditor::drawElementMode()
                         editImageIndex = i;
                         strncpy(imageNameBuffer, character.images[i].first.c_str(), sizeof(imageNameBuffer));
                         strncpy(imagePathBuffer, character.images[i].second.c_str(), sizeof(imagePathBuffer));
-                        TraceLog(LOG_INFO, "Editing image %d for Character", i);
+                        LogInfo("Editing image %zu for Character", i);
                     }
                 }
             }
@@ -739,7 +740,7 @@ void ElementEditor::drawElementMode()
                 showAddImage = true;
                 imageNameBuffer[0] = '\0';
                 imagePathBuffer[0] = '\0';
-                TraceLog(LOG_INFO, "Adding new image for Character");
+                LogInfo("Adding new image for Character");
             }
 
             if (showAddImage || showEditImage) 
@@ -756,7 +757,7 @@ void ElementEditor::drawElementMode()
                     if (!file.empty()) 
                     {
                         strncpy(imagePathBuffer, file.c_str(), sizeof(imagePathBuffer));
-                        TraceLog(LOG_INFO, "Selected image file: %s", imagePathBuffer);
+                        LogInfo("Selected image file: %s", imagePathBuffer);
                         if (currentElementIndex >= 0 && elements[currentElementIndex].type == ElementType::CHARACTER) 
                         {
                             auto& character = std::get<CharacterElement>(elements[currentElementIndex].data);
@@ -773,11 +774,11 @@ void ElementEditor::drawElementMode()
                                 UnloadImage(img);
                                 if (character.textures[editImageIndex].id > 0) 
                                 {
-                                    TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", character.textures[editImageIndex].id, file.c_str());
+                                    LogInfo("Loaded texture ID %u for path %s", character.textures[editImageIndex].id, file.c_str());
                                 } 
                                 else
                                 {
-                                    TraceLog(LOG_WARNING, "Failed to load texture for path %s", file.c_str());
+                                    LogWarning("Failed to load texture for path %s", file.c_str());
                                 }
                                 strncpy(imagePathBuffer, file.c_str(), sizeof(imagePathBuffer));
                             }
@@ -797,11 +798,11 @@ void ElementEditor::drawElementMode()
                             UnloadImage(img);
                             if (texture.id > 0) 
                             {
-                                TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", texture.id, imagePathBuffer);
+                                LogInfo("Loaded texture ID %u for path %s", texture.id, imagePathBuffer);
                             } 
                             else 
                             {
-                                TraceLog(LOG_WARNING, "Failed to load texture for path %s", imagePathBuffer);
+                                LogWarning("Failed to load texture for path %s", imagePathBuffer);
                             }
                             character.textures.push_back(texture);
                         } 
@@ -821,11 +822,11 @@ void ElementEditor::drawElementMode()
                             UnloadImage(img);
                             if (character.textures[editImageIndex].id > 0) 
                             {
-                                TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", character.textures[editImageIndex].id, imagePathBuffer);
+                                LogInfo("Loaded texture ID %u for path %s", character.textures[editImageIndex].id, imagePathBuffer);
                             } 
                             else
                             {
-                                TraceLog(LOG_WARNING, "Failed to load texture for path %s", imagePathBuffer);
+                                LogWarning("Failed to load texture for path %s", imagePathBuffer);
                             }
                         }
                     }
@@ -853,7 +854,7 @@ void ElementEditor::drawElementMode()
                 if (!file.empty()) 
                 {
                     strncpy(bgPathBuffer, file.c_str(), sizeof(bgPathBuffer));
-                    TraceLog(LOG_INFO, "Selected background file: %s", bgPathBuffer);
+                    LogInfo("Selected background file: %s", bgPathBuffer);
                     if (
                         currentElementIndex >= 0 && 
                         elements[currentElementIndex].type == ElementType::BACKGROUND)
@@ -869,10 +870,10 @@ void ElementEditor::drawElementMode()
                         UnloadImage(img);
                         if (bg.texture.id > 0) 
                         {
-                            TraceLog(LOG_INFO, "Loaded texture ID %u for path %s", bg.texture.id, file.c_str());
+                            LogInfo("Loaded texture ID %u for path %s", bg.texture.id, file.c_str());
                         } else 
                         {
-                            TraceLog(LOG_WARNING, "Failed to load texture for path %s", file.c_str());
+                            LogWarning("Failed to load texture for path %s", file.c_str());
                         }
                     }
                 }
@@ -896,7 +897,7 @@ void ElementEditor::drawElementMode()
             saveElement();
             isEditing = false;
             loadElementToUI();
-            TraceLog(LOG_INFO, "Saved Element %d", currentElementIndex);
+            LogInfo("Saved Element %d", currentElementIndex);
         }
     }
 }
@@ -963,5 +964,5 @@ void ElementEditor::exportToJson()
     std::ofstream file("elements_and_scenes.json");
     file << j_export.dump(4);
     file.close();
-    TraceLog(LOG_INFO, "Exported to elements_and_scenes.json");
+    LogInfo("Exported to elements_and_scenes.json");
 }
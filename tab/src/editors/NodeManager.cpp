@@ -1,4 +1,5 @@
 #include "editors/NodeManager.hpp"
+#include "utils/Log.hpp"
 
 NodeManager::NodeManager(std::vector<Scene>& scenes) :
     scenes(scenes),
@@ -70,15 +71,15 @@ void NodeManager::update()
                     if (i < nodes.size()) {
                         char buffer[256] = "Enter choice text";
                         nodes[fromNode].connections.push_back({i, buffer});
-                        TraceLog(LOG_INFO, "Created connection from node %zu to node %zu with choice text: %s", fromNode, i, buffer);
+                        LogInfo("Created connection from node %zu to node %zu with choice text: %s", fromNode, i, buffer);
                     } else {
-                        TraceLog(LOG_WARNING, "Attempted to create connection to invalid node index %zu", i);
+                        LogWarning("Attempted to create connection to invalid node index %zu", i);
                     }
                     break;
                 }
             }
             creatingConnection = false;
-            TraceLog(LOG_INFO, "Connection creation ended");
+            LogInfo("Connection creation ended");
         }
     }
 
@@ -95,7 +96,7 @@ void NodeManager::update()
             if (isMouseOverNodeOutput(i)) {
                 creatingConnection = true;
                 fromNode = i;
-                TraceLog(LOG_INFO, "Started connection creation from node %zu", i);
+                LogInfo("Started connection creation from node %zu", i);
                 break;
             }
         }
@@ -123,12 +124,11 @@ void NodeManager::update()
                 } else {
                     choiceTextBuffer[0] = '\0';
                 }
-                TraceLog(LOG_INFO, "Opened edit UI for node %zu: %s", i, nodes[i].name.c_str());
-                TraceLog(LOG_DEBUG, "Node %zu has %zu connections:", i, nodes[i].connections.size());
+                LogInfo("Opened edit UI for node %zu: %s", i, nodes[i].name.c_str());
+                LogDebug("Node %zu has %zu connections:", i, nodes[i].connections.size());
                 for (size_t j = 0; j < nodes[i].connections.size(); ++j) {
-                    size_t toNodeIndex = nodes[i].connections[j].toNodeIndex;
-                    TraceLog(LOG_DEBUG, "  Connection %zu: toNodeIndex=%zu, choiceText=%s",
-                        j, toNodeIndex, nodes[i].connections[j].choiceText.c_str());
+                    LogDebug("  Connection %zu: toNodeIndex=%zu, choiceText=%s",
+                        j, nodes[i].connections[j].toNodeIndex, nodes[i].connections[j].choiceText.c_str());
                 }
                 break;
             }
@@ -145,7 +145,7 @@ void NodeManager::update()
         deleteNode(selectedNode);
         selectedNode = -1;
         editingNode = false;
-        TraceLog(LOG_INFO, "Deleted node");
+        LogInfo("Deleted node");
     }
 }
 
@@ -164,7 +164,7 @@ void NodeManager::draw()
                 DrawLineBezier(start, end, 2.0f, DARKGRAY);
                 DrawText(conn.choiceText.c_str(), (start.x + end.x) / 2, (start.y + end.y) / 2 - 10, 10, BLACK);
             } else {
-                TraceLog(LOG_WARNING, "Invalid toNodeIndex %zu in connection %zu for node %zu", conn.toNodeIndex, j, i);
+                LogWarning("Invalid toNodeIndex %zu in connection %zu for node %zu", conn.toNodeIndex, j, i);
             }
         }
     }
@@ -219,13 +219,13 @@ void NodeManager::draw()
 void NodeManager::addNode(float x, float y)
 {
     nodes.emplace_back(Node{"Node " + std::to_string(nodes.size() + 1), -1, {}, {x, y}, DragType::SIMPLE, LIGHTGRAY});
-    TraceLog(LOG_INFO, "Added node at (%f, %f)", x, y);
+    LogInfo("Added node at (%f, %f)", x, y);
 }
 
 void NodeManager::deleteNode(size_t index)
 {
     if (index >= nodes.size()) {
-        TraceLog(LOG_WARNING, "Attempted to delete invalid node index %zu", index);
+        LogWarning("Attempted to delete invalid node index %zu", index);
         return;
     }
     bool wasStartNode = nodes[index].isStartNode;
@@ -236,11 +236,11 @@ void NodeManager::deleteNode(size_t index)
         while (it != node.connections.end()) {
             if (it->toNodeIndex == index) {
                 it = node.connections.erase(it);
-                TraceLog(LOG_INFO, "Removed connection to deleted node %zu", index);
+                LogInfo("Removed connection to deleted node %zu", index);
             } else {
                 if (it->toNodeIndex > index) {
                     it->toNodeIndex--;
-                    TraceLog(LOG_INFO, "Adjusted toNodeIndex to %zu for connection", it->toNodeIndex);
+                    LogInfo("Adjusted toNodeIndex to %zu for connection", it->toNodeIndex);
                 }
                 ++it;
             }
@@ -249,7 +249,7 @@ void NodeManager::deleteNode(size_t index)
     // If the deleted node was the start node, assign the first node as the new start node
     if (wasStartNode && !nodes.empty()) {
         nodes[0].isStartNode = true;
-        TraceLog(LOG_INFO, "Assigned node 0 as new start node after deletion");
+        LogInfo("Assigned node 0 as new start node after deletion");
     }
 }
 
@@ -338,14 +338,14 @@ size_t NodeManager::getIncomingConnectionIndex(size_t targetNodeIndex, size_t so
             }
         }
     }
-    TraceLog(LOG_WARNING, "Could not find incoming connection index for target %zu from source %zu, conn %zu", targetNodeIndex, sourceNodeIndex, sourceConnIndex);
+    LogWarning("Could not find incoming connection index for target %zu from source %zu, conn %zu", targetNodeIndex, sourceNodeIndex, sourceConnIndex);
     return 0;
 }
 
 float NodeManager::getNodeHeight(size_t index)
 {
     if (index >= nodes.size()) {
-        TraceLog(LOG_WARNING, "Invalid node index %zu for getNodeHeight", index);
+        LogWarning("Invalid node index %zu for getNodeHeight", index);
         return 60.0f;
     }
     if (connectionRenderMode == ConnectionRenderMode::SINGLE_POINT) {
@@ -363,7 +363,7 @@ float NodeManager::getNodeHeight(size_t index)
 Vector2 NodeManager::getNodeInputPos(size_t index, size_t connectionIndex)
 {
     if (index >= nodes.size()) {
-        TraceLog(LOG_WARNING, "Invalid node index %zu for getNodeInputPos", index);
+        LogWarning("Invalid node index %zu for getNodeInputPos", index);
         return {0, 0};
     }
     float nodeHeight = getNodeHeight(index);
@@ -381,7 +381,7 @@ Vector2 NodeManager::getNodeInputPos(size_t index, size_t connectionIndex)
 Vector2 NodeManager::getNodeOutputPos(size_t index, size_t connectionIndex)
 {
     if (index >= nodes.size()) {
-        TraceLog(LOG_WARNING, "Invalid node index %zu for getNodeOutputPos", index);
+        LogWarning("Invalid node index %zu for getNodeOutputPos", index);
         return {0, 0};
     }
     float nodeHeight = getNodeHeight(index);
@@ -399,7 +399,7 @@ Vector2 NodeManager::getNodeOutputPos(size_t index, size_t connectionIndex)
 void NodeManager::drawEditUI()
 {
     if (selectedNode < 0 || selectedNode >= static_cast<int>(nodes.size())) {
-        TraceLog(LOG_WARNING, "Invalid selectedNode %d in drawEditUI", selectedNode);
+        LogWarning("Invalid selectedNode %d in drawEditUI", selectedNode);
         editingNode = false;
         selectedNode = -1;
         selectedConnection = -1;
@@ -421,7 +421,7 @@ void NodeManager::drawEditUI()
     if (GuiTextBox({panelX + 10, 110, 160, 20}, textBuffer, 256, editTextFlag))
     {
         editTextFlag = !editTextFlag;
-        TraceLog(LOG_INFO, "Toggled node name edit: %s", textBuffer);
+        LogInfo("Toggled node name edit: %s", textBuffer);
     }
 
     DrawText("Drag Type:", panelX + 10, 190, 12, BLACK);
@@ -439,7 +439,7 @@ void NodeManager::drawEditUI()
                 node.isStartNode = false;
             }
             nodes[selectedNode].isStartNode = true;
-            TraceLog(LOG_INFO, "Set node %d as start node", selectedNode);
+            LogInfo("Set node %d as start node", selectedNode);
         } else if (!isStartNode && nodes[selectedNode].isStartNode) {
             nodes[selectedNode].isStartNode = false;
             // Assign first node as start node if no other is selected
@@ -452,7 +452,7 @@ void NodeManager::drawEditUI()
             }
             if (!hasStartNode && !nodes.empty()) {
                 nodes[0].isStartNode = true;
-                TraceLog(LOG_INFO, "Assigned node 0 as start node after unsetting");
+                LogInfo("Assigned node 0 as start node after unsetting");
             }
         }
     }
@@ -464,7 +464,7 @@ void NodeManager::drawEditUI()
         if (GuiTextBox({panelX + 10, 380, 160, 20}, choiceTextBuffer, 256, editChoiceTextFlag)) {
             editChoiceTextFlag = !editChoiceTextFlag;
             isEditingChoiceText = editChoiceTextFlag;
-            TraceLog(LOG_INFO, "Toggled choice text edit: %s, isEditingChoiceText: %d", choiceTextBuffer, isEditingChoiceText);
+            LogInfo("Toggled choice text edit: %s, isEditingChoiceText: %d", choiceTextBuffer, isEditingChoiceText);
         }
     } else {
         isEditingChoiceText = false;
@@ -482,7 +482,7 @@ void NodeManager::drawEditUI()
         if (selectedConnection >= 0) {
             strncpy(choiceTextBuffer, nodes[selectedNode].connections[selectedConnection].choiceText.c_str(), 256);
         }
-        TraceLog(LOG_INFO, "Connection deleted for node %d, new selectedConnection: %d", selectedNode, selectedConnection);
+        LogInfo("Connection deleted for node %d, new selectedConnection: %d", selectedNode, selectedConnection);
     }
 
     if (GuiButton({panelX + 10, 460, 160, 20}, "Save"))
@@ -490,9 +490,9 @@ void NodeManager::drawEditUI()
         nodes[selectedNode].name = textBuffer;
         if (selectedConnection >= 0 && selectedConnection < static_cast<int>(nodes[selectedNode].connections.size())) {
             nodes[selectedNode].connections[selectedConnection].choiceText = choiceTextBuffer;
-            TraceLog(LOG_INFO, "Saved choice text for connection %d: %s", selectedConnection, choiceTextBuffer);
+            LogInfo("Saved choice text for connection %d: %s", selectedConnection, choiceTextBuffer);
         }
-        TraceLog(LOG_INFO, "Saved node name: %s", textBuffer);
+        LogInfo("Saved node name: %s", textBuffer);
         isEditingChoiceText = false;
     }
 
@@ -503,14 +503,14 @@ void NodeManager::drawEditUI()
         selectedNode = -1;
         selectedConnection = -1;
         isEditingChoiceText = false;
-        TraceLog(LOG_INFO, "Node deleted");
+        LogInfo("Node deleted");
     }
 
     if (GuiButton({panelX + 10, 520, 160, 20}, "Add New Node"))
     {
         Vector2 mouse = GetMousePosition();
         addNode(mouse.x - offset.x, mouse.y - offset.y);
-        TraceLog(LOG_INFO, "Node added at (%f, %f)", mouse.x - offset.x, mouse.y - offset.y);
+        LogInfo("Node added at (%f, %f)", mouse.x - offset.x, mouse.y - offset.y);
     }
 
     if (GuiButton({panelX + 10, 550, 160, 20}, "Close"))
@@ -525,7 +525,7 @@ void NodeManager::drawEditUI()
         editTextFlag = false;
         editChoiceTextFlag = false;
         isEditingChoiceText = false;
-        TraceLog(LOG_INFO, "Edit UI closed");
+        LogInfo("Edit UI closed");
     }
 
     static int prevSelectedConnection = -1;
@@ -543,17 +543,17 @@ void NodeManager::drawEditUI()
                     connDropdownText += ";";
                 }
             } else {
-                TraceLog(LOG_WARNING, "Invalid toNodeIndex %zu in connection %zu for node %d", toNodeIndex, i, selectedNode);
+                LogWarning("Invalid toNodeIndex %zu in connection %zu for node %d", toNodeIndex, i, selectedNode);
             }
         }
         if (connDropdownText.empty()) {
             connDropdownText = "None";
-            TraceLog(LOG_DEBUG, "No valid connections for node %d", selectedNode);
+            LogDebug("No valid connections for node %d", selectedNode);
         }
     } else {
-        TraceLog(LOG_DEBUG, "Node %d has no connections", selectedNode);
+        LogDebug("Node %d has no connections", selectedNode);
     }
-    TraceLog(LOG_DEBUG, "Connections dropdown text: %s, connectionIndex: %d", connDropdownText.c_str(), connectionIndex);
+    LogDebug("Connections dropdown text: %s, connectionIndex: %d", connDropdownText.c_str(), connectionIndex);
     if (GuiDropdownBox({panelX + 10, 350, 160, 20}, connDropdownText.c_str(), &connectionIndex, connDropdownEditMode))
     {
         connDropdownEditMode = !connDropdownEditMode;
@@ -565,7 +565,7 @@ void NodeManager::drawEditUI()
                 if (!isEditingChoiceText && selectedConnection != prevSelectedConnection) {
                     strncpy(choiceTextBuffer, nodes[selectedNode].connections[selectedConnection].choiceText.c_str(), 256);
                 }
-                TraceLog(LOG_INFO, "Selected connection %d (To %s) with choice text: %s",
+                LogInfo("Selected connection %d (To %s) with choice text: %s",
                     selectedConnection, nodes[nodes[selectedNode].connections[selectedConnection].toNodeIndex].name.c_str(), choiceTextBuffer);
             } else
             {
@@ -575,7 +575,7 @@ void NodeManager::drawEditUI()
                 } else {
                     choiceTextBuffer[0] = '\0';
                 }
-                TraceLog(LOG_INFO, "No valid connection selected for node %d, resetting to %d", selectedNode, selectedConnection);
+                LogInfo("No valid connection selected for node %d, resetting to %d", selectedNode, selectedConnection);
             }
             prevSelectedConnection = selectedConnection;
         }
@@ -591,7 +591,7 @@ void NodeManager::drawEditUI()
         if (!renderModeDropdownEditMode)
         {
             connectionRenderMode = static_cast<ConnectionRenderMode>(renderModeIndex);
-            TraceLog(LOG_INFO, "Connection render mode set to: %s", renderModeIndex == 0 ? "Single Point" : "Multi Point");
+            LogInfo("Connection render mode set to: %s", renderModeIndex == 0 ? "Single Point" : "Multi Point");
         }
     }
 
@@ -628,7 +628,7 @@ void NodeManager::drawEditUI()
                 case 2: nodes[selectedNode].color = GREEN; break;
                 case 3: nodes[selectedNode].color = RED; break;
             }
-            TraceLog(LOG_INFO, "Color selected: %d", colorIndex);
+            LogInfo("Color selected: %d", colorIndex);
         }
     }
 
@@ -639,7 +639,7 @@ void NodeManager::drawEditUI()
         if (!dragDropdownEditMode)
         {
             nodes[selectedNode].dragType = static_cast<DragType>(dragTypeIndex);
-            TraceLog(LOG_INFO, "Drag type selected: %d", dragTypeIndex);
+            LogInfo("Drag type selected: %d", dragTypeIndex);
         }
     }
 
@@ -660,7 +660,7 @@ void NodeManager::drawEditUI()
         if (!sceneDropdownEditMode && selectedScene >= -1 && selectedScene < static_cast<int>(scenes.size()))
         {
             nodes[selectedNode].sceneIndex = selectedScene;
-            TraceLog(LOG_INFO, "Scene selected: %d (%s)", selectedScene,
+            LogInfo("Scene selected: %d (%s)", selectedScene,
                 selectedScene >= 0 ? scenes[selectedScene].name.c_str() : "None");
         }
     }
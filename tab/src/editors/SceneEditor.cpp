@@ -1,5 +1,6 @@
 #include "editors/SceneEditor.hpp"
 #include "utils/FileUtils.hpp"
+#include "utils/Log.hpp"
 #include <algorithm>
 #include <fstream>
 
@@ -74,11 +75,11 @@ void SceneEditor::updateSceneMode() {
 
         if (newFocusedTextBox != -1) {
             focusedTextBox = newFocusedTextBox;
-            TraceLog(LOG_INFO, "Focused TextBox set to %d", focusedTextBox);
+            LogInfo("Focused TextBox set to %d", focusedTextBox);
         } else if (!CheckCollisionPointRec(mousePos, Rectangle{220.0f, 10.0f, 770.0f, 580.0f}) &&
                    !CheckCollisionPointRec(mousePos, Rectangle{280.0f, 220.0f, 640.0f, 370.0f})) {
             focusedTextBox = -1;
-            TraceLog(LOG_INFO, "Focused TextBox cleared");
+            LogInfo("Focused TextBox cleared");
         }
     }
 }
@@ -115,7 +116,7 @@ void SceneEditor::drawSceneMode() {
                 isEditing = true;
                 focusedTextBox = -1;
                 loadSceneToUI();
-                TraceLog(LOG_INFO, "Selected Scene %d", currentSceneIndex);
+                LogInfo("Selected Scene %d", currentSceneIndex);
             }
         }
     }
@@ -140,7 +141,7 @@ void SceneEditor::drawSceneMode() {
         renderLevelBuffer[0] = '\0';
         positionIndexBuffer[0] = '\0'; // Added for positionIndex
         poseBuffer[0] = '\0';
-        TraceLog(LOG_INFO, "Creating new Scene");
+        LogInfo("Creating new Scene");
     }
 
     if (GuiButton(Rectangle{20.0f, 510.0f, 180.0f, 30.0f}, "Export to JSON")) {
@@ -176,7 +177,7 @@ void SceneEditor::drawSceneMode() {
                         Color buttonColor = (static_cast<int>(i) == currentSceneElementIndex) ? SKYBLUE : LIGHTGRAY;
                         GuiSetStyle(BUTTON, BASE_COLOR_NORMAL, ColorToInt(buttonColor));
                         if (GuiButton(Rectangle{280.0f, yPos, 300.0f, 30.0f}, elementInfo.c_str())) {
-                            TraceLog(LOG_INFO, "Clicked SceneElement %d (ElementIndex=%zu)", i, elemIndex);
+                            LogInfo("Clicked SceneElement %zu (ElementIndex=%zu)", i, elemIndex);
                             currentSceneElementIndex = i;
                             isEditing = true;
                             focusedTextBox = -1;
@@ -207,7 +208,7 @@ void SceneEditor::drawSceneMode() {
             poseBuffer[0] = '\0';
             isEditing = true;
             focusedTextBox = -1;
-            TraceLog(LOG_INFO, "Adding new SceneElement");
+            LogInfo("Adding new SceneElement");
         }
 
         if (currentSceneIndex >= 0 && GuiButton(Rectangle{850.0f, 60.0f, 120.0f, 20.0f}, "Sort Elements")) {
@@ -223,7 +224,7 @@ void SceneEditor::drawSceneMode() {
                 positionIndexBuffer[0] = '\0'; // Added for positionIndex
                 poseBuffer[0] = '\0';
             }
-            TraceLog(LOG_INFO, "Sorted SceneElements");
+            LogInfo("Sorted SceneElements");
         }
 
         if (currentSceneElementIndex >= -1 && (currentSceneIndex >= 0 || currentSceneIndex == -1)) {
@@ -237,17 +238,17 @@ void SceneEditor::drawSceneMode() {
                 if (currentSceneIndex >= 0 && currentSceneElementIndex >= 0 &&
                     currentSceneElementIndex < (int)scenes[currentSceneIndex].elements.size()) {
                     selectedElement = scenes[currentSceneIndex].elements[currentSceneElementIndex].elementIndex;
-                    TraceLog(LOG_INFO, "Set selectedElement to %d for SceneElement %d", selectedElement, currentSceneElementIndex);
+                    LogInfo("Set selectedElement to %d for SceneElement %d", selectedElement, currentSceneElementIndex);
                 } else if (currentSceneElementIndex == -1 && !elements.empty()) {
                     selectedElement = 0;
-                    TraceLog(LOG_INFO, "Reset selectedElement to 0 for new SceneElement");
+                    LogInfo("Reset selectedElement to 0 for new SceneElement");
                 }
                 prevSceneElementIndex = currentSceneElementIndex;
             }
             int prevSelectedElement = selectedElement;
             GuiComboBox(Rectangle{340.0f, 70.0f, 200.0f, 20.0f}, elementNames.c_str(), &selectedElement);
             if (prevSelectedElement != selectedElement) {
-                TraceLog(LOG_INFO, "Element dropdown changed to %d (prev=%d)", selectedElement, prevSelectedElement);
+                LogInfo("Element dropdown changed to %d (prev=%d)", selectedElement, prevSelectedElement);
                 // Reset pose and positionIndex when element changes
                 poseBuffer[0] = '\0';
                 positionIndexBuffer[0] = '\0'; // Added for positionIndex
@@ -297,14 +298,14 @@ void SceneEditor::drawSceneMode() {
                     prevSceneElementIndex = currentSceneElementIndex;
                 }
                 loadSceneElementToUI();
-                TraceLog(LOG_INFO, "Saved SceneElement, set currentSceneElementIndex to %d", currentSceneElementIndex);
+                LogInfo("Saved SceneElement, set currentSceneElementIndex to %d", currentSceneElementIndex);
             }
         }
     }
 }
 
 void SceneEditor::loadSceneToUI() {
-    TraceLog(LOG_INFO, "Loading Scene %d", currentSceneIndex);
+    LogInfo("Loading Scene %d", currentSceneIndex);
     if (currentSceneIndex < 0 || currentSceneIndex >= (int)scenes.size()) {
         strncpy(sceneNameBuffer, "New Scene", sizeof(sceneNameBuffer));
         startTimeBuffer[0] = '\0';
@@ -335,7 +336,7 @@ void SceneEditor::loadSceneToUI() {
 void SceneEditor::loadSceneElementToUI() {
     if (currentSceneIndex < 0 || currentSceneElementIndex < 0 ||
         currentSceneElementIndex >= (int)scenes[currentSceneIndex].elements.size()) {
-        TraceLog(LOG_INFO, "Clearing SceneElement UI (invalid selection: Scene=%d, SceneElement=%d)",
+        LogInfo("Clearing SceneElement UI (invalid selection: Scene=%d, SceneElement=%d)",
                  currentSceneIndex, currentSceneElementIndex);
         startTimeBuffer[0] = '\0';
         endTimeBuffer[0] = '\0';
@@ -351,14 +352,14 @@ void SceneEditor::loadSceneElementToUI() {
     snprintf(renderLevelBuffer, sizeof(renderLevelBuffer), "%d", sceneElement.renderlevel);
     snprintf(positionIndexBuffer, sizeof(positionIndexBuffer), "%d", sceneElement.positionIndex); // Added for positionIndex
     strncpy(poseBuffer, sceneElement.selectedPose.c_str(), sizeof(poseBuffer));
-    TraceLog(LOG_INFO, "Loaded SceneElement %d: ElementIndex=%zu, Start=%.1f, End=%.1f, RenderLevel=%d, PositionIndex=%d, Pose=%s",
+    LogInfo("Loaded SceneElement %d: ElementIndex=%zu, Start=%.1f, End=%.1f, RenderLevel=%d, PositionIndex=%d, Pose=%s",
              currentSceneElementIndex, sceneElement.elementIndex, sceneElement.startTime, sceneElement.endTime,
              sceneElement.renderlevel, sceneElement.positionIndex, sceneElement.selectedPose.c_str());
 }
 
 void SceneEditor::saveSceneElement(size_t selectedElementIndex, int selectedPoseIndex) {
     if (selectedElementIndex >= elements.size()) {
-        TraceLog(LOG_WARNING, "Invalid selectedElementIndex %zu", selectedElementIndex);
+        LogWarning("Invalid selectedElementIndex %zu", selectedElementIndex);
         return;
     }
 
@@ -415,7 +416,7 @@ void SceneEditor::saveSceneElement(size_t selectedElementIndex, int selectedPose
         }
         scenes[currentSceneIndex].name = sceneNameBuffer;
     }
-    TraceLog(LOG_INFO, "Saved SceneElement: Index=%d, ElementIndex=%zu, Start=%.1f, End=%.1f, RenderLevel=%d, PositionIndex=%d, Pose=%s",
+    LogInfo("Saved SceneElement: Index=%d, ElementIndex=%zu, Start=%.1f, End=%.1f, RenderLevel=%d, PositionIndex=%d, Pose=%s",
              currentSceneElementIndex, sceneElement.elementIndex, sceneElement.startTime, sceneElement.endTime,
              sceneElement.renderlevel, sceneElement.positionIndex, sceneElement.selectedPose.c_str());
     loadSceneElementToUI();
@@ -440,7 +441,7 @@ void SceneEditor::sortSceneElements() {
                   }
                   return a.endTime < b.endTime;
               });
-    TraceLog(LOG_INFO, "Sorted SceneElements for Scene %d", currentSceneIndex);
+    LogInfo("Sorted SceneElements for Scene %d", currentSceneIndex);
 }
 
 void SceneEditor::exportToJson() {
@@ -497,5 +498,5 @@ void SceneEditor::exportToJson() {
     std::ofstream file("elements_and_scenes.json");
     file << j_export.dump(4);
     file.close();
-    TraceLog(LOG_INFO, "Exported to elements_and_scenes.json");
+    LogInfo("Exported to elements_and_scenes.json");
 }
@@ -4,6 +4,7 @@
 #include "Render.hpp"
 #include "utils/JsonUtils.hpp"
 #include "raylib.h"
+#include "utils/Log.hpp"
 
 int main() {
     InitWindow(1000, 600, "Novel Renderer");
@@ -20,18 +21,18 @@ int main() {
     // Load project data
     try {
         JsonUtils::importFromFolder(elements, scenes, nodes, ".");
-        TraceLog(LOG_INFO, "Imported project from project.json");
+        LogInfo("Imported project from project.json");
 
         // Set renderer to the start node
         for (size_t i = 0; i < nodes.size(); ++i) {
             if (nodes[i].isStartNode) {
                 renderer.setCurrentNodeIndex(i);
-                TraceLog(LOG_INFO, "Set render node to start node %d", i);
+                LogInfo("Set render node to start node %zu", i);
                 break;
             }
         }
     } catch (const std::exception& e) {
-        TraceLog(LOG_ERROR, "Import failed: %s", e.what());
+        LogError("Import failed: %s", e.what());
         // Optionally, close the window if import fails
         CloseWindow();
         return 1;
@@ -0,0 +1,168 @@
+// Round-trip check for BlockCompressor: encodes synthetic images (a smooth
+// gradient, hard-edged stripes, an alpha ramp) as DXT1 and DXT5, decodes them
+// and fails if the PSNR drops below a per-image floor, then writes each one as
+// .dds and checks the header fields and that LoadImage() reads it back intact.
+// Needs raylib for the image helpers but no window, so it runs on a build farm:
+//   make compression-check && ./build/compression-check.out
+#include "BlockCompressor.hpp"
+#include "raylib.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Not a multiple of 4, so the partial edge blocks are covered too
+constexpr int WIDTH = 70;
+constexpr int HEIGHT = 38;
+
+using PixelFunction = std::function<void(int x, int y, unsigned char* rgba)>;
+
+struct Case {
+    const char* name;
+    PixelFunction pixel;
+    bool opaque;     // Whether the image can be encoded as DXT1 at all
+    double minDXT1;  // dB
+    double minDXT5;  // dB
+};
+
+Image makeImage(const PixelFunction& pixel, unsigned char alpha) {
+    Image image = {0};
+    image.width = WIDTH;
+    image.height = HEIGHT;
+    image.mipmaps = 1;
+    image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    unsigned char* data = (unsigned char*)RL_MALLOC((size_t)WIDTH * HEIGHT * 4);
+    for (int y = 0; y < HEIGHT; ++y) {
+        for (int x = 0; x < WIDTH; ++x) {
+            unsigned char* rgba = data + ((size_t)y * WIDTH + x) * 4;
+            rgba[3] = 255;
+            pixel(x, y, rgba);
+            if (rgba[3] == 255) rgba[3] = alpha; // Below 255 forces DXT5
+        }
+    }
+    image.data = data;
+    return image;
+}
+
+uint32_t readLE32(const unsigned char* in) {
+    return in[0] | (in[1] << 8) | (in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+bool checkDDS(const Image& compressed, const std::string& path) {
+    if (!BlockCompressor::exportDDS(compressed, path.c_str())) {
+        std::printf("    failed to write %s\n", path.c_str());
+        return false;
+    }
+    std::ifstream file(path, std::ios::binary);
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    bool dxt1 = compressed.format == PIXELFORMAT_COMPRESSED_DXT1_RGB;
+    size_t dataSize = (size_t)((WIDTH + 3) / 4) * ((HEIGHT + 3) / 4) * (dxt1 ? 8 : 16);
+    if (bytes.size() != 128 + dataSize || std::memcmp(bytes.data(), "DDS ", 4) != 0) {
+        std::printf("    %s: %zu bytes, expected magic and %zu\n", path.c_str(), bytes.size(), 128 + dataSize);
+        return false;
+    }
+    const unsigned char* header = bytes.data() + 4;
+    struct Field {
+        const char* name;
+        size_t offset;
+        uint32_t expected;
+    };
+    const Field fields[] = {
+        {"dwSize", 0, 124},
+        {"dwFlags", 4, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000},
+        {"dwHeight", 8, HEIGHT},
+        {"dwWidth", 12, WIDTH},
+        {"dwPitchOrLinearSize", 16, (uint32_t)dataSize},
+        {"dwMipMapCount", 24, 1},
+        {"ddspf.dwSize", 72, 32},
+        {"ddspf.dwFlags", 76, 0x4},
+        {"ddspf.dwFourCC", 80, readLE32((const unsigned char*)(dxt1 ? "DXT1" : "DXT5"))},
+        {"dwCaps", 104, 0x1000},
+    };
+    bool ok = true;
+    for (const auto& field : fields) {
+        uint32_t value = readLE32(header + field.offset);
+        if (value != field.expected) {
+            std::printf("    %s: %s is 0x%x, expected 0x%x\n", path.c_str(), field.name, value, field.expected);
+            ok = false;
+        }
+    }
+    if (std::memcmp(header + 124, compressed.data, dataSize) != 0) {
+        std::printf("    %s: block data differs from the encoded image\n", path.c_str());
+        ok = false;
+    }
+
+    Image loaded = LoadImage(path.c_str());
+    if (loaded.data == nullptr || loaded.format != compressed.format || loaded.width != WIDTH || loaded.height != HEIGHT ||
+        std::memcmp(loaded.data, compressed.data, dataSize) != 0) {
+        std::printf("    %s: LoadImage() did not read back the encoded image\n", path.c_str());
+        ok = false;
+    }
+    UnloadImage(loaded);
+    return ok;
+}
+
+bool runCase(const Case& testCase, unsigned char alpha, double minPSNR, const std::filesystem::path& folder) {
+    bool wantDXT1 = alpha == 255 && testCase.opaque;
+    Image source = makeImage(testCase.pixel, alpha);
+    Image compressed = BlockCompressor::compress(source);
+    int expectedFormat = wantDXT1 ? PIXELFORMAT_COMPRESSED_DXT1_RGB : PIXELFORMAT_COMPRESSED_DXT5_RGBA;
+    const char* formatName = wantDXT1 ? "DXT1" : "DXT5";
+
+    bool ok = compressed.data != nullptr && compressed.format == expectedFormat;
+    double psnr = ok ? BlockCompressor::computePSNR(source, compressed) : 0.0;
+    ok = ok && psnr >= minPSNR;
+    std::printf("  %-10s %s  %6.2f dB  (min %.1f)  %s\n", testCase.name, formatName, psnr, minPSNR, ok ? "ok" : "FAIL");
+    if (compressed.data != nullptr && compressed.format == expectedFormat) {
+        ok = checkDDS(compressed, (folder / (std::string(testCase.name) + "_" + formatName + ".dds")).string()) && ok;
+    }
+    UnloadImage(compressed);
+    UnloadImage(source);
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    SetTraceLogLevel(LOG_WARNING);
+    const Case cases[] = {
+        {"gradient", [](int x, int y, unsigned char* rgba) {
+             rgba[0] = (unsigned char)(x * 255 / (WIDTH - 1));
+             rgba[1] = (unsigned char)(y * 255 / (HEIGHT - 1));
+             rgba[2] = (unsigned char)(255 - (x + y) * 255 / (WIDTH + HEIGHT - 2));
+         }, true, 36.0, 36.0},
+        // Stripes 3 px wide so edges cross block boundaries at every offset
+        {"edges", [](int x, int y, unsigned char* rgba) {
+             bool stripe = ((x + y / 2) / 3) % 2 == 0;
+             rgba[0] = stripe ? 230 : 20;
+             rgba[1] = stripe ? 40 : 200;
+             rgba[2] = stripe ? 30 : 240;
+         }, true, 38.0, 38.0},
+        {"alpha-ramp", [](int x, int y, unsigned char* rgba) {
+             rgba[0] = 200;
+             rgba[1] = 120;
+             rgba[2] = 60;
+             rgba[3] = (unsigned char)((x + y) * 255 / (WIDTH + HEIGHT - 2));
+         }, false, 0.0, 40.0},
+    };
+
+    std::filesystem::path folder = std::filesystem::temp_directory_path() / "compression-check";
+    std::filesystem::create_directories(folder);
+    bool ok = true;
+    for (const auto& testCase : cases) {
+        if (testCase.opaque) ok = runCase(testCase, 255, testCase.minDXT1, folder) && ok;
+        ok = runCase(testCase, 254, testCase.minDXT5, folder) && ok;
+    }
+    std::filesystem::remove_all(folder);
+    std::printf(ok ? "all checks passed\n" : "some checks FAILED\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,326 @@
+// Checks for the headless core that need no window or assets: deleting
+// elements, scenes and nodes, and edit journal recovery after crashes at the awkward moments. Exits with
+// 1 if any fails.
+//   make core-check && ./build/core-check.out
+#include "EditJournal.hpp"
+#include "Log.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+struct Project {
+    ElementMap elements;
+    SceneMap scenes;
+    NodeMap nodes;
+
+    Project() {
+        nodes.push_back(Node("Start Node", -1, {}, {100, 100}, DragType::SIMPLE, LIGHTGRAY, true));
+    }
+
+    // The project as the journal saves it, to compare two of them
+    std::string dump() const {
+        std::string text;
+        JsonWriter writer([&](const char* data, size_t size) { text.append(data, size); }, JsonWriter::Style::COMPACT);
+        JsonUtils::writeProject(writer, elements, scenes, nodes, SlotIndexing::SLOTS);
+        return text;
+    }
+};
+
+// A few edits of every kind the editors report
+void edit(Project& project, EditJournal& journal, const std::string& tag) {
+    size_t index = project.nodes.insert(Node(tag));
+    journal.nodeChanged(index);
+    connect(project.nodes, 0, index, "to " + tag);
+    journal.nodeChanged(0);
+
+    Element element;
+    element.name = tag;
+    element.data = TextElement{"Text of " + tag};
+    journal.elementChanged(project.elements.insert(element));
+
+    Scene scene;
+    scene.name = tag;
+    journal.sceneChanged(project.scenes.insert(scene));
+}
+
+bool check(bool condition, const char* what) {
+    std::printf("  %-60s %s\n", what, condition ? "ok" : "FAIL");
+    return condition;
+}
+
+bool recoversAs(const fs::path& directory, const std::string& expected, const char* what) {
+    Project project;
+    EditJournal journal(project.elements, project.scenes, project.nodes, directory.string());
+    journal.open(0.0);
+    return check(project.dump() == expected, what);
+}
+
+// Deleting a node takes the choices leading to it along, so the renderer and
+// the node editor (which show every connection) never offer a dead one, and
+// the journal's replay of the deletion does the same
+bool checkEraseNode(const fs::path& directory) {
+    fs::remove_all(directory);
+    std::string expected;
+    bool ok = true;
+    {
+        Project project;
+        EditJournal journal(project.elements, project.scenes, project.nodes, directory.string());
+        journal.open(0.0);
+        NodeMap& nodes = project.nodes;
+        size_t a = nodes.insert(Node("a")), b = nodes.insert(Node("b")), c = nodes.insert(Node("c"));
+        connect(nodes, 0, a, "to a");
+        connect(nodes, 0, b, "to b");
+        connect(nodes, a, b, "a to b");
+        connect(nodes, a, b, "a to b again");
+        connect(nodes, b, c, "b to c");
+        connect(nodes, c, b, "c to b");
+        connect(nodes, b, b, "b to itself");
+        nodes[c].connections.clear(); // A stale entry in b's incoming
+        connect(nodes, c, 0, "c to start");
+        for (size_t i : {(size_t)0, a, b, c}) journal.nodeChanged(i);
+
+        eraseNode(nodes, b);
+        journal.nodeErased(b);
+        auto leadsTo = [&](size_t from, size_t to) {
+            for (const auto& conn : nodes[from].connections) {
+                if (conn.toNodeIndex == to) return true;
+            }
+            return false;
+        };
+        ok = check(nodes[0].connections.size() == 1 && !leadsTo(0, b), "choices into a deleted node are removed") && ok;
+        ok = check(nodes[a].connections.empty(), "every choice from the same node is removed") && ok;
+        ok = check(nodes[c].connections.size() == 1 && leadsTo(c, 0), "other choices are kept") && ok;
+
+        size_t reused = nodes.insert(Node("reuses b"));
+        journal.nodeChanged(reused);
+        ok = check(reused == b && !leadsTo(0, reused) && !leadsTo(a, reused), "a node reusing the slot has no choices into it") && ok;
+        expected = project.dump();
+    }
+    ok = recoversAs(directory, expected, "journal replays the deletion the same way") && ok;
+
+    Project recovered;
+    EditJournal journal(recovered.elements, recovered.scenes, recovered.nodes, directory.string());
+    journal.open(0.0);
+    ok = check(recovered.nodes[0].connections.size() == 1, "recovered nodes keep no choices into it") && ok;
+    return ok;
+}
+
+// Replaying a node's records (a drag, a rename) relinks its choices without
+// listing the node again in their targets' incoming, which would otherwise
+// grow with the journal
+bool checkReplayKeepsIncoming(const fs::path& directory) {
+    fs::remove_all(directory);
+    size_t target;
+    {
+        Project project;
+        EditJournal journal(project.elements, project.scenes, project.nodes, directory.string());
+        journal.open(0.0);
+        target = project.nodes.insert(Node("target"));
+        journal.nodeChanged(target);
+        connect(project.nodes, 0, target, "to target");
+        journal.nodeChanged(0);
+        for (float x : {200.0f, 300.0f}) {
+            project.nodes[0].position.x = x;
+            journal.nodeChanged(0);
+        }
+    }
+    Project recovered;
+    EditJournal journal(recovered.elements, recovered.scenes, recovered.nodes, directory.string());
+    journal.open(0.0);
+    bool ok = check(recovered.nodes[0].position.x == 300.0f, "the node's records were replayed");
+    ok = check(recovered.nodes[target].incoming.size() == 1, "replaying a node's records keeps its targets' incoming") && ok;
+    eraseNode(recovered.nodes, target);
+    ok = check(recovered.nodes[0].connections.empty(), "and deleting the target still removes the choice") && ok;
+    return ok;
+}
+
+// Deleting an element takes the scene elements showing it along, and
+// deleting a scene leaves the nodes showing it without one; neither is
+// resolved again once something else reuses the slot, nor after replay
+bool checkEraseElementAndScene(const fs::path& directory) {
+    fs::remove_all(directory);
+    std::string expected;
+    bool ok = true;
+    {
+        Project project;
+        EditJournal journal(project.elements, project.scenes, project.nodes, directory.string());
+        journal.open(0.0);
+        ElementMap& elements = project.elements;
+        SceneMap& scenes = project.scenes;
+        NodeMap& nodes = project.nodes;
+        size_t kept = elements.insert(Element()), erased = elements.insert(Element());
+        journal.elementChanged(kept);
+        journal.elementChanged(erased);
+        Scene scene;
+        for (size_t index : {kept, erased, erased}) {
+            SceneElement sceneElement;
+            sceneElement.elementIndex = index;
+            scene.elements.push_back(sceneElement);
+        }
+        size_t shown = scenes.insert(scene), other = scenes.insert(scene);
+        for (size_t i : {shown, other}) {
+            linkScene(elements, scenes, i);
+            indexSlides(elements, scenes[i]);
+            journal.sceneChanged(i);
+        }
+        size_t node = nodes.insert(Node("shows it", (int)shown));
+        linkSceneOf(scenes, nodes, node);
+        journal.nodeChanged(node);
+
+        eraseElement(elements, scenes, erased);
+        journal.elementErased(erased);
+        ok = check(scenes[shown].elements.size() == 1 && scenes[other].elements.size() == 1 &&
+                       scenes[shown].elements[0].elementIndex == kept,
+                   "scene elements of a deleted element are removed") && ok;
+        ok = check(scenes[shown].slides.countActive(1) == 1, "their slides are indexed again") && ok;
+
+        eraseScene(scenes, nodes, shown);
+        journal.sceneErased(shown);
+        ok = check(nodes[node].sceneIndex == -1 && findScene(scenes, nodes[node]) == nullptr,
+                   "nodes showing a deleted scene show none") && ok;
+
+        size_t reusedElement = elements.insert(Element());
+        size_t reusedScene = scenes.insert(Scene());
+        journal.elementChanged(reusedElement);
+        journal.sceneChanged(reusedScene);
+        SceneElement stale;
+        stale.elementIndex = erased;
+        ok = check(reusedElement == erased && findElement(elements, stale) == nullptr,
+                   "an element reusing the slot is not shown by old references") && ok;
+        ok = check(reusedScene == shown && nodes[node].sceneIndex == -1, "a scene reusing the slot is not shown") && ok;
+        expected = project.dump();
+
+        SavedIndices indices(elements, scenes, nodes, SlotIndexing::DENSE);
+        ok = check(indices.elements[kept] == 0 && indices.scenes[other] == 1, "files number what is left densely") && ok;
+    }
+    ok = recoversAs(directory, expected, "journal replays the deletions the same way") && ok;
+    return ok;
+}
+
+// The editor dies after an import replaced the project but before the
+// import's snapshot was written: the project as it was before the import must
+// come back, and a journal already started for the import (as an older
+// editor did) must not be replayed onto it
+bool checkCrashDuringImport(const fs::path& directory) {
+    fs::remove_all(directory);
+    std::string beforeImport;
+    {
+        Project project;
+        EditJournal journal(project.elements, project.scenes, project.nodes, directory.string());
+        journal.open(0.0); // Generation 1
+        edit(project, journal, "a");
+        edit(project, journal, "b");
+        beforeImport = project.dump();
+
+        // The import's snapshot (generation 2) can't be written
+        fs::create_directories(directory / "snapshot.2.json.tmp");
+        std::ofstream(directory / "journal.2.jsonl") << R"({"op":"node","index":0,"value":{"name":"imported"}})" << '\n';
+        project.elements.clear();
+        project.scenes.clear();
+        project.nodes.clear();
+        project.nodes.push_back(Node("imported"));
+        journal.projectReplaced();
+        edit(project, journal, "after import");
+    }
+    fs::remove_all(directory / "snapshot.2.json.tmp");
+    bool ok = check(!fs::exists(directory / "snapshot.2.json"), "import snapshot was not written");
+    ok = recoversAs(directory, beforeImport, "crash during import recovers the project before it") && ok;
+    ok = check(!fs::exists(directory / "journal.2.jsonl"), "journal without a snapshot is deleted") && ok;
+    return ok;
+}
+
+// The import's snapshot is written before anything is journaled on top of it
+bool checkImport(const fs::path& directory) {
+    fs::remove_all(directory);
+    std::string expected;
+    {
+        Project project;
+        EditJournal journal(project.elements, project.scenes, project.nodes, directory.string());
+        journal.open(0.0);
+        edit(project, journal, "a");
+        project.elements.clear();
+        project.scenes.clear();
+        project.nodes.clear();
+        project.nodes.push_back(Node("imported", -1, {}, {0, 0}, DragType::SIMPLE, LIGHTGRAY, true));
+        journal.projectReplaced();
+        edit(project, journal, "after import");
+        expected = project.dump();
+    }
+    return recoversAs(directory, expected, "import plus later edits are recovered");
+}
+
+// The editor dies while a compaction's snapshot is being written, or after it
+// was written but before journaling moved to the new generation: changes made
+// in the meantime are only in the old journal, after the snapshot's marker
+bool checkCrashDuringCompaction(const fs::path& directory) {
+    fs::remove_all(directory);
+    std::string expected;
+    {
+        Project project;
+        EditJournal journal(project.elements, project.scenes, project.nodes, directory.string());
+        journal.open(0.0);
+        for (size_t i = 0; i < EditJournal::COMPACT_RECORDS; ++i) {
+            project.nodes[0].position.x = (float)i;
+            journal.nodeChanged(0);
+        }
+        journal.update(1.0); // Starts the snapshot
+        edit(project, journal, "while compacting");
+        expected = project.dump();
+    } // The snapshot is finished on the way out, the switch never happens
+    bool ok = recoversAs(directory, expected, "crash mid-compaction replays the old journal's tail");
+
+    // Then let one compaction finish and keep editing
+    {
+        Project project;
+        EditJournal journal(project.elements, project.scenes, project.nodes, directory.string());
+        journal.open(0.0);
+        for (size_t i = 0; i < EditJournal::COMPACT_RECORDS; ++i) {
+            project.nodes[0].position.y = (float)i;
+            journal.nodeChanged(0);
+        }
+        journal.update(1.0);
+        edit(project, journal, "before switch");
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        journal.update(2.0); // Switches to the new generation
+        edit(project, journal, "after switch");
+        expected = project.dump();
+    }
+    ok = recoversAs(directory, expected, "edits on both sides of a finished compaction are recovered") && ok;
+
+    // A torn last line loses only itself
+    std::string newest;
+    for (const auto& entry : fs::directory_iterator(directory)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("journal.", 0) == 0 && name > newest) newest = name;
+    }
+    std::ofstream(directory / newest, std::ios::app) << R"({"op":"node","ind)";
+    ok = recoversAs(directory, expected, "a half-written last record is ignored") && ok;
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    Log::setLevel(LOG_NONE); // The crashes below are meant to log errors
+    fs::path directory = fs::temp_directory_path() / "core-check-journal";
+    bool ok = true;
+    std::printf("node graph\n");
+    ok = checkEraseNode(directory) && ok;
+    ok = checkReplayKeepsIncoming(directory) && ok;
+    ok = checkEraseElementAndScene(directory) && ok;
+    std::printf("edit journal\n");
+    ok = checkCrashDuringImport(directory) && ok;
+    ok = checkImport(directory) && ok;
+    ok = checkCrashDuringCompaction(directory) && ok;
+    fs::remove_all(directory);
+    std::printf(ok ? "all checks passed\n" : "some checks FAILED\n");
+    return ok ? 0 : 1;
+}
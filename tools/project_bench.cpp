@@ -0,0 +1,150 @@
+// Load-time benchmark: project.json (streamed through nlohmann's SAX parser)
+// vs project.bin (mapped records) on a synthetic project, plus the time to
+// stream project.json out with JsonWriter. Run from the build directory:
+//   make project-bench && ./build/project-bench.out [nodeCount] [iterations]
+#include "ProjectJson.hpp"
+#include "Log.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// A story graph shaped like a real one: every node shows its own scene with a
+// background, two characters and a line of text, and offers two choices
+void buildProject(size_t nodeCount, ElementMap& elements, SceneMap& scenes, NodeMap& nodes) {
+    const size_t characterCount = 200, backgroundCount = 100, posesPerCharacter = 10;
+    for (size_t c = 0; c < characterCount; ++c) {
+        Element element;
+        element.type = ElementType::CHARACTER;
+        element.name = "Character " + std::to_string(c);
+        CharacterElement character;
+        character.name = element.name;
+        for (size_t p = 0; p < posesPerCharacter; ++p) {
+            character.images.emplace_back("pose" + std::to_string(p), "atlas_" + std::to_string(c) + "_0.png");
+            character.atlasRects.push_back({(float)(p * 256), 0, 256, 512});
+            character.sourceSizes.push_back({512, 1024});
+        }
+        element.data = character;
+        elements.push_back(element);
+    }
+    for (size_t b = 0; b < backgroundCount; ++b) {
+        Element element;
+        element.type = ElementType::BACKGROUND;
+        element.name = "Background " + std::to_string(b);
+        element.data = BackgroundElement{"background_" + std::to_string(b) + ".png", TextureHandle()};
+        elements.push_back(element);
+    }
+    size_t firstText = elements.size();
+    for (size_t n = 0; n < nodeCount; ++n) {
+        Element element;
+        element.name = "Line " + std::to_string(n);
+        element.data = TextElement{"Line of dialogue number " + std::to_string(n) + " with some words in it."};
+        elements.push_back(element);
+
+        Scene scene;
+        scene.name = "Scene " + std::to_string(n);
+        SceneElement background;
+        background.elementIndex = characterCount + n % backgroundCount;
+        scene.elements.push_back(background);
+        for (size_t k = 0; k < 2; ++k) {
+            SceneElement character;
+            character.elementIndex = (n * 2 + k) % characterCount;
+            character.renderlevel = 1;
+            character.selectedPose = "pose" + std::to_string((n + k) % posesPerCharacter);
+            scene.elements.push_back(character);
+        }
+        SceneElement text;
+        text.elementIndex = firstText + n;
+        text.renderlevel = 2;
+        scene.elements.push_back(text);
+        scenes.push_back(scene);
+
+        Node node("Node " + std::to_string(n), (int)n, {}, {(float)(n % 100) * 150, (float)(n / 100) * 100});
+        node.isStartNode = n == 0;
+        for (size_t k = 1; k <= 2; ++k) {
+            node.connections.push_back({(n + k) % nodeCount, "Choice " + std::to_string(k)});
+        }
+        nodes.push_back(node);
+    }
+}
+
+double median(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t nodeCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 5;
+    if (nodeCount == 0 || iterations <= 0) {
+        std::fprintf(stderr, "usage: %s [nodeCount] [iterations]\n", argv[0]);
+        return 1;
+    }
+    Log::setLevel(LOG_WARNING);
+
+    ElementMap elements;
+    SceneMap scenes;
+    NodeMap nodes;
+    buildProject(nodeCount, elements, scenes, nodes);
+
+    namespace fs = std::filesystem;
+    fs::path folder = fs::temp_directory_path() / "project-bench";
+    fs::create_directories(folder);
+    JsonUtils::exportToFile(elements, scenes, nodes, (folder / "project.json").string());
+    ProjectBinary::Writer writer;
+    for (const auto& element : elements) writer.addElement(element);
+    SavedIndices indices(elements, scenes, nodes, SlotIndexing::DENSE);
+    for (const auto& scene : scenes) writer.addScene(scene, elements, indices);
+    for (const auto& node : nodes) writer.addNode(node, scenes, nodes, indices);
+    {
+        std::string content = writer.finish();
+        std::ofstream file(folder / ProjectBinary::FILE_NAME, std::ios::binary);
+        file.write(content.data(), content.size());
+    }
+
+    auto resolve = [](const std::string& path) { return path; };
+    std::vector<double> exportTimes, jsonTimes, binaryTimes;
+    for (int i = 0; i < iterations; ++i) {
+        auto exportStart = Clock::now();
+        JsonUtils::exportToFile(elements, scenes, nodes, (folder / "project.json").string(), JsonWriter::Style::COMPACT);
+        exportTimes.push_back(std::chrono::duration<double, std::milli>(Clock::now() - exportStart).count());
+
+        ElementMap e;
+        SceneMap s;
+        NodeMap n;
+        auto start = Clock::now();
+        std::ifstream file(folder / "project.json");
+        JsonUtils::importExported([&](JsonUtils::ProjectSaxReader& reader) { json::sax_parse(file, &reader); },
+                                  e, s, n, resolve, false);
+        jsonTimes.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+        start = Clock::now();
+        MappedFile mapped;
+        ProjectBinary::View view;
+        if (!mapped.open((folder / ProjectBinary::FILE_NAME).string()) || !view.open(mapped.getData(), mapped.getSize())) {
+            std::fprintf(stderr, "failed to open %s\n", ProjectBinary::FILE_NAME);
+            return 1;
+        }
+        JsonUtils::importBinary(view, e, s, n, resolve, false);
+        binaryTimes.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        if (n.size() != nodeCount) {
+            std::fprintf(stderr, "binary import lost nodes: %zu of %zu\n", n.size(), nodeCount);
+            return 1;
+        }
+    }
+
+    std::printf("%zu nodes, %zu elements, %d iterations (median)\n", nodeCount, elements.size(), iterations);
+    std::printf("  export json  %8.1f ms  (compact)\n", median(exportTimes));
+    std::printf("  project.json %8.1f ms  %10llu bytes\n", median(jsonTimes),
+                (unsigned long long)fs::file_size(folder / "project.json"));
+    std::printf("  project.bin  %8.1f ms  %10llu bytes\n", median(binaryTimes),
+                (unsigned long long)fs::file_size(folder / ProjectBinary::FILE_NAME));
+    fs::remove_all(folder);
+    return 0;
+}
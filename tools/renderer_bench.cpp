@@ -0,0 +1,384 @@
+// Playthrough benchmark for the renderer: loads the project in the working
+// directory the way the renderer does (asset bundle or loose files), then drives
+// Render through a script or a seeded random walk at a fixed timestep, drawing
+// offscreen in a hidden window (a software GL such as llvmpipe is enough).
+// Writes frame-time percentiles, load stalls and peak memory as JSON.
+// Run from the project folder:
+//   make renderer-bench && ./build/renderer-bench.out [--script file] [--steps N]
+//       [--seed N] [--step-frames N] [--out file]
+// A script has one command per line, '#' starts a comment:
+//   next | prev | reset | choose <i> | wait <frames> | random <steps>
+// Without a script the bench takes --steps random steps.
+#include "Render.hpp"
+#include "JsonUtils.hpp"
+#include "RaylibBackend.hpp"
+#include "TextureCache.hpp"
+#include "AssetBundle.hpp"
+#include "JsonWriter.hpp"
+#include "Log.hpp"
+#include "raylib.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int SCREEN_WIDTH = 1000, SCREEN_HEIGHT = 600; // As the renderer's window
+constexpr double TIMESTEP = 1.0 / 60.0;
+
+struct Command
+{
+    enum class Kind { NEXT, PREV, RESET, CHOOSE, WAIT, RANDOM };
+    Kind kind;
+    int argument;
+};
+
+struct Options
+{
+    std::string scriptPath;
+    std::string outPath = "renderer-bench.json";
+    int steps = 200;
+    int stepFrames = 30; // Frames drawn after each step
+    unsigned seed = 1;
+};
+
+// Line numbers in errors are 1-based; false after printing the first error
+bool parseScript(const std::string& path, std::vector<Command>& commands) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::fprintf(stderr, "cannot open script %s\n", path.c_str());
+        return false;
+    }
+    std::string line;
+    for (int lineNumber = 1; std::getline(file, line); ++lineNumber) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream words(line);
+        std::string word;
+        if (!(words >> word)) continue;
+
+        Command command = {Command::Kind::NEXT, 0};
+        bool needsArgument = true;
+        if (word == "next") {
+            command.kind = Command::Kind::NEXT;
+            needsArgument = false;
+        } else if (word == "prev") {
+            command.kind = Command::Kind::PREV;
+            needsArgument = false;
+        } else if (word == "reset") {
+            command.kind = Command::Kind::RESET;
+            needsArgument = false;
+        } else if (word == "choose") {
+            command.kind = Command::Kind::CHOOSE;
+        } else if (word == "wait") {
+            command.kind = Command::Kind::WAIT;
+        } else if (word == "random") {
+            command.kind = Command::Kind::RANDOM;
+        } else {
+            std::fprintf(stderr, "%s:%d: unknown command '%s'\n", path.c_str(), lineNumber, word.c_str());
+            return false;
+        }
+        if (needsArgument && (!(words >> command.argument) || command.argument < 0)) {
+            std::fprintf(stderr, "%s:%d: '%s' needs a non-negative number\n", path.c_str(), lineNumber, word.c_str());
+            return false;
+        }
+        commands.push_back(command);
+    }
+    return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (value == nullptr) return false;
+        if (std::strcmp(arg, "--script") == 0) {
+            options.scriptPath = value;
+        } else if (std::strcmp(arg, "--out") == 0) {
+            options.outPath = value;
+        } else if (std::strcmp(arg, "--steps") == 0) {
+            options.steps = std::atoi(value);
+        } else if (std::strcmp(arg, "--step-frames") == 0) {
+            options.stepFrames = std::atoi(value);
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            options.seed = (unsigned)std::strtoul(value, nullptr, 10);
+        } else {
+            return false;
+        }
+        ++i;
+    }
+    return options.steps >= 0 && options.stepFrames > 0;
+}
+
+// Peak resident set of the process in bytes, 0 where it is not available
+size_t peakResidentBytes() {
+#if defined(_WIN32)
+    return 0; // GetProcessMemoryInfo needs windows.h, which clashes with raylib.h
+#else
+    rusage usage = {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return (size_t)usage.ru_maxrss; // Bytes on macOS
+#else
+    return (size_t)usage.ru_maxrss * 1024; // KiB on Linux
+#endif
+#endif
+}
+
+// Nearest-rank percentile of sorted samples
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = (size_t)std::ceil(p / 100.0 * sorted.size());
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+class Bench
+{
+public:
+    Bench(Render& renderer, Font font, RenderTexture2D target, const Options& options)
+        : renderer(renderer), font(font), target(target), options(options), random(options.seed) {}
+
+    void run(const std::vector<Command>& commands)
+    {
+        renderer.resetSlide();
+        runStep(options.stepFrames); // The start scene, loaded cold
+        for (const Command& command : commands) {
+            switch (command.kind) {
+            case Command::Kind::NEXT:
+                if (renderer.canGoNext()) {
+                    renderer.nextSlide();
+                } else {
+                    LogWarning("Script: no slide after %d", renderer.getCurrentSlide());
+                }
+                break;
+            case Command::Kind::PREV:
+                renderer.prevSlide();
+                break;
+            case Command::Kind::RESET:
+                renderer.resetSlide();
+                break;
+            case Command::Kind::CHOOSE:
+                renderer.chooseConnection((size_t)command.argument);
+                break;
+            case Command::Kind::WAIT:
+                runStep(command.argument);
+                continue;
+            case Command::Kind::RANDOM:
+                for (int i = 0; i < command.argument; ++i) {
+                    randomStep();
+                    runStep(options.stepFrames);
+                }
+                continue;
+            }
+            runStep(options.stepFrames);
+        }
+    }
+
+    bool writeReport(const std::string& path) const
+    {
+        std::vector<double> sorted = frameMs;
+        std::sort(sorted.begin(), sorted.end());
+        double sum = 0.0;
+        for (double ms : sorted) sum += ms;
+        double longestStallMs = stallMs.empty() ? 0.0 : *std::max_element(stallMs.begin(), stallMs.end());
+        double totalStallMs = 0.0;
+        for (double ms : stallMs) totalStallMs += ms;
+        size_t residentBytes = peakResidentBytes();
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::fprintf(stderr, "cannot write %s\n", path.c_str());
+            return false;
+        }
+        {
+            JsonWriter writer([&](const char* data, size_t size) { file.write(data, size); });
+            writer.beginObject();
+            writer.key("frameMs");
+            writer.beginObject();
+            writer.member("max", sorted.empty() ? 0.0 : sorted.back());
+            writer.member("mean", sorted.empty() ? 0.0 : sum / sorted.size());
+            writer.member("p50", percentile(sorted, 50));
+            writer.member("p90", percentile(sorted, 90));
+            writer.member("p99", percentile(sorted, 99));
+            writer.endObject();
+            writer.member("frames", (uint64_t)frameMs.size());
+            // Steps after which textures were drawn as placeholders, and for how long
+            writer.key("loadStalls");
+            writer.beginObject();
+            writer.member("count", (uint64_t)stallMs.size());
+            writer.member("frames", (uint64_t)stallFrames);
+            writer.member("longestMs", longestStallMs);
+            writer.member("totalMs", totalStallMs);
+            writer.endObject();
+            writer.key("peakMemory");
+            writer.beginObject();
+            if (residentBytes > 0) writer.member("residentBytes", (uint64_t)residentBytes);
+            writer.member("textureBytes", (uint64_t)peakTextureBytes);
+            writer.endObject();
+            writer.member("seed", (uint64_t)options.seed);
+            writer.member("steps", (uint64_t)steps);
+            writer.member("timestepMs", TIMESTEP * 1000.0);
+            writer.endObject();
+        }
+        file.close();
+        if (file.fail()) return false;
+
+        std::printf("%zu frames, %d steps\n", frameMs.size(), steps);
+        std::printf("  frame ms  p50 %.2f  p90 %.2f  p99 %.2f  max %.2f\n", percentile(sorted, 50),
+                    percentile(sorted, 90), percentile(sorted, 99), sorted.empty() ? 0.0 : sorted.back());
+        std::printf("  load stalls %zu (%zu frames, longest %.1f ms)\n", stallMs.size(), stallFrames, longestStallMs);
+        std::printf("  peak memory %.1f MB resident, %.1f MB textures\n", residentBytes / (1024.0 * 1024.0),
+                    peakTextureBytes / (1024.0 * 1024.0));
+        return true;
+    }
+
+private:
+    // What a player clicks next: the next slide while there is one, then a
+    // random choice, back to the start at a dead end
+    void randomStep()
+    {
+        if (renderer.canGoNext()) {
+            renderer.nextSlide();
+        } else if (renderer.getChoiceCount() > 0) {
+            std::uniform_int_distribution<size_t> pick(0, renderer.getChoiceCount() - 1);
+            renderer.chooseConnection(pick(random));
+        } else {
+            renderer.resetSlide();
+        }
+    }
+
+    void runStep(int frames)
+    {
+        ++steps;
+        double stalledMs = 0.0;
+        size_t stalled = 0;
+        for (int i = 0; i < frames; ++i) {
+            double ms = runFrame();
+            if (renderer.getPlaceholderCount() > 0) {
+                stalledMs += ms;
+                ++stalled;
+            }
+        }
+        if (stalled > 0) {
+            stallMs.push_back(stalledMs);
+            stallFrames += stalled;
+        }
+    }
+
+    // One frame at the fixed timestep, timed like the renderer's main loop
+    double runFrame()
+    {
+        auto start = Clock::now();
+        renderer.update((float)(frame * TIMESTEP), renderer.getCurrentSlide());
+        TextureCache::instance().processUploads();
+        BeginTextureMode(target);
+        ClearBackground(RAYWHITE);
+        renderer.draw(font);
+        EndTextureMode();
+        // Keeps the window's event queue and frame timing going; nothing is shown
+        BeginDrawing();
+        EndDrawing();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        frameMs.push_back(ms);
+        peakTextureBytes = std::max(peakTextureBytes, TextureCache::instance().getResidentBytes());
+        ++frame;
+        return ms;
+    }
+
+    Render& renderer;
+    Font font;
+    RenderTexture2D target;
+    const Options& options;
+    std::mt19937 random;
+    uint64_t frame = 0;
+    int steps = 0;
+    std::vector<double> frameMs;
+    std::vector<double> stallMs; // One per stalled step
+    size_t stallFrames = 0;
+    size_t peakTextureBytes = 0;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--script file] [--steps N] [--seed N] [--step-frames N] [--out file]\n", argv[0]);
+        return 1;
+    }
+    std::vector<Command> commands;
+    if (!options.scriptPath.empty()) {
+        if (!parseScript(options.scriptPath, commands)) return 1;
+    } else {
+        commands.push_back({Command::Kind::RANDOM, options.steps});
+    }
+
+    Log::setLevel(LOG_WARNING);
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Novel Renderer Bench");
+    SetTargetFPS(0); // Fixed timestep, as fast as frames can be drawn
+    RaylibBackend backend;
+    GraphicsBackend::set(&backend);
+
+    auto bundle = std::make_shared<AssetBundle>();
+    if (!bundle->open(AssetBundle::DEFAULT_NAME)) {
+        bundle.reset();
+    }
+    Font font = GetFontDefault();
+    size_t fontSize = 0;
+    const unsigned char* fontData = bundle ? bundle->find("font/noto-sans.regular.ttf", fontSize) : nullptr;
+    if (fontData != nullptr) {
+        font = LoadFontFromMemory(".ttf", fontData, (int)fontSize, 16, nullptr, 0);
+    } else if (FileExists("font/noto-sans.regular.ttf")) {
+        font = LoadFontEx("font/noto-sans.regular.ttf", 16, nullptr, 0);
+    }
+
+    ElementMap elements;
+    SceneMap scenes;
+    NodeMap nodes;
+    Render renderer(elements, scenes, nodes);
+    renderer.setPrefetchDepth(2); // As the renderer
+    renderer.setInputEnabled(false);
+    try {
+        if (bundle) {
+            TextureCache::instance().mountBundle(bundle);
+            JsonUtils::importFromBundle(elements, scenes, nodes, *bundle, false);
+        } else {
+            JsonUtils::importFromFolder(elements, scenes, nodes, ".", false);
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "import failed: %s\n", e.what());
+        CloseWindow();
+        return 1;
+    }
+    if (nodes.empty()) {
+        std::fprintf(stderr, "the project has no nodes\n");
+        CloseWindow();
+        return 1;
+    }
+
+    RenderTexture2D target = LoadRenderTexture(SCREEN_WIDTH, SCREEN_HEIGHT);
+    Bench bench(renderer, font, target, options);
+    bench.run(commands);
+    bool written = bench.writeReport(options.outPath);
+
+    UnloadRenderTexture(target);
+    UnloadFont(font);
+    CloseWindow();
+    return written ? 0 : 1;
+}